@@ -0,0 +1,272 @@
+//------------------------------------------------------------------------------
+/**
+ * @file audio_fft.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief streaming FFT power spectrum analyzer (NEON/SSE/C radix-2).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <xmmintrin.h>
+#endif
+
+#include "audio_fft.h"
+
+//------------------------------------------------------------------------------
+const char *audio_fft_isa (void)
+{
+#if defined(__ARM_NEON)
+	return "neon";
+#elif defined(__SSE2__)
+	return "sse";
+#else
+	return "c";
+#endif
+}
+
+//------------------------------------------------------------------------------
+static void *fft_alloc (int cnt, int size)
+{
+	void *p;
+
+	if (posix_memalign (&p, 16, (size_t)cnt * size))
+		return NULL;
+	memset (p, 0, (size_t)cnt * size);
+	return p;
+}
+
+//------------------------------------------------------------------------------
+void audio_fft_close (struct audio_fft *fft)
+{
+	free (fft->tw_re);	free (fft->tw_im);	free (fft->win);	free (fft->rev);
+	free (fft->re);		free (fft->im);		free (fft->buf);	free (fft->power);
+	memset (fft, 0, sizeof(struct audio_fft));
+}
+
+//------------------------------------------------------------------------------
+int audio_fft_init (struct audio_fft *fft, int n)
+{
+	int i, j, h, b;
+
+	memset (fft, 0, sizeof(struct audio_fft));
+	if ((n < AUDIO_FFT_SIZE_MIN) || (n > AUDIO_FFT_SIZE_MAX) || (n & (n - 1))) {
+		printf ("%s : fft size %d error!\n", __func__, n);
+		return 0;
+	}
+	fft->n    = n;
+	fft->hop  = n / 2;
+	fft->simd = 1;
+	while ((1 << fft->log2n) < n)
+		fft->log2n++;
+
+	fft->tw_re = fft_alloc (n, sizeof(float));	fft->tw_im = fft_alloc (n, sizeof(float));
+	fft->win   = fft_alloc (n, sizeof(float));	fft->rev   = fft_alloc (n, sizeof(int));
+	fft->re    = fft_alloc (n, sizeof(float));	fft->im    = fft_alloc (n, sizeof(float));
+	fft->buf   = fft_alloc (n, sizeof(float));	fft->power = fft_alloc (n / 2 + 4, sizeof(float));
+	if (!fft->tw_re || !fft->tw_im || !fft->win || !fft->rev ||
+		!fft->re || !fft->im || !fft->buf || !fft->power) {
+		audio_fft_close (fft);
+		return 0;
+	}
+
+	/* half h stage : w(j) = exp(-2 pi i j / 2h), j = 0 ~ h - 1 */
+	for (h = 1; h < n; h <<= 1) {
+		for (j = 0; j < h; j++) {
+			fft->tw_re[h + j] = (float)cos (-M_PI * j / h);
+			fft->tw_im[h + j] = (float)sin (-M_PI * j / h);
+		}
+	}
+	for (i = 0; i < n; i++) {
+		for (j = 0, b = 0; b < fft->log2n; b++)
+			j |= ((i >> b) & 1) << (fft->log2n - 1 - b);
+		fft->rev[i] = j;
+		fft->win[i] = (float)(0.5 - 0.5 * cos (2.0 * M_PI * i / n));
+		fft->win_ss += (double)fft->win[i] * fft->win[i];
+	}
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+void audio_fft_reset (struct audio_fft *fft)
+{
+	memset (fft->power, 0, (fft->n / 2 + 1) * sizeof(float));
+	fft->frames = 0;
+	fft->fill   = 0;
+}
+
+//------------------------------------------------------------------------------
+static void fft_stage_c (float *re, float *im, int n, int h, const float *wr, const float *wi)
+{
+	float tr, ti, ar, ai;
+	int k, j;
+
+	for (k = 0; k < n; k += h * 2) {
+		for (j = 0; j < h; j++) {
+			float *xr = re + k + j, *xi = im + k + j;
+
+			tr = xr[h] * wr[j] - xi[h] * wi[j];
+			ti = xr[h] * wi[j] + xi[h] * wr[j];
+			ar = xr[0];	ai = xi[0];
+			xr[0] = ar + tr;	xi[0] = ai + ti;
+			xr[h] = ar - tr;	xi[h] = ai - ti;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// h >= 4 : butterfly 4 개씩 (k + j 는 4 의 배수이므로 16 byte 정렬 load/store)
+//------------------------------------------------------------------------------
+static void fft_stage_simd (float *re, float *im, int n, int h, const float *wr, const float *wi)
+{
+#if defined(__ARM_NEON)
+	int k, j;
+
+	for (k = 0; k < n; k += h * 2) {
+		float *ar = re + k, *ai = im + k, *br = re + k + h, *bi = im + k + h;
+
+		for (j = 0; j < h; j += 4) {
+			float32x4_t w_r = vld1q_f32 (wr + j), w_i = vld1q_f32 (wi + j);
+			float32x4_t x_r = vld1q_f32 (br + j), x_i = vld1q_f32 (bi + j);
+			float32x4_t a_r = vld1q_f32 (ar + j), a_i = vld1q_f32 (ai + j);
+			float32x4_t t_r = vmlsq_f32 (vmulq_f32 (x_r, w_r), x_i, w_i);
+			float32x4_t t_i = vmlaq_f32 (vmulq_f32 (x_r, w_i), x_i, w_r);
+
+			vst1q_f32 (ar + j, vaddq_f32 (a_r, t_r));	vst1q_f32 (ai + j, vaddq_f32 (a_i, t_i));
+			vst1q_f32 (br + j, vsubq_f32 (a_r, t_r));	vst1q_f32 (bi + j, vsubq_f32 (a_i, t_i));
+		}
+	}
+#elif defined(__SSE2__)
+	int k, j;
+
+	for (k = 0; k < n; k += h * 2) {
+		float *ar = re + k, *ai = im + k, *br = re + k + h, *bi = im + k + h;
+
+		for (j = 0; j < h; j += 4) {
+			__m128 w_r = _mm_load_ps (wr + j), w_i = _mm_load_ps (wi + j);
+			__m128 x_r = _mm_load_ps (br + j), x_i = _mm_load_ps (bi + j);
+			__m128 a_r = _mm_load_ps (ar + j), a_i = _mm_load_ps (ai + j);
+			__m128 t_r = _mm_sub_ps (_mm_mul_ps (x_r, w_r), _mm_mul_ps (x_i, w_i));
+			__m128 t_i = _mm_add_ps (_mm_mul_ps (x_r, w_i), _mm_mul_ps (x_i, w_r));
+
+			_mm_store_ps (ar + j, _mm_add_ps (a_r, t_r));	_mm_store_ps (ai + j, _mm_add_ps (a_i, t_i));
+			_mm_store_ps (br + j, _mm_sub_ps (a_r, t_r));	_mm_store_ps (bi + j, _mm_sub_ps (a_i, t_i));
+		}
+	}
+#else
+	fft_stage_c (re, im, n, h, wr, wi);
+#endif
+}
+
+//------------------------------------------------------------------------------
+void audio_fft_run (struct audio_fft *fft, float *re, float *im)
+{
+	int h;
+
+	for (h = 1; h < fft->n; h <<= 1) {
+		if (fft->simd && (h >= 4))
+			fft_stage_simd (re, im, fft->n, h, fft->tw_re + h, fft->tw_im + h);
+		else
+			fft_stage_c    (re, im, fft->n, h, fft->tw_re + h, fft->tw_im + h);
+	}
+}
+
+//------------------------------------------------------------------------------
+// power[k] += re[k]^2 + im[k]^2 (k = 0 ~ n/2)
+//------------------------------------------------------------------------------
+static void power_acc (struct audio_fft *fft)
+{
+	int k = 0, cnt = fft->n / 2 + 1;
+
+#if defined(__ARM_NEON)
+	if (fft->simd) {
+		for (; k + 4 <= cnt; k += 4) {
+			float32x4_t r = vld1q_f32 (fft->re + k), i = vld1q_f32 (fft->im + k);
+
+			vst1q_f32 (fft->power + k,
+				vmlaq_f32 (vmlaq_f32 (vld1q_f32 (fft->power + k), r, r), i, i));
+		}
+	}
+#elif defined(__SSE2__)
+	if (fft->simd) {
+		for (; k + 4 <= cnt; k += 4) {
+			__m128 r = _mm_load_ps (fft->re + k), i = _mm_load_ps (fft->im + k);
+
+			_mm_store_ps (fft->power + k, _mm_add_ps (_mm_load_ps (fft->power + k),
+				_mm_add_ps (_mm_mul_ps (r, r), _mm_mul_ps (i, i))));
+		}
+	}
+#endif
+	for (; k < cnt; k++)
+		fft->power[k] += fft->re[k] * fft->re[k] + fft->im[k] * fft->im[k];
+}
+
+//------------------------------------------------------------------------------
+static void frame_process (struct audio_fft *fft)
+{
+	int i;
+
+	/* window 적용 후 bit reverse 순서로 배치 (real 입력) */
+	for (i = 0; i < fft->n; i++) {
+		fft->re[fft->rev[i]] = fft->buf[i] * fft->win[i];
+		fft->im[i] = 0;
+	}
+	audio_fft_run (fft, fft->re, fft->im);
+	power_acc (fft);
+	fft->frames++;
+}
+
+//------------------------------------------------------------------------------
+int audio_fft_feed (struct audio_fft *fft, const float *x, int cnt)
+{
+	int len;
+
+	while (cnt > 0) {
+		len = fft->n - fft->fill;
+		if (len > cnt)
+			len = cnt;
+		memcpy (fft->buf + fft->fill, x, len * sizeof(float));
+		fft->fill += len;
+		x   += len;
+		cnt -= len;
+
+		if (fft->fill == fft->n) {
+			frame_process (fft);
+			memmove (fft->buf, fft->buf + fft->hop, (fft->n - fft->hop) * sizeof(float));
+			fft->fill = fft->n - fft->hop;
+		}
+	}
+	return fft->frames;
+}
+
+//------------------------------------------------------------------------------
+// 단측 spectrum : mean square = 2 * sum |X|^2 / (n * sum(w^2))
+//------------------------------------------------------------------------------
+double audio_fft_power (const struct audio_fft *fft, int k0, int k1)
+{
+	double sum = 0;
+	int k;
+
+	if (!fft->frames)
+		return 0;
+	if (k0 < 0)
+		k0 = 0;
+	if (k1 > fft->n / 2)
+		k1 = fft->n / 2;
+	for (k = k0; k <= k1; k++)
+		sum += fft->power[k];
+	return	2.0 * sum / ((double)fft->n * fft->win_ss * fft->frames);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
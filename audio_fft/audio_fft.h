@@ -0,0 +1,60 @@
+//------------------------------------------------------------------------------
+/**
+ * @file audio_fft.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief streaming FFT power spectrum analyzer (NEON/SSE/C radix-2).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __AUDIO_FFT_H__
+#define __AUDIO_FFT_H__
+
+//------------------------------------------------------------------------------
+#define	AUDIO_FFT_SIZE_MIN		64
+#define	AUDIO_FFT_SIZE_MAX		16384
+
+//------------------------------------------------------------------------------
+/*
+	sample 을 feed 하면 n 개 단위 (hop = n/2 overlap) 로 hann window + FFT 후
+	bin 별 |X|^2 를 누적. power 는 누적 frame 평균으로 읽음.
+	buffer 는 16 byte 정렬 (SIMD load/store).
+*/
+struct audio_fft {
+	int		n, log2n, hop;
+	/* 1 : NEON/SSE butterfly, 0 : C (benchmark 비교용) */
+	char	simd;
+	/* stage 별 twiddle (half 크기 h 의 stage 는 offset h 부터 h 개, h >= 4 이면 16 byte 정렬) */
+	float	*tw_re, *tw_im;
+	float	*win;
+	double	win_ss;
+	int		*rev;
+	float	*re, *im;
+	/* 입력 sample (n 개가 모이면 FFT) */
+	float	*buf;
+	int		fill;
+	/* bin 0 ~ n/2 누적 |X|^2 */
+	float	*power;
+	int		frames;
+};
+
+//------------------------------------------------------------------------------
+extern const char	*audio_fft_isa	(void);
+/* n : 2 의 거듭제곱 (AUDIO_FFT_SIZE_MIN ~ AUDIO_FFT_SIZE_MAX) */
+extern int		audio_fft_init		(struct audio_fft *fft, int n);
+extern void		audio_fft_close		(struct audio_fft *fft);
+/* 누적 power, 입력 buffer 초기화 */
+extern void		audio_fft_reset		(struct audio_fft *fft);
+/* re/im 을 in-place 변환 (bit reverse 순서 입력) */
+extern void		audio_fft_run		(struct audio_fft *fft, float *re, float *im);
+/* return : 누적 frame 수 */
+extern int		audio_fft_feed		(struct audio_fft *fft, const float *x, int cnt);
+/* bin k0 ~ k1 의 평균 power 합 -> mean square (amplitude A 인 sine 은 A^2 / 2) */
+extern double	audio_fft_power		(const struct audio_fft *fft, int k0, int k1);
+
+//------------------------------------------------------------------------------
+#endif	// #define __AUDIO_FFT_H__
+//------------------------------------------------------------------------------
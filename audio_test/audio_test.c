@@ -0,0 +1,568 @@
+//------------------------------------------------------------------------------
+/**
+ * @file audio_test.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief audio loopback test (multi-tone stimulus, level/flatness/THD+N).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <signal.h>
+#include <pthread.h>
+
+#include "audio_test.h"
+#include "../audio_fft/audio_fft.h"
+
+//------------------------------------------------------------------------------
+/*
+	FFT bin 에 정확히 맞춘 tone (48 kHz / 4096 = 11.72 Hz 단위) : 222, 551, 996, 2027, 5051, 10043 Hz.
+	2 ~ 5 차 harmonic 이 다른 tone 의 측정 bin (+-2) 과 겹치지 않도록 선택.
+*/
+static const int	ToneBins[AUDIO_TONE_CNT] = { 19, 47, 85, 173, 431, 857 };
+/* tone 측정 bin 범위 (hann window main lobe) */
+#define	TONE_BIN_SPAN		2
+/* backend -> analyzer 전달 단위 (frame) */
+#define	AUDIO_CHUNK			1024
+/* stimulus 시작/끝 fade (click 방지) */
+#define	AUDIO_FADE_MS		5
+
+typedef int (*audio_capture_t) (const int16_t *pcm, int frames, int channels, void *arg);
+
+static int			Backend  = eAUDIO_BACKEND_ALSA;
+static const char	*PlayName = AUDIO_DEV_PLAY;
+static const char	*CapName  = AUDIO_DEV_CAPTURE;
+
+//------------------------------------------------------------------------------
+static long now_us (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000L + ts.tv_nsec / 1000L;
+}
+
+//------------------------------------------------------------------------------
+/* dBFS (full scale sine 의 mean square 0.5 = 0 dB) */
+static float level_db (double ms)
+{
+	return	(ms > 1e-20) ? (float)(10.0 * log10 (ms / 0.5)) : -200.0f;
+}
+
+//------------------------------------------------------------------------------
+// multi-tone (schroeder phase : crest factor 감소), 모든 channel 같은 신호
+//------------------------------------------------------------------------------
+static void stim_make (int16_t *pcm, int frames)
+{
+	int fade = AUDIO_RATE * AUDIO_FADE_MS / 1000, i, t, c;
+	double v, g;
+
+	for (t = 0; t < frames; t++) {
+		for (i = 0, v = 0; i < AUDIO_TONE_CNT; i++)
+			v += AUDIO_TONE_AMP * sin (2.0 * M_PI * ToneBins[i] * t / AUDIO_FFT_SIZE +
+										M_PI * i * i / AUDIO_TONE_CNT);
+		g = 1.0;
+		if (t < fade)
+			g = 0.5 - 0.5 * cos (M_PI * t / fade);
+		else if (t >= frames - fade)
+			g = 0.5 - 0.5 * cos (M_PI * (frames - 1 - t) / fade);
+		for (c = 0; c < AUDIO_CHANNELS; c++)
+			pcm[t * AUDIO_CHANNELS + c] = (int16_t)lrint (v * g * 32767.0);
+	}
+}
+
+//------------------------------------------------------------------------------
+//
+// wav file (16 bit PCM)
+//
+//------------------------------------------------------------------------------
+struct wav_hdr {
+	char		riff[4];
+	uint32_t	riff_size;
+	char		wave[4];
+	char		fmt[4];
+	uint32_t	fmt_size;
+	uint16_t	format;
+	uint16_t	channels;
+	uint32_t	rate;
+	uint32_t	byte_rate;
+	uint16_t	block_align;
+	uint16_t	bits;
+	char		data[4];
+	uint32_t	data_size;
+} __attribute__((packed));
+
+//------------------------------------------------------------------------------
+static int wav_write (const char *fname, const int16_t *pcm, int frames, int channels)
+{
+	struct wav_hdr hdr;
+	FILE *fp;
+	int ok;
+
+	memcpy (hdr.riff, "RIFF", 4);	memcpy (hdr.wave, "WAVE", 4);
+	memcpy (hdr.fmt,  "fmt ", 4);	memcpy (hdr.data, "data", 4);
+	hdr.fmt_size    = 16;
+	hdr.format      = 1;
+	hdr.channels    = channels;
+	hdr.rate        = AUDIO_RATE;
+	hdr.bits        = 16;
+	hdr.block_align = channels * 2;
+	hdr.byte_rate   = AUDIO_RATE * hdr.block_align;
+	hdr.data_size   = frames * hdr.block_align;
+	hdr.riff_size   = sizeof(hdr) - 8 + hdr.data_size;
+
+	if ((fp = fopen (fname, "wb")) == NULL) {
+		printf ("%s : %s open error (%s)\n", __func__, fname, strerror (errno));
+		return -1;
+	}
+	ok = (fwrite (&hdr, sizeof(hdr), 1, fp) == 1) &&
+		 (fwrite (pcm, hdr.block_align, frames, fp) == (size_t)frames);
+	if (fclose (fp) || !ok) {
+		printf ("%s : %s write error\n", __func__, fname);
+		return -1;
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+// 'fmt ' 확인 후 'data' chunk 위치의 FILE 반환
+//------------------------------------------------------------------------------
+static FILE *wav_open (const char *fname, int *channels)
+{
+	struct { char id[4]; uint32_t size; } __attribute__((packed)) chunk;
+	uint16_t fmt[8];
+	char riff[12];
+	FILE *fp;
+	int found = 0;
+
+	if ((fp = fopen (fname, "rb")) == NULL) {
+		printf ("%s : %s open error (%s)\n", __func__, fname, strerror (errno));
+		return NULL;
+	}
+	*channels = 0;
+	if ((fread (riff, sizeof(riff), 1, fp) != 1) || memcmp (riff, "RIFF", 4) || memcmp (riff + 8, "WAVE", 4))
+		goto out;
+
+	while (fread (&chunk, sizeof(chunk), 1, fp) == 1) {
+		if (!memcmp (chunk.id, "data", 4)) {
+			found = 1;
+			break;
+		}
+		if (!memcmp (chunk.id, "fmt ", 4) && (chunk.size >= 16)) {
+			if (fread (fmt, 16, 1, fp) != 1)
+				break;
+			/* format, channels, rate(32), byte_rate(32), block_align, bits */
+			if ((fmt[0] != 1) || (fmt[7] != 16) || ((fmt[2] | (fmt[3] << 16)) != AUDIO_RATE)) {
+				printf ("%s : %s is not %d Hz 16 bit PCM\n", __func__, fname, AUDIO_RATE);
+				break;
+			}
+			*channels = fmt[1];
+			chunk.size -= 16;
+		}
+		if (fseek (fp, chunk.size + (chunk.size & 1), SEEK_CUR))
+			break;
+	}
+out:
+	if (found && (*channels > 0))
+		return fp;
+	printf ("%s : %s wav format error\n", __func__, fname);
+	fclose (fp);
+	return NULL;
+}
+
+//------------------------------------------------------------------------------
+static int wav_run (const int16_t *stim, int frames, audio_capture_t capture, void *arg)
+{
+	int16_t *buf;
+	FILE *fp;
+	size_t n;
+	int channels;
+
+	if ((PlayName != NULL) && wav_write (PlayName, stim, frames, AUDIO_CHANNELS))
+		return -1;
+	if ((fp = wav_open (CapName != NULL ? CapName : PlayName, &channels)) == NULL)
+		return -1;
+	if ((buf = malloc (AUDIO_CHUNK * channels * sizeof(int16_t))) == NULL) {
+		fclose (fp);
+		return -1;
+	}
+	while ((n = fread (buf, channels * sizeof(int16_t), AUDIO_CHUNK, fp)) > 0)
+		if (capture (buf, n, channels, arg))
+			break;
+	free (buf);
+	fclose (fp);
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+//
+// alsa (aplay/arecord raw pcm pipe)
+//
+//------------------------------------------------------------------------------
+struct play_arg {
+	const int16_t	*pcm;
+	int				frames;
+	FILE			*fp;
+	int				ret;
+};
+
+//------------------------------------------------------------------------------
+// aplay 가 종료된 경우 SIGPIPE 대신 write error (이 thread 에서만 block)
+//------------------------------------------------------------------------------
+static void *thread_play (void *arg)
+{
+	struct play_arg *pa = (struct play_arg *)arg;
+	sigset_t set;
+
+	sigemptyset (&set);
+	sigaddset   (&set, SIGPIPE);
+	pthread_sigmask (SIG_BLOCK, &set, NULL);
+
+	pa->ret = (fwrite (pa->pcm, AUDIO_CHANNELS * sizeof(int16_t), pa->frames, pa->fp)
+				== (size_t)pa->frames) ? 0 : -1;
+	if (pclose (pa->fp))
+		pa->ret = -1;
+	return arg;
+}
+
+//------------------------------------------------------------------------------
+// AUDIO_PLAYER_SERVICE 가 실행 중인 경우 정지 (stop 은 aplay 종료까지 대기), return 1 : 정지함
+//------------------------------------------------------------------------------
+static int player_stop (void)
+{
+	if (system ("systemctl is-active --quiet " AUDIO_PLAYER_SERVICE))
+		return 0;
+	if (system ("systemctl stop " AUDIO_PLAYER_SERVICE)) {
+		printf ("%s : %s stop error\n", __func__, AUDIO_PLAYER_SERVICE);
+		return 0;
+	}
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+static void player_start (void)
+{
+	if (system ("systemctl start --no-block " AUDIO_PLAYER_SERVICE))
+		printf ("%s : %s start error\n", __func__, AUDIO_PLAYER_SERVICE);
+}
+
+//------------------------------------------------------------------------------
+// capture 를 먼저 시작한 뒤 playback, 분석이 끝나면 capture pipe 를 닫음 (arecord 종료)
+//------------------------------------------------------------------------------
+static int alsa_run (const int16_t *stim, int frames, audio_capture_t capture, void *arg)
+{
+	struct play_arg pa;
+	pthread_t play_thread;
+	int16_t buf[AUDIO_CHUNK * AUDIO_CHANNELS];
+	char cmd[256];
+	FILE *cap;
+	size_t n;
+
+	snprintf (cmd, sizeof(cmd), "arecord -q -D %s -t raw -f S16_LE -r %d -c %d",
+		CapName, AUDIO_RATE, AUDIO_CHANNELS);
+	if ((cap = popen (cmd, "r")) == NULL) {
+		printf ("%s : arecord error (%s)\n", __func__, strerror (errno));
+		return -1;
+	}
+	snprintf (cmd, sizeof(cmd), "aplay -q -D %s -t raw -f S16_LE -r %d -c %d",
+		PlayName, AUDIO_RATE, AUDIO_CHANNELS);
+	memset (&pa, 0, sizeof(pa));
+	pa.pcm    = stim;
+	pa.frames = frames;
+	if ((pa.fp = popen (cmd, "w")) == NULL) {
+		printf ("%s : aplay error (%s)\n", __func__, strerror (errno));
+		pclose (cap);
+		return -1;
+	}
+	pthread_create (&play_thread, NULL, thread_play, &pa);
+
+	while ((n = fread (buf, AUDIO_CHANNELS * sizeof(int16_t), AUDIO_CHUNK, cap)) > 0)
+		if (capture (buf, n, AUDIO_CHANNELS, arg))
+			break;
+	pclose (cap);
+	pthread_join (play_thread, NULL);
+
+	if (pa.ret)
+		printf ("%s : %s playback error\n", __func__, PlayName);
+	return pa.ret;
+}
+
+//------------------------------------------------------------------------------
+//
+// streaming analyzer
+//
+//------------------------------------------------------------------------------
+struct capture_state {
+	struct audio_fft	fft;
+	long				samples;
+	/* -1 : 신호 대기 */
+	long				onset;
+	int					settle;
+	long				limit;
+	long				analyze_us;
+	float				x[AUDIO_CHUNK];
+};
+
+//------------------------------------------------------------------------------
+// return 1 : 분석 frame 수 충족 또는 capture 시간 초과 (capture 중지)
+//------------------------------------------------------------------------------
+static int capture_feed (const int16_t *pcm, int frames, int channels, void *arg)
+{
+	struct capture_state *st = (struct capture_state *)arg;
+	int ch = (channels > AUDIO_CAPTURE_CH) ? AUDIO_CAPTURE_CH : 0, i, skip;
+	double ss = 0;
+	long t;
+
+	if (frames > AUDIO_CHUNK)
+		frames = AUDIO_CHUNK;
+	for (i = 0; i < frames; i++) {
+		st->x[i] = pcm[i * channels + ch] / 32768.0f;
+		ss += (double)st->x[i] * st->x[i];
+	}
+	st->samples += frames;
+
+	if (st->onset < 0) {
+		if (!frames || (level_db (ss / frames) < AUDIO_ONSET_DB))
+			return	st->samples >= st->limit;
+		st->onset = st->samples - frames;
+	}
+	skip = (st->settle < frames) ? st->settle : frames;
+	st->settle -= skip;
+
+	t = now_us ();
+	audio_fft_feed (&st->fft, st->x + skip, frames - skip);
+	st->analyze_us += now_us () - t;
+
+	return	(st->fft.frames >= AUDIO_AVG_FRAMES) || (st->samples >= st->limit);
+}
+
+//------------------------------------------------------------------------------
+// tone : bin +-TONE_BIN_SPAN, THD+N : 20 Hz ~ 20 kHz 중 tone bin 을 제외한 power
+//------------------------------------------------------------------------------
+static void analyze (const struct audio_fft *fft, struct audio_result *res, int thdn_min_db)
+{
+	double tone_ms[AUDIO_TONE_CNT], tone_sum = 0, nd;
+	int i, k0 = (20 * AUDIO_FFT_SIZE + AUDIO_RATE - 1) / AUDIO_RATE, k1 = 20000 * AUDIO_FFT_SIZE / AUDIO_RATE;
+
+	for (i = 0; i < AUDIO_TONE_CNT; i++) {
+		tone_ms[i] = audio_fft_power (fft, ToneBins[i] - TONE_BIN_SPAN, ToneBins[i] + TONE_BIN_SPAN);
+		tone_sum  += tone_ms[i];
+		res->tones[i].freq     = (float)ToneBins[i] * AUDIO_RATE / AUDIO_FFT_SIZE;
+		res->tones[i].level_db = level_db (tone_ms[i]);
+	}
+	res->ref_db  = res->tones[AUDIO_TONE_REF].level_db;
+	res->flat_db = 0;
+	for (i = 0; i < AUDIO_TONE_CNT; i++) {
+		res->tones[i].dev_db = res->tones[i].level_db - res->ref_db;
+		if (fabsf (res->tones[i].dev_db) > res->flat_db)
+			res->flat_db = fabsf (res->tones[i].dev_db);
+	}
+	nd = audio_fft_power (fft, k0, k1) - tone_sum;
+	res->thdn_db = (tone_sum > 0) ? (float)(10.0 * log10 ((nd > 1e-20 ? nd : 1e-20) / tone_sum)) : 0;
+
+	if (res->ref_db < AUDIO_LEVEL_MIN_DB)
+		res->verdict = eAUDIO_LEVEL;
+	else if (res->flat_db > AUDIO_FLAT_DB)
+		res->verdict = eAUDIO_FLAT;
+	else if (-res->thdn_db < thdn_min_db)
+		res->verdict = eAUDIO_THDN;
+	else
+		res->verdict = eAUDIO_PASS;
+}
+
+//------------------------------------------------------------------------------
+int audio_test_init (int backend, const char *play, const char *capture)
+{
+	Backend = backend;
+	if (backend == eAUDIO_BACKEND_WAV) {
+		PlayName = play;
+		CapName  = capture;
+		return	(play != NULL) || (capture != NULL);
+	}
+	PlayName = (play    != NULL) ? play    : AUDIO_DEV_PLAY;
+	CapName  = (capture != NULL) ? capture : AUDIO_DEV_CAPTURE;
+	/* install/m1-audio.sh 와 같은 headphone 출력 설정 */
+	if (system (AUDIO_MIXER_CMD))
+		printf ("%s : %s error\n", __func__, AUDIO_MIXER_CMD);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+int audio_test_run (struct audio_result *res, int thdn_min_db)
+{
+	struct capture_state *st;
+	int16_t *stim;
+	int frames = AUDIO_RATE * AUDIO_STIM_MS / 1000, ret = -1;
+	long t = now_us ();
+
+	memset (res, 0, sizeof(struct audio_result));
+	res->verdict = eAUDIO_ERROR;
+
+	st   = calloc (1, sizeof(struct capture_state));
+	stim = malloc (frames * AUDIO_CHANNELS * sizeof(int16_t));
+	if ((st == NULL) || (stim == NULL) || !audio_fft_init (&st->fft, AUDIO_FFT_SIZE)) {
+		free (st);	free (stim);
+		return 0;
+	}
+	st->onset  = -1;
+	st->settle = AUDIO_RATE * AUDIO_SETTLE_MS / 1000;
+	st->limit  = (long)AUDIO_RATE * AUDIO_CAPTURE_MS / 1000;
+	stim_make (stim, frames);
+
+	if (Backend == eAUDIO_BACKEND_WAV)
+		ret = wav_run  (stim, frames, capture_feed, st);
+	else {
+		/* piano.wav 재생 중인 경우 device busy (또는 piano 가 capture 됨) */
+		int stopped = player_stop ();
+
+		ret = alsa_run (stim, frames, capture_feed, st);
+		if (stopped)
+			player_start ();
+	}
+
+	if (!ret) {
+		if ((st->onset < 0) || (st->fft.frames < AUDIO_AVG_FRAMES))
+			res->verdict = eAUDIO_NO_SIGNAL;
+		else
+			analyze (&st->fft, res, thdn_min_db);
+	}
+	res->frames        = st->fft.frames;
+	res->onset_samples = st->onset;
+	res->analyze_us    = st->analyze_us;
+	res->elapsed_ms    = (now_us () - t) / 1000;
+
+	audio_fft_close (&st->fft);
+	free (st);
+	free (stim);
+	return	res->verdict == eAUDIO_PASS;
+}
+
+//------------------------------------------------------------------------------
+// UI box (15%, scale 3) 에 표시되는 길이
+//------------------------------------------------------------------------------
+void audio_test_summary (const struct audio_result *res, char *buf, int size)
+{
+	switch (res->verdict) {
+		case eAUDIO_PASS:
+		case eAUDIO_THDN:
+			snprintf (buf, size, "THD+N %.0fdB", res->thdn_db);	break;
+		case eAUDIO_NO_SIGNAL:
+			snprintf (buf, size, "NO SIGNAL");					break;
+		case eAUDIO_LEVEL:
+			snprintf (buf, size, "LOW %.0fdB", res->ref_db);		break;
+		case eAUDIO_FLAT:
+			snprintf (buf, size, "FLAT %.1fdB", res->flat_db);	break;
+		default :
+			snprintf (buf, size, "AUDIO ERR");					break;
+	}
+}
+
+//------------------------------------------------------------------------------
+// 같은 입력으로 C / SIMD streaming FFT (window + FFT + power 누적) 시간 및 결과 비교
+//------------------------------------------------------------------------------
+static void fft_bench (int loops)
+{
+	struct audio_fft fft[2];
+	long t, us[2];
+	float *x, diff = 0, peak = 0;
+	int i, n, k;
+
+	n = AUDIO_FFT_SIZE + loops * (AUDIO_FFT_SIZE / 2);
+	if ((x = malloc (n * sizeof(float))) == NULL)
+		return;
+	srand (1);
+	for (i = 0; i < n; i++)
+		x[i] = (float)rand () / RAND_MAX - 0.5f;
+
+	for (i = 0; i < 2; i++) {
+		if (!audio_fft_init (&fft[i], AUDIO_FFT_SIZE)) {
+			if (i)
+				audio_fft_close (&fft[0]);
+			free (x);
+			return;
+		}
+		fft[i].simd = i;
+		t = now_us ();
+		audio_fft_feed (&fft[i], x, n);
+		us[i] = now_us () - t;
+	}
+	for (k = 0; k <= AUDIO_FFT_SIZE / 2; k++) {
+		if (fabsf (fft[0].power[k] - fft[1].power[k]) > diff)
+			diff = fabsf (fft[0].power[k] - fft[1].power[k]);
+		if (fft[0].power[k] > peak)
+			peak = fft[0].power[k];
+	}
+
+	printf ("\nstreaming fft (%s) : %d point, hop %d, %d frames\n",
+		audio_fft_isa (), AUDIO_FFT_SIZE, AUDIO_FFT_SIZE / 2, fft[0].frames);
+	printf ("%-6s %10s %10s %9s %10s\n", "path", "us/frame", "frames/s", "speedup", "realtime");
+	for (i = 0; i < 2; i++) {
+		double per = (double)us[i] / fft[i].frames;
+
+		printf ("%-6s %10.1f %10.0f %8.1fx %9.0fx\n", i ? audio_fft_isa () : "c", per,
+			per > 0 ? 1000000.0 / per : 0.0, us[i] ? (double)us[0] / us[i] : 0.0,
+			per > 0 ? (AUDIO_FFT_SIZE / 2) * 1000000.0 / AUDIO_RATE / per : 0.0);
+	}
+	printf ("power spectrum : %s (max diff %.2e of peak)\n",
+		(diff <= peak * 1e-4f) ? "ok" : "MISMATCH", peak > 0 ? diff / peak : 0.0);
+
+	audio_fft_close (&fft[0]);
+	audio_fft_close (&fft[1]);
+	free (x);
+}
+
+//------------------------------------------------------------------------------
+int audio_test_bench (const char *wav, int loops)
+{
+	struct audio_result res;
+	FILE *fp;
+	int i;
+
+	/* capture file 이 없는 경우 stimulus 를 기록 (board 에서 재생/녹음하여 분석) */
+	if ((fp = fopen (wav, "rb")) == NULL) {
+		int frames = AUDIO_RATE * AUDIO_STIM_MS / 1000;
+		int16_t *stim = malloc (frames * AUDIO_CHANNELS * sizeof(int16_t));
+
+		if (stim == NULL)
+			return -1;
+		stim_make (stim, frames);
+		i = wav_write (wav, stim, frames, AUDIO_CHANNELS);
+		free (stim);
+		if (i)
+			return -1;
+		printf ("%s : stimulus written to %s\n", __func__, wav);
+	} else
+		fclose (fp);
+
+	audio_test_init (eAUDIO_BACKEND_WAV, NULL, wav);
+	audio_test_run (&res, 0);
+
+	printf ("%s : %s, onset %ld samples, %d frames, analyze %ld us\n", wav,
+		res.verdict == eAUDIO_ERROR ? "error" : "analyzed",
+		res.onset_samples, res.frames, res.analyze_us);
+	if ((res.verdict != eAUDIO_ERROR) && (res.verdict != eAUDIO_NO_SIGNAL)) {
+		printf ("%10s %10s %10s\n", "freq Hz", "dBFS", "dev dB");
+		for (i = 0; i < AUDIO_TONE_CNT; i++)
+			printf ("%10.1f %10.2f %10.2f\n", res.tones[i].freq, res.tones[i].level_db, res.tones[i].dev_db);
+		printf ("flatness %.2f dB, THD+N %.1f dB (%.4f %%)\n", res.flat_db, res.thdn_db,
+			100.0 * pow (10.0, res.thdn_db / 20.0));
+	} else {
+		char str[32];
+
+		audio_test_summary (&res, str, sizeof(str));
+		printf ("%s\n", str);
+	}
+	fft_bench (loops);
+	return	(res.verdict == eAUDIO_ERROR) ? -1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
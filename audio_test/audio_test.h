@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+/**
+ * @file audio_test.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief audio loopback test (multi-tone stimulus, level/flatness/THD+N).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __AUDIO_TEST_H__
+#define __AUDIO_TEST_H__
+
+//------------------------------------------------------------------------------
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+/* install/m1-audio.sh 와 같은 codec (card 1), playback path HP */
+#define	AUDIO_DEV_PLAY			"hw:1,0"
+#define	AUDIO_DEV_CAPTURE		"hw:1,0"
+#define	AUDIO_MIXER_CMD			"amixer -q -c 1 sset 'Playback Path' 'HP'"
+/* 같은 device 로 piano.wav 를 반복 재생하는 service (install/m1-audio.sh), ALSA test 중 정지 */
+#define	AUDIO_PLAYER_SERVICE	"m1-audio.service"
+
+#define	AUDIO_RATE				48000
+#define	AUDIO_CHANNELS			2
+/* capture 분석 channel (loopback cable 연결 channel) */
+#define	AUDIO_CAPTURE_CH		0
+
+/* 4096 point (11.7 Hz bin, 85 ms), 50% overlap 4 frame 평균 = 213 ms */
+#define	AUDIO_FFT_SIZE			4096
+#define	AUDIO_AVG_FRAMES		4
+#define	AUDIO_TONE_CNT			6
+/* 1 kHz tone (level 기준) index */
+#define	AUDIO_TONE_REF			2
+/* tone 당 -20 dBFS */
+#define	AUDIO_TONE_AMP			0.1
+
+#define	AUDIO_STIM_MS			1000
+/* capture 시작 후 신호가 없는 경우 종료 시간 */
+#define	AUDIO_CAPTURE_MS		2000
+/* 신호 시작 판단 level, 시작 후 과도 구간 제외 */
+#define	AUDIO_ONSET_DB			(-50)
+#define	AUDIO_SETTLE_MS			20
+
+/* 판정 : 1 kHz level 최소값, 1 kHz 기준 tone level 편차 */
+#define	AUDIO_LEVEL_MIN_DB		(-40)
+#define	AUDIO_FLAT_DB			6
+
+enum {
+	/* aplay/arecord (alsa-utils) */
+	eAUDIO_BACKEND_ALSA = 0,
+	/* wav file (play file 기록, capture file 분석) */
+	eAUDIO_BACKEND_WAV,
+	eAUDIO_BACKEND_END
+};
+
+enum {
+	eAUDIO_PASS = 0,
+	eAUDIO_ERROR,
+	eAUDIO_NO_SIGNAL,
+	eAUDIO_LEVEL,
+	eAUDIO_FLAT,
+	eAUDIO_THDN,
+	eAUDIO_VERDICT_END
+};
+
+struct audio_tone {
+	float	freq;
+	/* dBFS (full scale sine = 0 dB), 1 kHz tone 대비 편차 */
+	float	level_db;
+	float	dev_db;
+};
+
+struct audio_result {
+	int					verdict;
+	struct audio_tone	tones[AUDIO_TONE_CNT];
+	float				ref_db;
+	/* 최대 |dev_db| */
+	float				flat_db;
+	/* (전체 - tone) / tone power, 20 Hz ~ 20 kHz */
+	float				thdn_db;
+	int					frames;
+	/* 신호 시작까지 capture sample, 측정 시간, 분석 cpu 시간 */
+	long				onset_samples;
+	long				elapsed_ms;
+	long				analyze_us;
+};
+
+//------------------------------------------------------------------------------
+/* ALSA : play/capture = device (NULL : AUDIO_DEV_xxx), WAV : file (capture NULL : play file 을 다시 읽음) */
+extern int	audio_test_init		(int backend, const char *play, const char *capture);
+/* thdn_min_db : -THD+N 최소값 (예 40 = THD+N -40 dB 이하) return 1 : pass, 0 : fail */
+extern int	audio_test_run		(struct audio_result *res, int thdn_min_db);
+extern void	audio_test_summary	(const struct audio_result *res, char *buf, int size);
+/* wav 분석 결과 및 FFT (simd/c) 속도 출력, wav 가 없는 경우 stimulus 를 기록. return -1 : wav error */
+extern int	audio_test_bench	(const char *wav, int loops);
+
+//------------------------------------------------------------------------------
+#endif	// #define __AUDIO_TEST_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,530 @@
+//------------------------------------------------------------------------------
+/**
+ * @file cpu_test.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief multi-core compute load (int/NEON/memory kernel mix), clock and thermal throttling test.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "../sysfs_attr/sysfs_attr.h"
+#include "cpu_test.h"
+
+//------------------------------------------------------------------------------
+/*
+	core 별 thread 가 run_ms 동안 int -> fp -> mem kernel 을 반복하고,
+	호출한 thread 가 sample_ms 주기로 core 별 진행량, scaling_cur_freq, thermal_zone 온도를 기록.
+	ops 는 kernel 호출 수 x 호출 당 고정 연산 수 (core 간 비교용 고정 kernel mix 기준).
+	1. throttling : warmup 이후 core clock 이 그때까지의 최대 clock 의 throttle_pct 미만으로
+	   THROTTLE_SAMPLES 회 연속 떨어진 첫 sample (cpufreq 가 없는 경우 판정 안함).
+	2. balance : core 전체 구간 ops/s 가 다른 core 중앙값의 balance_pct 미만.
+*/
+//------------------------------------------------------------------------------
+/* kernel 호출 당 반복 수 (Makefile 기본 -O0 build 에서 호출 당 1 ms 이하) */
+#define	INT_LOOPS		8192
+#define	FP_LOOPS		2048
+#define	MEM_SLICE_KB	256
+/* 반복 당 연산 수 : xorshift 6, lcg 2, mix 3, rotate-add 4 / 4 vector x 4 lane x (mul + add) */
+#define	INT_OPS			15
+#define	FP_OPS			32
+/* memory kernel 은 64 bit word read-modify-write 1 회를 1 op 로 계산 */
+#define	MEM_SLICE_WORDS	(MEM_SLICE_KB * 1024 / sizeof(uint64_t))
+#define	MEM_WORDS		(CPU_TEST_MEM_KB * 1024 / sizeof(uint64_t))
+
+#define	FP_MUL			0.999f
+#define	FP_ADD			0.001f
+/* clock 저하가 연속된 sample 수 (scaling_cur_freq 순간값 제외) */
+#define	THROTTLE_SAMPLES	2
+
+static const double KernelOps[eCPU_KERNEL_END] = {
+	(double)INT_LOOPS * INT_OPS, (double)FP_LOOPS * FP_OPS, (double)MEM_SLICE_WORDS
+};
+
+struct cpu_ctx {
+	volatile int	stop;
+};
+
+struct cpu_worker {
+	struct cpu_ctx	*ctx;
+	int				id, cpu;
+	uint64_t		*mem;
+	/* sampler 가 읽는 kernel 별 호출 수, 실행 시간 (join 후) */
+	volatile unsigned long	calls[eCPU_KERNEL_END];
+	long			us[eCPU_KERNEL_END];
+	uint64_t		sink;
+};
+
+//------------------------------------------------------------------------------
+const char *cpu_test_isa (void)
+{
+#if defined(__ARM_NEON)
+	return "neon";
+#elif defined(__SSE2__)
+	return "sse";
+#else
+	return "c";
+#endif
+}
+
+//------------------------------------------------------------------------------
+const char *cpu_test_kernel_name (int kind)
+{
+	static const char *names[eCPU_KERNEL_END] = { "int", "fp", "mem" };
+
+	return	((kind >= 0) && (kind < eCPU_KERNEL_END)) ? names[kind] : "?";
+}
+
+//------------------------------------------------------------------------------
+void cpu_test_cfg_default (struct cpu_test_cfg *cfg)
+{
+	memset (cfg, 0, sizeof(struct cpu_test_cfg));
+	cfg->run_ms       = CPU_TEST_RUN_MS;
+	cfg->sample_ms    = CPU_TEST_SAMPLE_MS;
+	cfg->throttle_pct = CPU_TEST_THROTTLE_PCT;
+	cfg->balance_pct  = CPU_TEST_BALANCE_PCT;
+}
+
+//------------------------------------------------------------------------------
+static long now_us (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return	ts.tv_sec * 1000000L + ts.tv_nsec / 1000L;
+}
+
+//------------------------------------------------------------------------------
+// 독립된 4 개의 dependency chain (in-order core 에서도 pipeline 사용)
+//------------------------------------------------------------------------------
+static uint64_t kernel_int (uint64_t s, int loops)
+{
+	uint64_t a = s | 1, b = s ^ 0x9E3779B97F4A7C15ULL, c = s, d = ~s;
+	int i;
+
+	for (i = 0; i < loops; i++) {
+		a ^= a << 13;	a ^= a >> 7;	a ^= a << 17;
+		b  = b * 6364136223846793005ULL + 1442695040888963407ULL;
+		c += a ^ (b >> 29);
+		d  = ((d << 1) | (d >> 63)) + c;
+	}
+	return	a ^ b ^ c ^ d;
+}
+
+//------------------------------------------------------------------------------
+// x = x * FP_MUL + FP_ADD (1.0 으로 수렴, denormal/overflow 없음)
+//------------------------------------------------------------------------------
+static float kernel_fp (float s, int loops)
+{
+	int i;
+#if defined(__ARM_NEON)
+	float32x4_t m = vdupq_n_f32 (FP_MUL), c = vdupq_n_f32 (FP_ADD);
+	float32x4_t a0 = vdupq_n_f32 (s), a1 = vdupq_n_f32 (s + 1.0f);
+	float32x4_t a2 = vdupq_n_f32 (s + 2.0f), a3 = vdupq_n_f32 (s + 3.0f);
+
+	for (i = 0; i < loops; i++) {
+		a0 = vmlaq_f32 (c, a0, m);	a1 = vmlaq_f32 (c, a1, m);
+		a2 = vmlaq_f32 (c, a2, m);	a3 = vmlaq_f32 (c, a3, m);
+	}
+	a0 = vaddq_f32 (vaddq_f32 (a0, a1), vaddq_f32 (a2, a3));
+	return	vgetq_lane_f32 (a0, 0) + vgetq_lane_f32 (a0, 3);
+#elif defined(__SSE2__)
+	__m128 m = _mm_set1_ps (FP_MUL), c = _mm_set1_ps (FP_ADD);
+	__m128 a0 = _mm_set1_ps (s), a1 = _mm_set1_ps (s + 1.0f);
+	__m128 a2 = _mm_set1_ps (s + 2.0f), a3 = _mm_set1_ps (s + 3.0f);
+	float out[4];
+
+	for (i = 0; i < loops; i++) {
+		a0 = _mm_add_ps (_mm_mul_ps (a0, m), c);	a1 = _mm_add_ps (_mm_mul_ps (a1, m), c);
+		a2 = _mm_add_ps (_mm_mul_ps (a2, m), c);	a3 = _mm_add_ps (_mm_mul_ps (a3, m), c);
+	}
+	_mm_storeu_ps (out, _mm_add_ps (_mm_add_ps (a0, a1), _mm_add_ps (a2, a3)));
+	return	out[0] + out[3];
+#else
+	float a[16];
+	int j;
+
+	for (j = 0; j < 16; j++)
+		a[j] = s + (j / 4);
+	for (i = 0; i < loops; i++)
+		for (j = 0; j < 16; j++)
+			a[j] = a[j] * FP_MUL + FP_ADD;
+	return	a[0] + a[15];
+#endif
+}
+
+//------------------------------------------------------------------------------
+static uint64_t kernel_mem (uint64_t *p, size_t words, uint64_t s)
+{
+	uint64_t v;
+	size_t i;
+
+	for (i = 0; i < words; i++) {
+		v    = p[i];
+		p[i] = v + s;
+		s   ^= v;
+	}
+	return s;
+}
+
+//------------------------------------------------------------------------------
+static void *cpu_worker (void *arg)
+{
+	struct cpu_worker *w = (struct cpu_worker *)arg;
+	uint64_t s = w->id + 1;
+	float f = 1.0f;
+	size_t off = 0;
+	long t, t0 = now_us ();
+
+	while (!w->ctx->stop) {
+		s = kernel_int (s, INT_LOOPS);
+		t = now_us ();	w->us[eCPU_KERNEL_INT] += t - t0;	t0 = t;
+		w->calls[eCPU_KERNEL_INT]++;
+
+		f = kernel_fp (f, FP_LOOPS);
+		t = now_us ();	w->us[eCPU_KERNEL_FP]  += t - t0;	t0 = t;
+		w->calls[eCPU_KERNEL_FP]++;
+
+		/* buffer 전체를 slice 단위로 순환 (항상 cache miss) */
+		s = kernel_mem (w->mem + off, MEM_SLICE_WORDS, s);
+		off = (off + MEM_SLICE_WORDS) % MEM_WORDS;
+		t = now_us ();	w->us[eCPU_KERNEL_MEM] += t - t0;	t0 = t;
+		w->calls[eCPU_KERNEL_MEM]++;
+	}
+	w->sink = s ^ (uint64_t)f;
+	return arg;
+}
+
+//------------------------------------------------------------------------------
+static double worker_ops (const struct cpu_worker *w)
+{
+	double ops = 0;
+	int k;
+
+	for (k = 0; k < eCPU_KERNEL_END; k++)
+		ops += KernelOps[k] * w->calls[k];
+	return ops;
+}
+
+//------------------------------------------------------------------------------
+// sysfs 값 (kHz, m°C) 을 MHz, 0.1 C 로 변환하여 기록 (읽기 실패시 0)
+//------------------------------------------------------------------------------
+static void sample_take (struct sysfs_attr *freq, struct sysfs_attr *temp, int zones,
+						struct cpu_worker *w, int cnt, double *prev, long prev_us,
+						struct cpu_test_sample *s)
+{
+	double ops;
+	int i, v;
+
+	s->ts_us = now_us ();
+	for (i = 0; i < cnt; i++) {
+		ops = worker_ops (&w[i]);
+		s->mops[i] = (prev_us && (s->ts_us > prev_us)) ? (int)((ops - prev[i]) / (s->ts_us - prev_us)) : 0;
+		prev[i]    = ops;
+		sysfs_attr_read_int (&freq[i], &v);
+		s->mhz[i]  = v / 1000;
+	}
+	for (i = 0; i < zones; i++) {
+		sysfs_attr_read_int (&temp[i], &v);
+		s->temp_dc[i] = v / 100;
+	}
+}
+
+//------------------------------------------------------------------------------
+static int sample_temp (const struct cpu_test_sample *s, int zones)
+{
+	int i, t = s->temp_dc[0];
+
+	for (i = 1; i < zones; i++)
+		t = s->temp_dc[i] > t ? s->temp_dc[i] : t;
+	return t;
+}
+
+//------------------------------------------------------------------------------
+// core 별 warmup 이후 clock 저하 (그때까지의 최대 clock 기준)
+//------------------------------------------------------------------------------
+static void throttle_check (const struct cpu_test_cfg *cfg, struct cpu_test_result *res)
+{
+	int peak[CPU_TEST_CPU_MAX], low[CPU_TEST_CPU_MAX], i, c, mhz;
+
+	memset (peak, 0, sizeof(peak));
+	memset (low,  0, sizeof(low));
+	res->throttle_ms = -1;
+	for (i = 0; i < res->sample_cnt; i++) {
+		const struct cpu_test_sample *s = &res->sample[i];
+
+		for (c = 0; c < res->threads; c++) {
+			if (!(mhz = s->mhz[c]))
+				continue;
+			res->mhz_max = mhz > res->mhz_max ? mhz : res->mhz_max;
+			if (s->ms < CPU_TEST_WARMUP_MS) {
+				peak[c] = mhz > peak[c] ? mhz : peak[c];
+				continue;
+			}
+			if (!res->mhz_min || (mhz < res->mhz_min))
+				res->mhz_min = mhz;
+			if ((mhz * 100 < peak[c] * cfg->throttle_pct) && (++low[c] >= THROTTLE_SAMPLES)) {
+				if (res->throttle_ms < 0) {
+					res->throttle_ms  = res->sample[i - THROTTLE_SAMPLES + 1].ms;
+					res->throttle_mhz = res->sample[i - THROTTLE_SAMPLES + 1].mhz[c];
+					res->bad_cpu      = c;
+				}
+			} else if (mhz * 100 >= peak[c] * cfg->throttle_pct)
+				low[c] = 0;
+			peak[c] = mhz > peak[c] ? mhz : peak[c];
+		}
+		if (res->zones) {
+			int t = sample_temp (s, res->zones);
+
+			if (!i)
+				res->temp_start_dc = res->temp_max_dc = t;
+			res->temp_max_dc = t > res->temp_max_dc ? t : res->temp_max_dc;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// 다른 core ops/s 의 중앙값 대비 가장 느린 core
+//------------------------------------------------------------------------------
+static int balance_check (const struct cpu_test_cfg *cfg, struct cpu_test_result *res)
+{
+	int other[CPU_TEST_CPU_MAX], c, i, j, n, t, med, worst = -1;
+	double ratio, worst_ratio = 1.0;
+
+	if (res->threads < 2)
+		return -1;
+	for (c = 0; c < res->threads; c++) {
+		for (i = 0, n = 0; i < res->threads; i++)
+			if (i != c)
+				other[n++] = res->mops[i];
+		/* insertion sort (core 수 만큼) */
+		for (i = 1; i < n; i++)
+			for (j = i; (j > 0) && (other[j - 1] > other[j]); j--) {
+				t = other[j];	other[j] = other[j - 1];	other[j - 1] = t;
+			}
+		med = (n & 1) ? other[n / 2] : (other[n / 2 - 1] + other[n / 2]) / 2;
+		if (med <= 0)
+			continue;
+		ratio = (double)res->mops[c] / med;
+		if ((ratio * 100 < cfg->balance_pct) && (ratio < worst_ratio)) {
+			worst_ratio = ratio;
+			worst       = c;
+		}
+	}
+	return worst;
+}
+
+//------------------------------------------------------------------------------
+int cpu_test_run (const struct cpu_test_cfg *cfg, struct cpu_test_result *res)
+{
+	struct cpu_worker w[CPU_TEST_CPU_MAX];
+	struct sysfs_attr freq[CPU_TEST_CPU_MAX], temp[CPU_TEST_ZONE_MAX];
+	struct cpu_ctx ctx;
+	struct timespec next;
+	pthread_t th[CPU_TEST_CPU_MAX];
+	pthread_attr_t attr;
+	cpu_set_t set;
+	double prev[CPU_TEST_CPU_MAX], base[CPU_TEST_CPU_MAX];
+	char path[128];
+	long start = now_us (), t0, us;
+	int i, k, cnt, started = 0, sample_ms, ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+
+	memset (res, 0, sizeof(struct cpu_test_result));
+	memset (w, 0, sizeof(w));
+	memset (&ctx, 0, sizeof(ctx));
+	memset (prev, 0, sizeof(prev));
+
+	ncpu = ncpu > 0 ? ncpu : 1;
+	cnt  = cfg->threads > 0 ? cfg->threads : ncpu;
+	cnt  = cnt > CPU_TEST_CPU_MAX ? CPU_TEST_CPU_MAX : cnt;
+	res->threads     = cnt;
+	res->verdict     = eCPU_ERROR;
+	res->bad_cpu     = -1;
+	res->throttle_ms = -1;
+
+	/* sample 배열 크기에 맞게 주기 조정 */
+	sample_ms = cfg->sample_ms > 0 ? cfg->sample_ms : CPU_TEST_SAMPLE_MS;
+	if (cfg->run_ms / sample_ms >= CPU_TEST_SAMPLE_MAX)
+		sample_ms = cfg->run_ms / (CPU_TEST_SAMPLE_MAX - 1) + 1;
+
+	for (i = 0; i < cnt; i++) {
+		w[i].ctx = &ctx;
+		w[i].id  = i;
+		w[i].cpu = i % ncpu;
+		w[i].mem = mmap (NULL, MEM_WORDS * sizeof(uint64_t), PROT_READ | PROT_WRITE,
+						MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (w[i].mem == MAP_FAILED) {
+			w[i].mem = NULL;
+			goto out;
+		}
+		memset (w[i].mem, i, MEM_WORDS * sizeof(uint64_t));
+	}
+
+	/* cpufreq, thermal 이 없는 경우 (simulation, 일부 kernel) 해당 값은 0 으로 기록 */
+	for (i = 0; i < cnt; i++) {
+		snprintf (path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", w[i].cpu);
+		sysfs_attr_open (&freq[i], path);
+	}
+	for (res->zones = 0; res->zones < CPU_TEST_ZONE_MAX; res->zones++) {
+		struct sysfs_attr type;
+
+		snprintf (path, sizeof(path), "/sys/class/thermal/thermal_zone%d/temp", res->zones);
+		if (!sysfs_attr_open (&temp[res->zones], path))
+			break;
+		snprintf (path, sizeof(path), "/sys/class/thermal/thermal_zone%d/type", res->zones);
+		if (sysfs_attr_open (&type, path)) {
+			sysfs_attr_read (&type, res->zone_type[res->zones], sizeof(res->zone_type[0]));
+			sysfs_attr_close (&type);
+		}
+	}
+
+	for (i = 0; i < cnt; i++) {
+		pthread_attr_init (&attr);
+		CPU_ZERO (&set);
+		CPU_SET (w[i].cpu, &set);
+		pthread_attr_setaffinity_np (&attr, sizeof(set), &set);
+		if (pthread_create (&th[i], &attr, cpu_worker, &w[i])) {
+			pthread_attr_destroy (&attr);
+			break;
+		}
+		pthread_attr_destroy (&attr);
+		started++;
+	}
+
+	if (started == cnt) {
+		/* sample 0 : 시작 온도/clock, 이후 sample_ms 주기 (absolute, 누적 오차 없음) */
+		sample_take (freq, temp, res->zones, w, cnt, prev, 0, &res->sample[0]);
+		memcpy (base, prev, sizeof(base));
+		t0 = res->sample[0].ts_us;
+		res->sample_cnt = 1;
+		clock_gettime (CLOCK_MONOTONIC, &next);
+		while (res->sample_cnt < CPU_TEST_SAMPLE_MAX) {
+			struct cpu_test_sample *s = &res->sample[res->sample_cnt];
+
+			next.tv_nsec += (sample_ms % 1000) * 1000000L;
+			next.tv_sec  += sample_ms / 1000 + next.tv_nsec / 1000000000L;
+			next.tv_nsec %= 1000000000L;
+			while (clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL))
+				;
+			sample_take (freq, temp, res->zones, w, cnt, prev, s[-1].ts_us, s);
+			s->ms = (int)((s->ts_us - t0) / 1000);
+			res->sample_cnt++;
+			if (s->ms >= cfg->run_ms)
+				break;
+		}
+	}
+	ctx.stop = 1;
+	for (i = 0; i < started; i++)
+		pthread_join (th[i], NULL);
+	for (i = 0; i < cnt; i++)
+		sysfs_attr_close (&freq[i]);
+	for (i = 0; i < res->zones; i++)
+		sysfs_attr_close (&temp[i]);
+	if (started != cnt) {
+		printf ("%s : thread create error!\n", __func__);
+		goto out;
+	}
+
+	/* 전체 구간 : sample 0 ~ 마지막 sample 사이 진행량 */
+	us = res->sample[res->sample_cnt - 1].ts_us - t0;
+	for (i = 0; i < cnt; i++)
+		res->mops[i] = us > 0 ? (int)((prev[i] - base[i]) / us) : 0;
+	for (k = 0; k < eCPU_KERNEL_END; k++) {
+		double mops = 0;
+
+		for (i = 0; i < cnt; i++)
+			mops += w[i].us[k] ? KernelOps[k] * w[i].calls[k] / w[i].us[k] : 0;
+		res->kernel_mops[k] = (int)mops;
+	}
+
+	throttle_check (cfg, res);
+	if (res->throttle_ms >= 0)
+		res->verdict = eCPU_THROTTLE;
+	else if ((res->bad_cpu = balance_check (cfg, res)) >= 0)
+		res->verdict = eCPU_BALANCE;
+	else {
+		res->verdict = eCPU_PASS;
+		for (i = 0; (i < cnt) && cfg->mops_min; i++) {
+			if (res->mops[i] < cfg->mops_min) {
+				res->verdict = eCPU_SLOW;
+				res->bad_cpu = i;
+				break;
+			}
+		}
+	}
+out:
+	for (i = 0; i < cnt; i++)
+		if (w[i].mem)
+			munmap (w[i].mem, MEM_WORDS * sizeof(uint64_t));
+	res->elapsed_ms = (now_us () - start) / 1000;
+
+	printf ("%s : %s, %d threads, %d samples, %s (%ld ms)\n", __func__, cpu_test_isa (),
+		res->threads, res->sample_cnt, res->verdict == eCPU_PASS ? "pass" : "fail", res->elapsed_ms);
+	for (i = 0; i < res->threads; i++)
+		printf ("%s : cpu%d %d Mops/s\n", __func__, w[i].cpu, res->mops[i]);
+	for (k = 0; k < eCPU_KERNEL_END; k++)
+		printf ("%s : %-3s %d Mops/s\n", __func__, cpu_test_kernel_name (k), res->kernel_mops[k]);
+	if (res->mhz_max)
+		printf ("%s : clock %d ~ %d MHz, throttling %d ms\n", __func__,
+			res->mhz_min, res->mhz_max, res->throttle_ms);
+	if (res->zones)
+		printf ("%s : temp %d.%d -> %d.%d C (%d zones)\n", __func__,
+			res->temp_start_dc / 10, abs (res->temp_start_dc % 10),
+			res->temp_max_dc / 10, abs (res->temp_max_dc % 10), res->zones);
+	return	res->verdict == eCPU_PASS;
+}
+
+//------------------------------------------------------------------------------
+void cpu_test_summary (const struct cpu_test_result *res, char *buf, int size)
+{
+	int i, n, min = 0, max = 0;
+
+	for (i = 0; i < res->threads; i++) {
+		min = (!i || (res->mops[i] < min)) ? res->mops[i] : min;
+		max = (!i || (res->mops[i] > max)) ? res->mops[i] : max;
+	}
+	switch (res->verdict) {
+		case eCPU_ERROR:
+			snprintf (buf, size, "ERROR");
+			return;
+		case eCPU_THROTTLE:
+			snprintf (buf, size, "THROTTLE %dMHz %d.%ds", res->throttle_mhz,
+				res->throttle_ms / 1000, res->throttle_ms % 1000 / 100);
+			return;
+		case eCPU_BALANCE:
+			snprintf (buf, size, "CPU%d %d/%dM", res->bad_cpu, res->mops[res->bad_cpu], max);
+			return;
+		case eCPU_SLOW:
+			snprintf (buf, size, "SLOW CPU%d %dM", res->bad_cpu, res->mops[res->bad_cpu]);
+			return;
+		default:
+			break;
+	}
+	n = snprintf (buf, size, "%dM", min);
+	if (res->mhz_max && (n < size))
+		n += snprintf (buf + n, size - n, " %dMHz", res->mhz_min);
+	if (res->zones && (n < size))
+		snprintf (buf + n, size - n, " %d.%dC", res->temp_max_dc / 10, abs (res->temp_max_dc % 10));
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
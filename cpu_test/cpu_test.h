@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+/**
+ * @file cpu_test.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief multi-core compute load (int/NEON/memory kernel mix), clock and thermal throttling test.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __CPU_TEST_H__
+#define __CPU_TEST_H__
+
+//------------------------------------------------------------------------------
+#define	CPU_TEST_CPU_MAX		8
+#define	CPU_TEST_ZONE_MAX		4
+#define	CPU_TEST_SAMPLE_MAX		64
+/* 전체 부하 시간, cpufreq/thermal sample 주기 (ms) */
+#define	CPU_TEST_RUN_MS			5000
+#define	CPU_TEST_SAMPLE_MS		250
+/* 시작 후 governor 가 clock 을 올리는 시간 (throttling 판정 제외) */
+#define	CPU_TEST_WARMUP_MS		500
+/* core clock 이 측정 중 최대 clock 의 % 미만으로 떨어지면 throttling */
+#define	CPU_TEST_THROTTLE_PCT	90
+/* core ops/s 가 다른 core 중앙값의 % 미만이면 fail */
+#define	CPU_TEST_BALANCE_PCT	80
+/* memory kernel buffer (thread 당, L3 cache 512KB 보다 충분히 크게) */
+#define	CPU_TEST_MEM_KB			4096
+
+enum {
+	eCPU_KERNEL_INT = 0,
+	eCPU_KERNEL_FP,
+	eCPU_KERNEL_MEM,
+	eCPU_KERNEL_END
+};
+
+enum {
+	eCPU_PASS = 0,
+	/* buffer 할당, thread 생성 실패 */
+	eCPU_ERROR,
+	/* 측정 중 clock 저하 */
+	eCPU_THROTTLE,
+	/* 다른 core 보다 느린 core */
+	eCPU_BALANCE,
+	/* core ops/s 기준 미달 */
+	eCPU_SLOW,
+	eCPU_VERDICT_END
+};
+
+struct cpu_test_cfg {
+	/* 0 : online cpu 수 */
+	int		threads;
+	int		run_ms, sample_ms;
+	int		throttle_pct, balance_pct;
+	/* core 별 최소 Mops/s, 0 : 판정 안함 (m1-test.cfg 'T' 기준값, SKU 별) */
+	int		mops_min;
+};
+
+struct cpu_test_sample {
+	/* 측정 시간 (CLOCK_MONOTONIC us, trace_now_us 와 같은 기준), 시작 기준 ms */
+	long	ts_us;
+	int		ms;
+	/* core 별 clock (MHz, 0 : cpufreq 없음), 이전 sample 이후 Mops/s */
+	int		mhz[CPU_TEST_CPU_MAX];
+	int		mops[CPU_TEST_CPU_MAX];
+	/* thermal zone 별 온도 (0.1 C) */
+	int		temp_dc[CPU_TEST_ZONE_MAX];
+};
+
+struct cpu_test_result {
+	int		verdict;
+	int		threads, zones;
+	/* core 별 Mops/s (전체 구간), kernel 별 Mops/s (kernel 실행 시간 기준, core 합) */
+	int		mops[CPU_TEST_CPU_MAX];
+	int		kernel_mops[eCPU_KERNEL_END];
+	/* eCPU_THROTTLE/BALANCE/SLOW 인 core (thread index), -1 : 없음 */
+	int		bad_cpu;
+	/* throttling 시작 (시작 기준 ms, -1 : 없음) 과 그때 clock (MHz) */
+	int		throttle_ms, throttle_mhz;
+	/* 전체 core 중 최대/최소 clock (MHz, 0 : cpufreq 없음) */
+	int		mhz_max, mhz_min;
+	/* 시작/최대 온도 (0.1 C, thermal zone 중 최대값), zones 0 : 측정 안됨 */
+	int		temp_start_dc, temp_max_dc;
+	char	zone_type[CPU_TEST_ZONE_MAX][20];
+	int		sample_cnt;
+	struct cpu_test_sample	sample[CPU_TEST_SAMPLE_MAX];
+	long	elapsed_ms;
+};
+
+//------------------------------------------------------------------------------
+extern const char	*cpu_test_isa		(void);
+extern const char	*cpu_test_kernel_name	(int kind);
+extern void		cpu_test_cfg_default	(struct cpu_test_cfg *cfg);
+/* return 1 : pass, 0 : fail (res->verdict) */
+extern int		cpu_test_run		(const struct cpu_test_cfg *cfg, struct cpu_test_result *res);
+/* response_str 용 (예 "812M 1992MHz 58.3C", "THROTTLE 1416MHz 3.2s") */
+extern void		cpu_test_summary	(const struct cpu_test_result *res, char *buf, int size);
+
+//------------------------------------------------------------------------------
+#endif	// #define __CPU_TEST_H__
+//------------------------------------------------------------------------------
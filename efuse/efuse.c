@@ -0,0 +1,351 @@
+//------------------------------------------------------------------------------
+/**
+ * @file efuse.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-M1 efuse uuid provision (efuse.py native port).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+
+#include "efuse.h"
+#include "../sysfs_attr/sysfs_attr.h"
+
+//------------------------------------------------------------------------------
+struct efuse_backend {
+	const char	*name;
+	int			(*ioctl) (unsigned long cmd, void *buf);
+};
+
+static int	dev_ioctl	(unsigned long cmd, void *buf);
+static int	sim_ioctl	(unsigned long cmd, void *buf);
+
+static const struct efuse_backend Backends[eEFUSE_BACKEND_END] = {
+	{ "dev", dev_ioctl },
+	{ "sim", sim_ioctl },
+};
+
+static const struct efuse_backend *Backend = &Backends[eEFUSE_BACKEND_DEV];
+
+static char	DevName [128] = EFUSE_DEV_NAME;
+static char	UuidFile[128] = EFUSE_UUID_FILE;
+
+/*
+	uuid file 은 bt thread 에서 주기적으로 읽으므로 fd 유지.
+	read 는 bt thread 와 efuse test thread 에서 같이 사용 (read error 시 fd close/reopen) 하므로 lock,
+	wait (poll, timeout 동안 대기) 는 bt thread 전용 fd 사용.
+*/
+static struct sysfs_attr	UuidAttr = { -1, "" };
+static struct sysfs_attr	WaitAttr = { -1, "" };
+static pthread_mutex_t		UuidLock = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+// efuse.py : data = str(data).replace("-", "")
+//------------------------------------------------------------------------------
+static int strip_uuid (const char *uuid, char *data, int size)
+{
+	int len = 0;
+
+	while (*uuid && (*uuid != '\n')) {
+		if (*uuid != '-') {
+			if (len >= size - 1)
+				return -1;
+			data[len++] = *uuid;
+		}
+		uuid++;
+	}
+	data[len] = 0;
+	return len;
+}
+
+//------------------------------------------------------------------------------
+static int dev_ioctl (unsigned long cmd, void *buf)
+{
+	int fd, ret;
+
+	if ((fd = open (DevName, O_RDWR)) < 0) {
+		printf ("%s : %s open error! (%s)\n", __func__, DevName, strerror(errno));
+		return -1;
+	}
+	if ((ret = ioctl (fd, cmd, buf)) < 0)
+		printf ("%s : ioctl 0x%04lx error! (%s)\n", __func__, cmd, strerror(errno));
+	close (fd);
+	return ret;
+}
+
+//------------------------------------------------------------------------------
+//
+// file image simulator : slot(32 bytes) 0xff = 미기록, 0x00 = clear, 그 외 = uuid
+// 기록된 마지막 slot을 uuid file 에 "8-4-4-4-12" 형식으로 기록 (/sys/class/efuse/uuid 대체)
+//
+//------------------------------------------------------------------------------
+static int sim_image (unsigned char *img, int write)
+{
+	int fd, ret;
+
+	if ((fd = open (DevName, O_RDWR | O_CREAT, 0644)) < 0)
+		return -1;
+
+	if (write) {
+		ret = pwrite (fd, img, EFUSE_DATA_SIZE * EFUSE_SLOT_CNT, 0);
+	} else {
+		memset (img, 0xff, EFUSE_DATA_SIZE * EFUSE_SLOT_CNT);
+		ret = pread (fd, img, EFUSE_DATA_SIZE * EFUSE_SLOT_CNT, 0);
+		ret = (ret < 0) ? ret : EFUSE_DATA_SIZE * EFUSE_SLOT_CNT;
+	}
+	close (fd);
+	return	(ret == EFUSE_DATA_SIZE * EFUSE_SLOT_CNT) ? 0 : -1;
+}
+
+//------------------------------------------------------------------------------
+static int sim_slot_state (const unsigned char *slot)
+{
+	int i, blank = 1, clear = 1;
+
+	for (i = 0; i < EFUSE_DATA_SIZE; i++) {
+		blank &= (slot[i] == 0xff);
+		clear &= (slot[i] == 0x00);
+	}
+	/* 0 : blank, 1 : clear, 2 : data */
+	return	blank ? 0 : (clear ? 1 : 2);
+}
+
+//------------------------------------------------------------------------------
+static int sim_update_uuid (const unsigned char *img)
+{
+	const char *d = NULL;
+	char uuid[64];
+	int i, fd;
+
+	for (i = 0; i < EFUSE_SLOT_CNT; i++) {
+		if (sim_slot_state (&img[i * EFUSE_DATA_SIZE]) == 2)
+			d = (const char *)&img[i * EFUSE_DATA_SIZE];
+	}
+	memset (uuid, 0, sizeof(uuid));
+	if (d != NULL)
+		snprintf (uuid, sizeof(uuid), "%.8s-%.4s-%.4s-%.4s-%.12s\n",
+			d, d + 8, d + 12, d + 16, d + 20);
+
+	if ((fd = open (UuidFile, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+		return -1;
+	i = write (fd, uuid, strlen (uuid));
+	close (fd);
+	return	(i == (int)strlen (uuid)) ? 0 : -1;
+}
+
+//------------------------------------------------------------------------------
+static int sim_ioctl (unsigned long cmd, void *buf)
+{
+	struct efuse_req *req = (struct efuse_req *)buf;
+	unsigned char img[EFUSE_DATA_SIZE * EFUSE_SLOT_CNT], *slot;
+	char data[EFUSE_DATA_SIZE + 1];
+	int i;
+
+	if (sim_image (img, 0))
+		return -1;
+
+	if (cmd == EFUSE_IOCTL_DUMP) {
+		for (i = 0; i < EFUSE_DATA_SIZE * EFUSE_SLOT_CNT; i++)
+			printf ("%02x%s", img[i], ((i + 1) % EFUSE_DATA_SIZE) ? " " : "\n");
+		return 0;
+	}
+	if ((cmd != EFUSE_IOCTL_PROVISION) && (cmd != EFUSE_IOCTL_CLEAR))
+		return -1;
+
+	if (memcmp (req->magic, EFUSE_MAGIC, sizeof(req->magic)) ||
+		(req->offset % EFUSE_DATA_SIZE) || (req->offset >= EFUSE_DATA_SIZE * EFUSE_SLOT_CNT)) {
+		errno = EINVAL;
+		return -1;
+	}
+	slot = &img[req->offset];
+
+	if (cmd == EFUSE_IOCTL_CLEAR) {
+		memset (slot, 0x00, EFUSE_DATA_SIZE);
+	} else {
+		/* driver 와 동일하게 checksum 확인, 이미 기록된 slot은 재기록 불가 */
+		memset (data, 0, sizeof(data));
+		memcpy (data, req->data, EFUSE_DATA_SIZE);
+		if ((req->len > EFUSE_DATA_SIZE) || (efuse_checksum (data) != req->checksum)) {
+			errno = EINVAL;
+			return -1;
+		}
+		if (sim_slot_state (slot) != 0) {
+			errno = EPERM;
+			return -1;
+		}
+		memcpy (slot, req->data, EFUSE_DATA_SIZE);
+	}
+	if (sim_image (img, 1))
+		return -1;
+
+	return	sim_update_uuid (img);
+}
+
+//------------------------------------------------------------------------------
+int efuse_init (int backend, const char *dev, const char *uuid_file)
+{
+	if ((backend < 0) || (backend >= eEFUSE_BACKEND_END))
+		return 0;
+
+	Backend = &Backends[backend];
+	if (dev != NULL)
+		snprintf (DevName,  sizeof(DevName),  "%s", dev);
+	if (uuid_file != NULL)
+		snprintf (UuidFile, sizeof(UuidFile), "%s", uuid_file);
+
+	pthread_mutex_lock (&UuidLock);
+	sysfs_attr_close (&UuidAttr);
+	sysfs_attr_clear (&UuidAttr);
+	sysfs_attr_close (&WaitAttr);
+	sysfs_attr_clear (&WaitAttr);
+	pthread_mutex_unlock (&UuidLock);
+
+	if (backend == eEFUSE_BACKEND_SIM) {
+		unsigned char img[EFUSE_DATA_SIZE * EFUSE_SLOT_CNT];
+		/* image 가 없는 경우 미기록(0xff) 상태로 생성 */
+		if (sim_image (img, 0) || sim_image (img, 1) || sim_update_uuid (img))
+			return 0;
+	}
+	printf ("%s : backend = %s, dev = %s, uuid = %s\n", __func__, Backend->name, DevName, UuidFile);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+// efuse.py checksum() : sum(ord(c)) % 256
+//------------------------------------------------------------------------------
+int efuse_checksum (const char *data)
+{
+	int sum = 0;
+
+	while (*data)
+		sum += (unsigned char)*data++;
+
+	return	sum % 256;
+}
+
+//------------------------------------------------------------------------------
+int efuse_make_req (struct efuse_req *req, const char *uuid, int offset)
+{
+	char data[EFUSE_DATA_MAX + 1];
+	int len;
+
+	if ((len = strip_uuid (uuid, data, sizeof(data))) < 0) {
+		printf ("%s : data is too long, must be <%d\n", __func__, EFUSE_DATA_MAX);
+		return -1;
+	}
+	/* struct.pack 32s : 32 bytes 초과 data는 잘리고 남는 부분은 0 */
+	memset (req, 0, sizeof(struct efuse_req));
+	memcpy (req->magic, EFUSE_MAGIC, sizeof(req->magic));
+	req->offset   = offset;
+	req->len      = len;
+	req->checksum = efuse_checksum (data);
+	memcpy (req->data, data, len > EFUSE_DATA_SIZE ? EFUSE_DATA_SIZE : len);
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+int efuse_provision (const char *uuid, int offset)
+{
+	struct efuse_req req;
+
+	if (efuse_make_req (&req, uuid, offset))
+		return 0;
+
+	if (Backend->ioctl (EFUSE_IOCTL_PROVISION, &req) < 0) {
+		printf ("%s : write error! offset = %d (%s)\n", __func__, offset, strerror(errno));
+		return 0;
+	}
+
+	/* 기록 후 uuid file 로 확인 */
+	if (!efuse_verify (uuid)) {
+		printf ("%s : verify error! uuid = %s\n", __func__, uuid);
+		return 0;
+	}
+	printf ("%s : efuse write success! uuid = %s, offset = %d\n", __func__, uuid, offset);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+// efuse 내용은 kernel log (dmesg) 로 출력 됨 (sim backend는 stdout)
+//------------------------------------------------------------------------------
+int efuse_dump (void)
+{
+	char buf[4] = { '1', '2', '3', '4' };
+
+	return	(Backend->ioctl (EFUSE_IOCTL_DUMP, buf) < 0) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+int efuse_clear (int offset)
+{
+	struct efuse_req req;
+
+	memset (&req, 0, sizeof(req));
+	memcpy (req.magic, EFUSE_MAGIC, sizeof(req.magic));
+	req.offset = offset;
+
+	return	(Backend->ioctl (EFUSE_IOCTL_CLEAR, &req) < 0) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+static int uuid_attr_open (struct sysfs_attr *attr)
+{
+	if (!attr->path[0])
+		sysfs_attr_open (attr, UuidFile);
+
+	return	(attr->fd >= 0);
+}
+
+//------------------------------------------------------------------------------
+int efuse_read_uuid (char *buf, int size)
+{
+	int len;
+
+	pthread_mutex_lock (&UuidLock);
+	uuid_attr_open (&UuidAttr);
+	len = sysfs_attr_read (&UuidAttr, buf, size);
+	pthread_mutex_unlock (&UuidLock);
+	if (len <= 0)
+		return 0;
+
+	while ((len > 0) && (buf[len - 1] == ' '))
+		buf[--len] = 0;
+	return len;
+}
+
+//------------------------------------------------------------------------------
+int efuse_uuid_wait (int timeout_ms)
+{
+	uuid_attr_open (&WaitAttr);
+	return	sysfs_attr_wait (&WaitAttr, timeout_ms);
+}
+
+//------------------------------------------------------------------------------
+int efuse_verify (const char *uuid)
+{
+	char rd[128], rd_data[EFUSE_DATA_MAX + 1], data[EFUSE_DATA_MAX + 1];
+
+	if (!efuse_read_uuid (rd, sizeof(rd)))
+		return 0;
+
+	if ((strip_uuid (uuid, data, sizeof(data)) <= 0) ||
+		(strip_uuid (rd, rd_data, sizeof(rd_data)) <= 0))
+		return 0;
+
+	return	strcasecmp (data, rd_data) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+/**
+ * @file efuse.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-M1 efuse uuid provision (efuse.py native port).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __EFUSE_H__
+#define __EFUSE_H__
+
+//------------------------------------------------------------------------------
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+#define	EFUSE_DEV_NAME			"/dev/efuse"
+#define	EFUSE_UUID_FILE			"/sys/class/efuse/uuid"
+
+#define	EFUSE_MAGIC				"HKM1"
+#define	EFUSE_IOCTL_PROVISION	0x7673
+#define	EFUSE_IOCTL_DUMP		0x7674
+#define	EFUSE_IOCTL_CLEAR		0x7675
+
+/* uuid 기록 위치 (offset 0, 32, 64, 96), 최대 4번 기록 가능 */
+#define	EFUSE_DATA_SIZE			32
+#define	EFUSE_SLOT_CNT			4
+#define	EFUSE_DATA_MAX			64
+
+enum {
+	/* /dev/efuse ioctl */
+	eEFUSE_BACKEND_DEV = 0,
+	/* file image simulator (fuse 사용 없이 기록 test) */
+	eEFUSE_BACKEND_SIM,
+	eEFUSE_BACKEND_END
+};
+
+/* efuse.py struct.pack("4sIIB32s", magic, offset, len, checksum, data) 와 동일 (45 bytes) */
+struct efuse_req {
+	char		magic[4];
+	uint32_t	offset;
+	uint32_t	len;
+	uint8_t		checksum;
+	char		data[EFUSE_DATA_SIZE];
+} __attribute__((packed));
+
+//------------------------------------------------------------------------------
+/* dev, uuid_file NULL : default (sim backend는 dev = image file) */
+extern int	efuse_init		(int backend, const char *dev, const char *uuid_file);
+extern int	efuse_checksum	(const char *data);
+extern int	efuse_make_req	(struct efuse_req *req, const char *uuid, int offset);
+/* return 1 : 기록 후 uuid file 에서 확인 완료 */
+extern int	efuse_provision	(const char *uuid, int offset);
+extern int	efuse_dump		(void);
+extern int	efuse_clear		(int offset);
+/* 여러 thread 에서 호출 가능 (uuid file fd 는 lock) */
+extern int	efuse_read_uuid	(char *buf, int size);
+/* uuid 변경 (sysfs_notify) 대기, 지원하지 않는 경우 timeout 후 return */
+extern int	efuse_uuid_wait	(int timeout_ms);
+extern int	efuse_verify	(const char *uuid);
+
+//------------------------------------------------------------------------------
+#endif	// #define __EFUSE_H__
+//------------------------------------------------------------------------------
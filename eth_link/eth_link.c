@@ -0,0 +1,418 @@
+//------------------------------------------------------------------------------
+/**
+ * @file eth_link.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief eth link speed control (SIOCETHTOOL) and link/address monitor (RTM_NEWLINK/RTM_NEWADDR).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <linux/sockios.h>
+#include <linux/ethtool.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include "eth_link.h"
+
+//------------------------------------------------------------------------------
+#define	NETLINK_BUF_SIZE		8192
+#define	NETLINK_STOP_CHECK_MS	1000
+/* netlink event 누락 대비 eth_link_wait 중 link 상태 재확인 주기 */
+#define	LINK_REFRESH_MS			1000
+#define	FAKE_POLL_MS			20
+
+//------------------------------------------------------------------------------
+static struct eth_link_state	LinkState;
+static pthread_mutex_t			LinkLock = PTHREAD_MUTEX_INITIALIZER;
+static struct event_notify		LinkNotify;
+static struct event_notify		*UserNotify = NULL;
+
+static char	IfName[ETH_LINK_NAME_SIZE] = "eth0";
+static int	IfIndex = 0, CtlFd = -1, NlFd = -1, Fake = 0;
+
+/* fake backend auto negotiation 완료 시간 (us, 0 : 없음) */
+static long	FakeUpUs = 0;
+static int	FakeSpeed = 0;
+
+//------------------------------------------------------------------------------
+static long now_us (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return	ts.tv_sec * 1000000L + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+static int ethtool_ioctl (struct ethtool_cmd *ecmd)
+{
+	struct ifreq ifr;
+
+	memset (&ifr, 0, sizeof(ifr));
+	memcpy (ifr.ifr_name, IfName, IFNAMSIZ - 1);
+	ifr.ifr_data = (void *)ecmd;
+
+	return	ioctl (CtlFd, SIOCETHTOOL, &ifr);
+}
+
+//------------------------------------------------------------------------------
+static int ethtool_speed (void)
+{
+	struct ethtool_cmd ecmd;
+	unsigned int speed;
+
+	memset (&ecmd, 0, sizeof(ecmd));
+	ecmd.cmd = ETHTOOL_GSET;
+	if (ethtool_ioctl (&ecmd))
+		return 0;
+
+	speed = ethtool_cmd_speed (&ecmd);
+	return	(speed == (unsigned int)SPEED_UNKNOWN) ? 0 : (int)speed;
+}
+
+//------------------------------------------------------------------------------
+static int if_running (void)
+{
+	struct ifreq ifr;
+
+	memset (&ifr, 0, sizeof(ifr));
+	memcpy (ifr.ifr_name, IfName, IFNAMSIZ - 1);
+	if (ioctl (CtlFd, SIOCGIFFLAGS, &ifr))
+		return 0;
+
+	return	(ifr.ifr_flags & IFF_RUNNING) ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+static void link_update (int up, int speed)
+{
+	int changed;
+
+	pthread_mutex_lock (&LinkLock);
+	if (LinkState.up && !up)
+		LinkState.flaps++;
+	changed = (LinkState.up != up) || (LinkState.speed != speed);
+	LinkState.up    = up;
+	LinkState.speed = up ? speed : 0;
+	pthread_mutex_unlock (&LinkLock);
+
+	if (changed) {
+		event_notify_post (&LinkNotify);
+		if (UserNotify != NULL)
+			event_notify_post (UserNotify);
+	}
+}
+
+//------------------------------------------------------------------------------
+static void addr_refresh (void)
+{
+	struct ifreq ifr;
+	char ip[ETH_LINK_IP_SIZE];
+	int changed;
+
+	memset (ip, 0, sizeof(ip));
+	memset (&ifr, 0, sizeof(ifr));
+	memcpy (ifr.ifr_name, IfName, IFNAMSIZ - 1);
+	ifr.ifr_addr.sa_family = AF_INET;
+	if (!ioctl (CtlFd, SIOCGIFADDR, &ifr))
+		inet_ntop (AF_INET, &((struct sockaddr_in *)&ifr.ifr_addr)->sin_addr, ip, sizeof(ip));
+
+	pthread_mutex_lock (&LinkLock);
+	changed = strcmp (LinkState.ip, ip);
+	memcpy (LinkState.ip, ip, sizeof(ip));
+	pthread_mutex_unlock (&LinkLock);
+
+	if (changed) {
+		event_notify_post (&LinkNotify);
+		if (UserNotify != NULL)
+			event_notify_post (UserNotify);
+	}
+}
+
+//------------------------------------------------------------------------------
+static void link_refresh (void)
+{
+	int up, speed = 0, pending = 0;
+
+	if (Fake) {
+		pthread_mutex_lock (&LinkLock);
+		if (FakeUpUs && (now_us () >= FakeUpUs)) {
+			FakeUpUs = 0;
+			pending  = 1;
+			speed    = FakeSpeed;
+		}
+		pthread_mutex_unlock (&LinkLock);
+		if (pending)
+			link_update (1, speed);
+		return;
+	}
+	if ((up = if_running ()))
+		speed = ethtool_speed ();
+	link_update (up, speed);
+}
+
+//------------------------------------------------------------------------------
+int eth_link_init (const char *ifname, int fake, struct event_notify *notify)
+{
+	struct sockaddr_nl addr;
+
+	if (ifname != NULL)
+		snprintf (IfName, sizeof(IfName), "%s", ifname);
+
+	event_notify_init (&LinkNotify);
+	UserNotify = notify;
+	Fake       = fake;
+	memset (&LinkState, 0, sizeof(LinkState));
+
+	/* fake backend는 1Gbps link up 상태에서 시작 */
+	if (Fake) {
+		LinkState.up    = 1;
+		LinkState.speed = 1000;
+		return 1;
+	}
+
+	if ((CtlFd = socket (AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0)) < 0) {
+		printf ("%s : ioctl socket error! (%s)\n", __func__, strerror(errno));
+		return 0;
+	}
+	if ((IfIndex = if_nametoindex (IfName)) == 0) {
+		printf ("%s : %s not found!\n", __func__, IfName);
+		close (CtlFd);
+		CtlFd = -1;
+		return 0;
+	}
+	link_refresh ();
+	addr_refresh ();
+
+	/* netlink socket 생성 실패시에는 eth_link_wait 에서 주기적으로 link 상태 확인 */
+	if ((NlFd = socket (AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE)) < 0) {
+		printf ("%s : netlink socket error! (%s)\n", __func__, strerror(errno));
+		return 1;
+	}
+	memset (&addr, 0, sizeof(addr));
+	addr.nl_family = AF_NETLINK;
+	addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR;
+	if (bind (NlFd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printf ("%s : netlink bind error! (%s)\n", __func__, strerror(errno));
+		close (NlFd);
+		NlFd = -1;
+	}
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+int eth_link_get (struct eth_link_state *state)
+{
+	if (!Fake && (CtlFd < 0))
+		return 0;
+
+	if (Fake)
+		link_refresh ();
+
+	pthread_mutex_lock (&LinkLock);
+	memcpy (state, &LinkState, sizeof(struct eth_link_state));
+	pthread_mutex_unlock (&LinkLock);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+// ethtool -s eth0 speed {speed} duplex full 과 동일.
+// 1000BASE-T는 auto negotiation 이 필수이므로 autoneg 는 유지하고
+// advertising 을 요청 속도(full duplex)로 제한한다.
+//------------------------------------------------------------------------------
+int eth_link_set_speed (int speed)
+{
+	struct ethtool_cmd ecmd;
+	unsigned int adv;
+
+	if (Fake) {
+		pthread_mutex_lock (&LinkLock);
+		FakeSpeed = speed;
+		FakeUpUs  = now_us () + ETH_LINK_FAKE_AN_MS * 1000L;
+		pthread_mutex_unlock (&LinkLock);
+		/* renegotiation : link down 후 ETH_LINK_FAKE_AN_MS 뒤 link up */
+		link_update (0, 0);
+		return 0;
+	}
+	if (CtlFd < 0)
+		return -1;
+
+	switch (speed) {
+		case	10:		adv = ADVERTISED_10baseT_Full;		break;
+		case	100:	adv = ADVERTISED_100baseT_Full;		break;
+		case	1000:	adv = ADVERTISED_1000baseT_Full;	break;
+		default:
+			return -1;
+	}
+	memset (&ecmd, 0, sizeof(ecmd));
+	ecmd.cmd = ETHTOOL_GSET;
+	if (ethtool_ioctl (&ecmd)) {
+		printf ("%s : ETHTOOL_GSET error! (%s)\n", __func__, strerror(errno));
+		return -1;
+	}
+	if (!(ecmd.supported & adv)) {
+		printf ("%s : %d Mbps not supported!\n", __func__, speed);
+		return -1;
+	}
+	ecmd.cmd         = ETHTOOL_SSET;
+	ecmd.autoneg     = AUTONEG_ENABLE;
+	ecmd.advertising = adv | (ecmd.supported & ADVERTISED_Autoneg);
+	ecmd.duplex      = DUPLEX_FULL;
+	ethtool_cmd_speed_set (&ecmd, speed);
+	if (ethtool_ioctl (&ecmd)) {
+		printf ("%s : ETHTOOL_SSET error! (%s)\n", __func__, strerror(errno));
+		return -1;
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+int eth_link_wait (int speed, int timeout_ms)
+{
+	unsigned int seq = event_notify_seq (&LinkNotify);
+	struct eth_link_state state;
+	long deadline = now_us () + timeout_ms * 1000L, remain;
+
+	while (eth_link_get (&state)) {
+		if (state.up && (state.speed == speed))
+			return 1;
+		if ((remain = (deadline - now_us ()) / 1000) <= 0)
+			return 0;
+
+		if (Fake)
+			remain = (remain > FAKE_POLL_MS) ? FAKE_POLL_MS : remain;
+		else
+			remain = (remain > LINK_REFRESH_MS) ? LINK_REFRESH_MS : remain;
+
+		/* link 변경 (RTM_NEWLINK) 시 바로 wakeup, timeout 시 직접 확인 */
+		if (!event_notify_wait (&LinkNotify, &seq, remain) && !Fake)
+			link_refresh ();
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+// dhcp 완료 (RTM_NEWADDR) 시 바로 return, fake backend 는 address 를 관리하지 않으므로 timeout.
+//------------------------------------------------------------------------------
+int eth_link_wait_addr (int timeout_ms)
+{
+	unsigned int seq = event_notify_seq (&LinkNotify);
+	struct eth_link_state state;
+	long deadline = now_us () + timeout_ms * 1000L, remain;
+
+	while (eth_link_get (&state)) {
+		if (state.ip[0])
+			return 1;
+		if ((remain = (deadline - now_us ()) / 1000) <= 0)
+			return 0;
+
+		remain = (remain > LINK_REFRESH_MS) ? LINK_REFRESH_MS : remain;
+		if (!event_notify_wait (&LinkNotify, &seq, remain) && !Fake)
+			addr_refresh ();
+	}
+	/* eth_link_init 실패 */
+	usleep (timeout_ms * 1000);
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+void eth_link_inject (int up, int speed)
+{
+	link_update (up, speed);
+}
+
+//------------------------------------------------------------------------------
+static void netlink_parse (const char *buf, int len)
+{
+	const struct nlmsghdr *nlh;
+	const struct ifinfomsg *ifi;
+	const struct ifaddrmsg *ifa;
+	int up;
+
+	for (nlh = (const struct nlmsghdr *)buf; NLMSG_OK (nlh, len);
+		nlh = NLMSG_NEXT (nlh, len)) {
+		/* address 추가/삭제 : 현재 address 를 다시 읽음 (primary address) */
+		if ((nlh->nlmsg_type == RTM_NEWADDR) || (nlh->nlmsg_type == RTM_DELADDR)) {
+			ifa = (const struct ifaddrmsg *)NLMSG_DATA (nlh);
+			if (ifa->ifa_index == (unsigned int)IfIndex)
+				addr_refresh ();
+			continue;
+		}
+		if (nlh->nlmsg_type != RTM_NEWLINK)
+			continue;
+
+		ifi = (const struct ifinfomsg *)NLMSG_DATA (nlh);
+		if (ifi->ifi_index != IfIndex)
+			continue;
+
+		up = (ifi->ifi_flags & IFF_RUNNING) ? 1 : 0;
+		link_update (up, up ? ethtool_speed () : 0);
+	}
+}
+
+//------------------------------------------------------------------------------
+void *eth_link_thread (void *stop_flag)
+{
+	volatile char *stop = (volatile char *)stop_flag;
+	struct pollfd pfd;
+	char buf[NETLINK_BUF_SIZE];
+	int len;
+
+	/* fake backend : auto negotiation 완료 처리 */
+	if (Fake) {
+		while (!*stop) {
+			link_refresh ();
+			usleep (FAKE_POLL_MS * 1000);
+		}
+		return stop_flag;
+	}
+	if (NlFd < 0)
+		return stop_flag;
+
+	pfd.fd     = NlFd;
+	pfd.events = POLLIN;
+
+	while (!*stop) {
+		if (poll (&pfd, 1, NETLINK_STOP_CHECK_MS) <= 0)
+			continue;
+
+		while ((len = recv (NlFd, buf, sizeof(buf), MSG_DONTWAIT)) > 0)
+			netlink_parse (buf, len);
+
+		/* ENOBUFS : event 누락, 현재 상태로 갱신 */
+		if ((len < 0) && (errno == ENOBUFS)) {
+			link_refresh ();
+			addr_refresh ();
+		}
+	}
+	return stop_flag;
+}
+
+//------------------------------------------------------------------------------
+void eth_link_close (void)
+{
+	if (NlFd >= 0)
+		close (NlFd);
+	if (CtlFd >= 0)
+		close (CtlFd);
+	NlFd = CtlFd = -1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
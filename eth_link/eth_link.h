@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+/**
+ * @file eth_link.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief eth link speed control (SIOCETHTOOL) and link monitor (RTM_NEWLINK).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __ETH_LINK_H__
+#define __ETH_LINK_H__
+
+//------------------------------------------------------------------------------
+#include "../event_notify/event_notify.h"
+
+//------------------------------------------------------------------------------
+#define	ETH_LINK_NAME_SIZE		16
+#define	ETH_LINK_IP_SIZE		16
+/* fake backend : speed 변경 후 link up 까지 시간 (auto negotiation) */
+#define	ETH_LINK_FAKE_AN_MS		300
+
+struct eth_link_state {
+	/* 0 : link down, 1 : link up (IFF_RUNNING) */
+	int				up;
+	/* Mbps, 0 : unknown */
+	int				speed;
+	/* link up -> down 횟수 */
+	unsigned int	flaps;
+	/* ipv4 address (RTM_NEWADDR/RTM_DELADDR), "" : 없음 */
+	char			ip[ETH_LINK_IP_SIZE];
+};
+
+//------------------------------------------------------------------------------
+/* fake = 1 : PHY 없이 test (ioctl/netlink 미사용, eth_link_inject 로 link 상태 변경) */
+extern int	eth_link_init		(const char *ifname, int fake, struct event_notify *notify);
+extern int	eth_link_get		(struct eth_link_state *state);
+extern int	eth_link_set_speed	(int speed);
+/* return 1 : link up & speed 일치, 0 : timeout */
+extern int	eth_link_wait		(int speed, int timeout_ms);
+/* return 1 : ipv4 address 할당됨 (state.ip), 0 : timeout */
+extern int	eth_link_wait_addr	(int timeout_ms);
+extern void	eth_link_inject		(int up, int speed);
+extern void	*eth_link_thread	(void *stop_flag);
+extern void	eth_link_close		(void);
+
+//------------------------------------------------------------------------------
+#endif	// #define __ETH_LINK_H__
+//------------------------------------------------------------------------------
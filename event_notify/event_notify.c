@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+/**
+ * @file event_notify.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief sequence counter + condition variable wakeup (polling loop replace).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+
+#include "event_notify.h"
+
+//------------------------------------------------------------------------------
+void event_notify_init (struct event_notify *en)
+{
+	pthread_condattr_t attr;
+
+	pthread_mutex_init (&en->lock, NULL);
+
+	/* gettimeofday 변경(ntp)에 영향을 받지 않도록 monotonic clock 사용 */
+	pthread_condattr_init (&attr);
+	pthread_condattr_setclock (&attr, CLOCK_MONOTONIC);
+	pthread_cond_init (&en->cond, &attr);
+	pthread_condattr_destroy (&attr);
+
+	en->seq = 0;
+}
+
+//------------------------------------------------------------------------------
+void event_notify_post (struct event_notify *en)
+{
+	pthread_mutex_lock (&en->lock);
+	en->seq++;
+	pthread_cond_broadcast (&en->cond);
+	pthread_mutex_unlock (&en->lock);
+}
+
+//------------------------------------------------------------------------------
+unsigned int event_notify_seq (struct event_notify *en)
+{
+	unsigned int seq;
+
+	pthread_mutex_lock (&en->lock);
+	seq = en->seq;
+	pthread_mutex_unlock (&en->lock);
+	return seq;
+}
+
+//------------------------------------------------------------------------------
+int event_notify_wait (struct event_notify *en, unsigned int *seq, int timeout_ms)
+{
+	struct timespec ts;
+	int ret = 0, changed;
+
+	if (timeout_ms >= 0) {
+		clock_gettime (CLOCK_MONOTONIC, &ts);
+		ts.tv_sec  += timeout_ms / 1000;
+		ts.tv_nsec += (timeout_ms % 1000) * 1000000L;
+		if (ts.tv_nsec >= 1000000000L) {
+			ts.tv_sec++;	ts.tv_nsec -= 1000000000L;
+		}
+	}
+
+	pthread_mutex_lock (&en->lock);
+	while ((en->seq == *seq) && (ret != ETIMEDOUT)) {
+		if (timeout_ms < 0)
+			ret = pthread_cond_wait (&en->cond, &en->lock);
+		else
+			ret = pthread_cond_timedwait (&en->cond, &en->lock, &ts);
+	}
+	changed = (en->seq != *seq) ? 1 : 0;
+	*seq = en->seq;
+	pthread_mutex_unlock (&en->lock);
+
+	return changed;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,41 @@
+//------------------------------------------------------------------------------
+/**
+ * @file event_notify.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief sequence counter + condition variable wakeup (polling loop replace).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __EVENT_NOTIFY_H__
+#define __EVENT_NOTIFY_H__
+
+//------------------------------------------------------------------------------
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+/*
+	producer : event_notify_post() 호출 시 seq 증가 및 대기 thread wakeup.
+	consumer : 마지막으로 확인한 seq를 가지고 event_notify_wait() 호출.
+	           seq가 변경되었거나 timeout이 되면 return.
+*/
+//------------------------------------------------------------------------------
+struct event_notify {
+	pthread_mutex_t	lock;
+	pthread_cond_t	cond;
+	unsigned int	seq;
+};
+
+//------------------------------------------------------------------------------
+extern void			event_notify_init	(struct event_notify *en);
+extern void			event_notify_post	(struct event_notify *en);
+extern unsigned int	event_notify_seq	(struct event_notify *en);
+/* timeout_ms < 0 : wait forever, return 1 : seq changed, 0 : timeout */
+extern int			event_notify_wait	(struct event_notify *en, unsigned int *seq, int timeout_ms);
+
+//------------------------------------------------------------------------------
+#endif	// #define __EVENT_NOTIFY_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,270 @@
+//------------------------------------------------------------------------------
+/**
+ * @file fb_compose.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief offscreen compose buffer + page flip(FBIOPAN_DISPLAY) / copy present.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/fb.h>
+
+#include "fb_compose.h"
+#include "../fb_kernel/fb_kernel.h"
+
+//------------------------------------------------------------------------------
+static unsigned long now_us (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000UL + ts.tv_nsec / 1000UL;
+}
+
+//------------------------------------------------------------------------------
+static int fb_compose_alloc (struct fb_compose *fc)
+{
+	/* cache line 단위 정렬 (memcpy 최적화) */
+	if (posix_memalign ((void **)&fc->compose, 64, fc->page_size)) {
+		fc->compose = NULL;
+		return 0;
+	}
+	/* 현재 화면 내용으로 초기화 (FLIP mode의 경우 back page 포함) */
+	memcpy (fc->compose, fc->visible + fc->page * fc->page_size, fc->page_size);
+	if (fc->page_cnt == 2)
+		memcpy (fc->visible + (fc->page ^ 1) * fc->page_size, fc->compose, fc->page_size);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+// 2 page (yres_virtual >= yres * 2) 설정이 가능한 경우 FLIP mode,
+// 그렇지 않은 경우 compose buffer를 visible page로 copy 하는 COPY mode.
+//------------------------------------------------------------------------------
+int fb_compose_init (struct fb_compose *fc, const char *dev_name)
+{
+	struct fb_var_screeninfo var;
+	struct fb_fix_screeninfo fix;
+
+	memset (fc, 0, sizeof(struct fb_compose));
+
+	if ((fc->fd = open (dev_name, O_RDWR)) < 0) {
+		printf ("%s : %s open error!\n", __func__, dev_name);
+		return 0;
+	}
+	if (ioctl (fc->fd, FBIOGET_VSCREENINFO, &var) || ioctl (fc->fd, FBIOGET_FSCREENINFO, &fix)) {
+		printf ("%s : screen info error! (%s)\n", __func__, strerror(errno));
+		goto err_out;
+	}
+
+	if (var.yres_virtual < var.yres * 2) {
+		struct fb_var_screeninfo req = var;
+
+		req.yres_virtual = var.yres * 2;
+		req.yoffset      = 0;
+		if (!ioctl (fc->fd, FBIOPUT_VSCREENINFO, &req))
+			ioctl (fc->fd, FBIOGET_VSCREENINFO, &var);
+		ioctl (fc->fd, FBIOGET_FSCREENINFO, &fix);
+	}
+
+	fc->w         = var.xres;
+	fc->h         = var.yres;
+	fc->bpp       = var.bits_per_pixel;
+	fc->stride    = fix.line_length;
+	fc->page_size = (size_t)fix.line_length * var.yres;
+	fc->page_cnt  = ((var.yres_virtual >= var.yres * 2) &&
+					(fix.smem_len >= fc->page_size * 2) && fix.ypanstep) ? 2 : 1;
+	fc->page      = (fc->page_cnt == 2) ? (var.yoffset / var.yres) : 0;
+	fc->mode      = (fc->page_cnt == 2) ? eFB_COMPOSE_FLIP : eFB_COMPOSE_COPY;
+	fc->map_size  = fc->page_size * fc->page_cnt;
+
+	fc->visible = mmap (NULL, fc->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fc->fd, 0);
+	if (fc->visible == MAP_FAILED) {
+		printf ("%s : mmap error! (%s)\n", __func__, strerror(errno));
+		fc->visible = NULL;
+		goto err_out;
+	}
+	if (!fb_compose_alloc (fc))
+		goto err_out;
+
+	printf ("%s : %dx%d %dbpp, stride = %d, mode = %s\n", __func__,
+		fc->w, fc->h, fc->bpp, fc->stride, fc->mode == eFB_COMPOSE_FLIP ? "flip" : "copy");
+	return 1;
+
+err_out:
+	fb_compose_close (fc);
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+int fb_compose_init_fake (struct fb_compose *fc, const char *fname, int w, int h, int bpp)
+{
+	memset (fc, 0, sizeof(struct fb_compose));
+
+	fc->fd        = -1;
+	fc->mode      = eFB_COMPOSE_FAKE;
+	fc->w         = w;
+	fc->h         = h;
+	fc->bpp       = bpp;
+	fc->stride    = w * (bpp / 8);
+	fc->page_size = (size_t)fc->stride * h;
+	fc->page_cnt  = 1;
+	fc->map_size  = fc->page_size;
+
+	if (fname != NULL) {
+		if ((fc->fd = open (fname, O_RDWR | O_CREAT, 0644)) < 0) {
+			printf ("%s : %s open error!\n", __func__, fname);
+			return 0;
+		}
+		if (ftruncate (fc->fd, fc->map_size))
+			goto err_out;
+		fc->visible = mmap (NULL, fc->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fc->fd, 0);
+	} else {
+		fc->visible = mmap (NULL, fc->map_size, PROT_READ | PROT_WRITE,
+							MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	}
+	if (fc->visible == MAP_FAILED) {
+		fc->visible = NULL;
+		goto err_out;
+	}
+	if (fb_compose_alloc (fc))
+		return 1;
+
+err_out:
+	printf ("%s : fake framebuffer create error!\n", __func__);
+	fb_compose_close (fc);
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+static void rect_union (struct fb_rect *r, const struct fb_rect *a)
+{
+	if (!a->x1)
+		return;
+	if (!r->x1) {
+		*r = *a;
+		return;
+	}
+	if (a->x0 < r->x0)	r->x0 = a->x0;
+	if (a->y0 < r->y0)	r->y0 = a->y0;
+	if (a->x1 > r->x1)	r->x1 = a->x1;
+	if (a->y1 > r->y1)	r->y1 = a->y1;
+}
+
+//------------------------------------------------------------------------------
+void fb_compose_damage (struct fb_compose *fc, int x, int y, int w, int h)
+{
+	struct fb_rect r;
+
+	r.x0 = (x < 0) ? 0 : x;
+	r.y0 = (y < 0) ? 0 : y;
+	r.x1 = ((x + w) > fc->w) ? fc->w : (x + w);
+	r.y1 = ((y + h) > fc->h) ? fc->h : (y + h);
+
+	if ((r.x1 <= r.x0) || (r.y1 <= r.y0))
+		return;
+	rect_union (&fc->damage, &r);
+}
+
+//------------------------------------------------------------------------------
+static unsigned long copy_rect (struct fb_compose *fc, char *dst, const struct fb_rect *r)
+{
+	int bpp = fc->bpp / 8, rows = r->y1 - r->y0;
+	/* scanout mapping 은 write-combining (fake 는 일반 memory) */
+	int wc = (fc->mode != eFB_COMPOSE_FAKE);
+	size_t offset = (size_t)r->y0 * fc->stride + r->x0 * bpp;
+	size_t len    = (size_t)(r->x1 - r->x0) * bpp;
+
+	/* 전체 line 인 경우 한번에 copy */
+	if (len == (size_t)fc->stride)
+		fb_kernel_copy (dst + offset, 0, fc->compose + offset, 0, len * rows, 1, wc);
+	else
+		fb_kernel_copy (dst + offset, fc->stride, fc->compose + offset, fc->stride, len, rows, wc);
+
+	return len * rows;
+}
+
+//------------------------------------------------------------------------------
+// damage 영역을 visible page로 전달. FLIP mode에서는 back page가 2 frame 이전
+// 상태이므로 이전 frame의 damage까지 함께 copy 후 pan.
+//------------------------------------------------------------------------------
+int fb_compose_present (struct fb_compose *fc)
+{
+	struct fb_rect r = fc->damage;
+	unsigned long start, elapsed;
+
+	if (!fc->compose || !fc->damage.x1)
+		return 0;
+
+	start = now_us ();
+	if (fc->mode == eFB_COMPOSE_FLIP) {
+		struct fb_var_screeninfo var;
+		int back = fc->page ^ 1;
+
+		rect_union (&r, &fc->prev_damage);
+		fc->bytes += copy_rect (fc, fc->visible + back * fc->page_size, &r);
+
+		if (!ioctl (fc->fd, FBIOGET_VSCREENINFO, &var)) {
+			var.yoffset = back * fc->h;
+			if (!ioctl (fc->fd, FBIOPAN_DISPLAY, &var))
+				fc->page = back;
+		}
+		if (fc->page != back) {
+			/* pan 실패 : 현재 표시중인 page 로 copy 하는 COPY mode 로 전환 */
+			printf ("%s : pan error! (%s), change to copy mode\n", __func__, strerror(errno));
+			fc->mode = eFB_COMPOSE_COPY;
+			fc->bytes += copy_rect (fc, fc->visible + fc->page * fc->page_size, &r);
+		}
+	} else {
+		/* COPY mode 는 page 0 (FLIP 에서 전환된 경우 표시중인 page) */
+		fc->bytes += copy_rect (fc, fc->visible + fc->page * fc->page_size, &r);
+		if (fc->mode == eFB_COMPOSE_FAKE && fc->fd >= 0)
+			msync (fc->visible, fc->map_size, MS_ASYNC);
+	}
+	elapsed = now_us () - start;
+
+	fc->prev_damage = fc->damage;
+	memset (&fc->damage, 0, sizeof(struct fb_rect));
+
+	fc->frames++;
+	fc->total_us += elapsed;
+	if (elapsed > fc->max_us)
+		fc->max_us = elapsed;
+
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+unsigned long fb_compose_avg_us (struct fb_compose *fc)
+{
+	return fc->frames ? (fc->total_us / fc->frames) : 0;
+}
+
+//------------------------------------------------------------------------------
+void fb_compose_close (struct fb_compose *fc)
+{
+	if (fc->compose)
+		free (fc->compose);
+	if (fc->visible)
+		munmap (fc->visible, fc->map_size);
+	if (fc->fd >= 0)
+		close (fc->fd);
+
+	fc->compose = NULL;
+	fc->visible = NULL;
+	fc->fd      = -1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,66 @@
+//------------------------------------------------------------------------------
+/**
+ * @file fb_compose.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief offscreen compose buffer + page flip(FBIOPAN_DISPLAY) / copy present.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __FB_COMPOSE_H__
+#define __FB_COMPOSE_H__
+
+//------------------------------------------------------------------------------
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+enum {
+	eFB_COMPOSE_COPY = 0,	/* single page : compose -> visible copy */
+	eFB_COMPOSE_FLIP,		/* double page : compose -> back page copy + pan (pan 실패시 COPY) */
+	eFB_COMPOSE_FAKE,		/* memory/file backed fake framebuffer */
+};
+
+struct fb_rect {
+	int	x0, y0, x1, y1;		/* x1, y1 : exclusive, x1 == 0 : empty */
+};
+
+struct fb_compose {
+	int				fd;
+	int				mode;
+	int				w, h, bpp, stride;
+
+	/* visible (scanout) mapping, page_cnt * page_size */
+	char			*visible;
+	size_t			map_size;
+	size_t			page_size;
+	int				page_cnt;
+	int				page;
+
+	/* offscreen compose buffer (cacheable memory) */
+	char			*compose;
+
+	/* damage : 현재 frame, 이전 frame (flip mode에서 back page 갱신용) */
+	struct fb_rect	damage, prev_damage;
+
+	/* present cost */
+	unsigned long	frames;
+	unsigned long	bytes;
+	unsigned long	total_us;
+	unsigned long	max_us;
+};
+
+//------------------------------------------------------------------------------
+extern int		fb_compose_init		(struct fb_compose *fc, const char *dev_name);
+/* fname NULL : anonymous memory, else file backed (w * h * bpp/8 size) */
+extern int		fb_compose_init_fake(struct fb_compose *fc, const char *fname, int w, int h, int bpp);
+extern void		fb_compose_damage	(struct fb_compose *fc, int x, int y, int w, int h);
+extern int		fb_compose_present	(struct fb_compose *fc);
+extern unsigned long	fb_compose_avg_us	(struct fb_compose *fc);
+extern void		fb_compose_close	(struct fb_compose *fc);
+
+//------------------------------------------------------------------------------
+#endif	// #define __FB_COMPOSE_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+/**
+ * @file fb_kernel.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief framebuffer pixel kernels (copy, recolor) NEON/SSE2/C.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "fb_kernel.h"
+
+//------------------------------------------------------------------------------
+const char *fb_kernel_isa (void)
+{
+#if defined(__ARM_NEON)
+	return "neon";
+#elif defined(__SSE2__)
+	return "sse2";
+#else
+	return "c";
+#endif
+}
+
+//------------------------------------------------------------------------------
+static void copy_row (char *d, const char *s, int len, int wc)
+{
+	(void)wc;
+	while ((len > 0) && ((uintptr_t)d & 15)) {
+		*d++ = *s++;	len--;
+	}
+#if defined(__ARM_NEON)
+	/* glibc memcpy 의 overlap store 없이 64 byte 순차 기록 */
+	for (; len >= 64; len -= 64, d += 64, s += 64) {
+		uint8x16_t a = vld1q_u8 ((const uint8_t *)s),      b = vld1q_u8 ((const uint8_t *)s + 16);
+		uint8x16_t c = vld1q_u8 ((const uint8_t *)s + 32), e = vld1q_u8 ((const uint8_t *)s + 48);
+
+		vst1q_u8 ((uint8_t *)d,      a);	vst1q_u8 ((uint8_t *)d + 16, b);
+		vst1q_u8 ((uint8_t *)d + 32, c);	vst1q_u8 ((uint8_t *)d + 48, e);
+	}
+#elif defined(__SSE2__)
+	/* write-combining : non-temporal store (cache 오염 없음, 64 byte 단위 burst) */
+	if (wc) {
+		for (; len >= 64; len -= 64, d += 64, s += 64) {
+			__m128i a = _mm_loadu_si128 ((const __m128i *)s);
+			__m128i b = _mm_loadu_si128 ((const __m128i *)(s + 16));
+			__m128i c = _mm_loadu_si128 ((const __m128i *)(s + 32));
+			__m128i e = _mm_loadu_si128 ((const __m128i *)(s + 48));
+
+			_mm_stream_si128 ((__m128i *)d,        a);
+			_mm_stream_si128 ((__m128i *)(d + 16), b);
+			_mm_stream_si128 ((__m128i *)(d + 32), c);
+			_mm_stream_si128 ((__m128i *)(d + 48), e);
+		}
+	}
+#endif
+	memcpy (d, s, len);
+}
+
+//------------------------------------------------------------------------------
+void fb_kernel_copy (char *dst, int dst_stride, const char *src, int src_stride,
+					int row_bytes, int h, int wc)
+{
+	int y;
+
+	for (y = 0; y < h; y++, dst += dst_stride, src += src_stride)
+		copy_row (dst, src, row_bytes, wc);
+#if defined(__SSE2__) && !defined(__ARM_NEON)
+	if (wc)
+		_mm_sfence ();
+#endif
+}
+
+//------------------------------------------------------------------------------
+void fb_kernel_recolor32 (uint32_t *dst, const uint32_t *src, int cnt, uint32_t bg, uint32_t pixel)
+{
+#if defined(__ARM_NEON)
+	{
+		uint32x4_t vb = vdupq_n_u32 (bg), vp = vdupq_n_u32 (pixel);
+
+		for (; cnt >= 4; cnt -= 4, dst += 4, src += 4) {
+			uint32x4_t s = vld1q_u32 (src);
+			vst1q_u32 (dst, vbslq_u32 (vceqq_u32 (s, vb), vp, s));
+		}
+	}
+#elif defined(__SSE2__)
+	{
+		__m128i vb = _mm_set1_epi32 ((int)bg), vp = _mm_set1_epi32 ((int)pixel);
+
+		for (; cnt >= 4; cnt -= 4, dst += 4, src += 4) {
+			__m128i s = _mm_loadu_si128 ((const __m128i *)src);
+			__m128i m = _mm_cmpeq_epi32 (s, vb);
+			_mm_storeu_si128 ((__m128i *)dst,
+				_mm_or_si128 (_mm_and_si128 (m, vp), _mm_andnot_si128 (m, s)));
+		}
+	}
+#endif
+	for (; cnt > 0; cnt--, dst++, src++)
+		*dst = (*src == bg) ? pixel : *src;
+}
+
+//------------------------------------------------------------------------------
+//
+// microbenchmark
+//
+//------------------------------------------------------------------------------
+static long now_ns (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return	ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+static void bench_print (const char *name, long pixels, long ref_ns, long k_ns, int loops, int ok)
+{
+	printf ("%-10s %9ld %10.1f %10.1f %9.1fx %8.0f  %s\n", name, pixels,
+		ref_ns / 1000.0 / loops, k_ns / 1000.0 / loops,
+		k_ns ? (double)ref_ns / k_ns : 0.0,
+		k_ns ? pixels * 4.0 * loops / (k_ns / 1000.0) : 0.0,
+		ok ? "ok" : "MISMATCH");
+}
+
+//------------------------------------------------------------------------------
+// 기존 경로 : memcpy, pixel loop.
+// recolor box 크기는 fbui.cfg ID 047 (30% x 20%), copy 는 전체 화면.
+// 결과 비교는 cacheable buffer 에서 pixel loop 결과와 memcmp.
+//------------------------------------------------------------------------------
+int fb_kernel_bench (fb_info_t *pfb, int loops)
+{
+	int bw = pfb->w * 30 / 100, bh = pfb->h * 20 / 100;
+	/* pitch : line 당 pixel 수 (stride 에 padding 이 있는 경우 포함) */
+	int i, j, pitch = pfb->stride / 4, n = pitch * pfb->h, ok;
+	size_t size = (size_t)pfb->stride * pfb->h;
+	uint32_t *src, *a, *b, bg = 0x2e86c1, px = 0x00ff00;
+	long t, ref_ns, k_ns;
+
+	if (pfb->bpp != 32) {
+		printf ("%s : %d bpp not supported\n", __func__, pfb->bpp);
+		return -1;
+	}
+	src = malloc (size);	a = malloc (size);	b = malloc (size);
+	if ((src == NULL) || (a == NULL) || (b == NULL)) {
+		free (src);	free (a);	free (b);
+		return -1;
+	}
+	/* box 배경(bg) + 문자열 pixel 과 비슷한 비율 */
+	for (i = 0; i < n; i++)
+		src[i] = (((i * 2654435761u) >> 28) < 3) ? 0xffffff : bg;
+
+	printf ("fb kernel (%s) : %dx%d %dbpp, stride %d, loops %d\n",
+		fb_kernel_isa (), pfb->w, pfb->h, pfb->bpp, pfb->stride, loops);
+	printf ("%-10s %9s %10s %10s %10s %8s\n", "kernel", "pixels", "ref us", "kernel us", "speedup", "MB/s");
+
+	/* compose buffer -> framebuffer (fb_compose present) */
+	t = now_ns ();
+	for (i = 0; i < loops; i++)
+		for (j = 0; j < pfb->h; j++)
+			memcpy (pfb->data + j * pfb->stride, (char *)src + j * pfb->stride, pfb->w * 4);
+	ref_ns = now_ns () - t;
+	t = now_ns ();
+	for (i = 0; i < loops; i++)
+		fb_kernel_copy (pfb->data, pfb->stride, (char *)src, pfb->stride, pfb->w * 4, pfb->h, 1);
+	k_ns = now_ns () - t;
+	fb_kernel_copy ((char *)b, pfb->stride, (char *)src, pfb->stride, pfb->w * 4, pfb->h, 1);
+	ok = !memcmp (src, b, size);
+	bench_print ("copy", n, ref_ns, k_ns, loops, ok);
+
+	/* ui_cache recolor (box) */
+	t = now_ns ();
+	for (i = 0; i < loops; i++)
+		for (j = 0; j < bw * bh; j++)
+			a[j] = (src[j] == bg) ? px : src[j];
+	ref_ns = now_ns () - t;
+	t = now_ns ();
+	for (i = 0; i < loops; i++)
+		fb_kernel_recolor32 (b, src, bw * bh, bg, px);
+	k_ns = now_ns () - t;
+	ok = !memcmp (a, b, (size_t)bw * bh * 4);
+	bench_print ("recolor", (long)bw * bh, ref_ns, k_ns, loops, ok);
+
+	free (src);	free (a);	free (b);
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,38 @@
+//------------------------------------------------------------------------------
+/**
+ * @file fb_kernel.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief framebuffer pixel kernels (copy, recolor) NEON/SSE2/C.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __FB_KERNEL_H__
+#define __FB_KERNEL_H__
+
+//------------------------------------------------------------------------------
+#include <stdint.h>
+#include "../lib_fbui/lib_fb.h"
+
+//------------------------------------------------------------------------------
+/*
+	stride, row_bytes 는 byte 단위. pixel 은 framebuffer native 값 (32bpp).
+	store 는 16 byte 정렬 후 line 순서대로 64 byte 단위로 기록 (write-combining 버퍼를 채우도록),
+	destination 을 읽지 않고 overlap store 를 하지 않음.
+*/
+extern const char	*fb_kernel_isa		(void);
+/* wc : 1 = write-combining mapping (framebuffer), x86 은 non-temporal store 사용 */
+extern void	fb_kernel_copy		(char *dst, int dst_stride, const char *src, int src_stride,
+								int row_bytes, int h, int wc);
+/* src 중 bg 인 pixel 만 pixel 로 바꾸어 copy */
+extern void	fb_kernel_recolor32	(uint32_t *dst, const uint32_t *src, int cnt, uint32_t bg, uint32_t pixel);
+
+/* lib_fbui 기존 per-pixel 경로와 비교 (pfb : 실제 framebuffer 또는 memory framebuffer) */
+extern int	fb_kernel_bench		(fb_info_t *pfb, int loops);
+
+//------------------------------------------------------------------------------
+#endif	// #define __FB_KERNEL_H__
+//------------------------------------------------------------------------------
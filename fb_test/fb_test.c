@@ -0,0 +1,315 @@
+//------------------------------------------------------------------------------
+/**
+ * @file fb_test.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief framebuffer write/read-back bandwidth, pattern checksum and vsync timing test.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/fb.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "fb_test.h"
+#include "../fb_kernel/fb_kernel.h"
+
+//------------------------------------------------------------------------------
+/*
+	pattern 은 cacheable buffer 에 만들고 checksum 을 계산한 후 fb_kernel_copy 로 기록 (write),
+	framebuffer 에서 다시 checksum 계산 (read-back) 하여 비교.
+	test 전 화면을 저장하고 끝나면 복원하므로 test 중에만 화면 갱신을 멈추면 됨.
+*/
+//------------------------------------------------------------------------------
+#ifndef FBIO_WAITFORVSYNC
+#define	FBIO_WAITFORVSYNC	_IOW('F', 0x20, __u32)
+#endif
+
+/* 2 frame 이상 걸린 interval (thread 가 늦게 실행된 경우) 은 refresh/jitter 계산에서 제외 */
+#define	MISSED_RATIO	1.5
+
+//------------------------------------------------------------------------------
+static long now_us (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return	ts.tv_sec * 1000000L + ts.tv_nsec / 1000L;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t rotl32 (uint32_t v, int r)
+{
+	return	(v << r) | (v >> (32 - r));
+}
+
+//------------------------------------------------------------------------------
+// word i 는 lane (i % 4) 에 누적 : s1 += w, s2 += s1 (lane 별 Fletcher, 위치 변화도 검출)
+//------------------------------------------------------------------------------
+uint64_t fb_test_checksum (const char *data, int stride, int row_bytes, int h)
+{
+	uint32_t s1[4] = {0,}, s2[4] = {0,}, v;
+	int x, y, words = row_bytes / 4;
+
+	for (y = 0; y < h; y++) {
+		const char *p = data + (long)y * stride;
+
+		x = 0;
+#if defined(__ARM_NEON)
+		{
+			uint32x4_t a = vld1q_u32 (s1), b = vld1q_u32 (s2);
+
+			for (; x + 4 <= words; x += 4) {
+				a = vaddq_u32 (a, vld1q_u32 ((const uint32_t *)(p + x * 4)));
+				b = vaddq_u32 (b, a);
+			}
+			vst1q_u32 (s1, a);	vst1q_u32 (s2, b);
+		}
+#elif defined(__SSE2__)
+		{
+			__m128i a = _mm_loadu_si128 ((const __m128i *)s1), b = _mm_loadu_si128 ((const __m128i *)s2);
+
+			for (; x + 4 <= words; x += 4) {
+				a = _mm_add_epi32 (a, _mm_loadu_si128 ((const __m128i *)(p + x * 4)));
+				b = _mm_add_epi32 (b, a);
+			}
+			_mm_storeu_si128 ((__m128i *)s1, a);	_mm_storeu_si128 ((__m128i *)s2, b);
+		}
+#endif
+		for (; x < words; x++) {
+			memcpy (&v, p + x * 4, 4);
+			s1[x & 3] += v;
+			s2[x & 3] += s1[x & 3];
+		}
+	}
+	return	((uint64_t)(s2[0] ^ rotl32 (s2[1], 8) ^ rotl32 (s2[2], 16) ^ rotl32 (s2[3], 24)) << 32) |
+			(s1[0] ^ rotl32 (s1[1], 8) ^ rotl32 (s1[2], 16) ^ rotl32 (s1[3], 24));
+}
+
+//------------------------------------------------------------------------------
+// raw 32 bit word 단위 pattern (16bpp 는 word 당 2 pixel)
+//------------------------------------------------------------------------------
+static void pattern_make (uint32_t *buf, int words, int h, int kind)
+{
+	static const uint32_t bars[8] = {
+		0xFFFFFFFF, 0xFFFFFF00, 0xFF00FFFF, 0xFF00FF00,
+		0xFFFF00FF, 0xFFFF0000, 0xFF0000FF, 0xFF000000,
+	};
+	uint32_t seed = 0x1E06A5C3;
+	int x, y;
+
+	for (y = 0; y < h; y++) {
+		uint32_t *row = buf + (long)y * words;
+
+		for (x = 0; x < words; x++) {
+			switch (kind) {
+			/* color bar */
+			case 0:	row[x] = bars[(long)x * 8 / words];									break;
+			/* gray ramp (x), line 번호 (y) */
+			case 1:	row[x] = (((long)x * 256 / words) * 0x010101) | ((uint32_t)(y & 0xFF) << 24);	break;
+			/* data line 교차 checkerboard */
+			case 2:	row[x] = ((x ^ y) & 1) ? 0xAAAAAAAA : 0x55555555;					break;
+			/* xorshift random */
+			default:
+				seed ^= seed << 13;	seed ^= seed >> 17;	seed ^= seed << 5;
+				row[x] = seed;
+				break;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+int fb_test_patterns (const struct fb_test_cfg *cfg, struct fb_test_result *res)
+{
+	char *save = NULL, *src = NULL;
+	int p, row = cfg->w * (cfg->bpp / 8);
+	long t, start = now_us (), w_us = 0, r_us = 0;
+	size_t size = (size_t)row * cfg->h;
+	uint64_t expect;
+
+	memset (res, 0, sizeof(struct fb_test_result));
+	res->verdict = eFB_TEST_ERROR;
+	if (((cfg->bpp != 16) && (cfg->bpp != 32)) || (row % 4) || !cfg->h || (cfg->data == NULL)) {
+		printf ("%s : %dx%d %d bpp not supported!\n", __func__, cfg->w, cfg->h, cfg->bpp);
+		return 0;
+	}
+	if (posix_memalign ((void **)&save, 64, size) || posix_memalign ((void **)&src, 64, size)) {
+		printf ("%s : buffer alloc error!\n", __func__);
+		goto out;
+	}
+	fb_kernel_copy (save, row, cfg->data, cfg->stride, row, cfg->h, 0);
+
+	for (p = 0; p < FB_TEST_PATTERN_CNT; p++) {
+		pattern_make ((uint32_t *)src, row / 4, cfg->h, p);
+		expect = fb_test_checksum (src, row, row, cfg->h);
+
+		t = now_us ();
+		fb_kernel_copy (cfg->data, cfg->stride, src, row, row, cfg->h, cfg->wc);
+		w_us += now_us () - t;
+
+		t = now_us ();
+		if (fb_test_checksum (cfg->data, cfg->stride, row, cfg->h) != expect) {
+			res->bad_mask |= 1 << p;
+			res->bad_patterns++;
+		}
+		r_us += now_us () - t;
+	}
+	fb_kernel_copy (cfg->data, cfg->stride, save, row, row, cfg->h, cfg->wc);
+
+	res->write_mbps = w_us ? (int)((double)size * FB_TEST_PATTERN_CNT / w_us) : 0;
+	res->read_mbps  = r_us ? (int)((double)size * FB_TEST_PATTERN_CNT / r_us) : 0;
+	res->verdict    = eFB_TEST_PASS;
+out:
+	free (save);
+	free (src);
+	res->elapsed_ms += (now_us () - start) / 1000;
+	return	res->verdict == eFB_TEST_PASS;
+}
+
+//------------------------------------------------------------------------------
+static int vsync_wait (const struct fb_test_cfg *cfg, struct timespec *next)
+{
+	__u32 crtc = 0;
+
+	if (cfg->vsync_fd >= 0)
+		return	ioctl (cfg->vsync_fd, FBIO_WAITFORVSYNC, &crtc) ? 0 : 1;
+
+	/* simulation : sim_hz 주기 경계까지 대기 */
+	next->tv_nsec += 1000000000L / cfg->sim_hz;
+	if (next->tv_nsec >= 1000000000L) {
+		next->tv_sec++;
+		next->tv_nsec -= 1000000000L;
+	}
+	while (clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, next, NULL))
+		;
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+int fb_test_vsync (const struct fb_test_cfg *cfg, struct fb_test_result *res)
+{
+	long t[FB_TEST_VSYNC_CNT + 1], start = now_us (), d;
+	double nominal, sum = 0, ss = 0, mean;
+	struct timespec next;
+	int i, cnt = 0;
+
+	res->vsync = 0;
+	if ((cfg->vsync_fd < 0) && (cfg->sim_hz <= 0))
+		return 0;
+	clock_gettime (CLOCK_MONOTONIC, &next);
+
+	/* 첫 vsync 에 맞춘 후 측정 */
+	if (!vsync_wait (cfg, &next)) {
+		printf ("%s : FBIO_WAITFORVSYNC not supported\n", __func__);
+		return 0;
+	}
+	for (i = 0; i <= FB_TEST_VSYNC_CNT; i++) {
+		if (!vsync_wait (cfg, &next))
+			return 0;
+		t[i] = now_us ();
+	}
+
+	nominal = 1000000.0 / (cfg->hz > 0 ? cfg->hz : FB_TEST_HZ);
+	res->missed = 0;
+	for (i = 0; i < FB_TEST_VSYNC_CNT; i++) {
+		d = t[i + 1] - t[i];
+		if (d > nominal * MISSED_RATIO) {
+			res->missed++;
+			continue;
+		}
+		sum += d;
+		cnt++;
+	}
+	if (!cnt)
+		return 0;
+	mean = sum / cnt;
+	res->max_dev_us = 0;
+	for (i = 0; i < FB_TEST_VSYNC_CNT; i++) {
+		d = t[i + 1] - t[i];
+		if (d > nominal * MISSED_RATIO)
+			continue;
+		ss += (d - mean) * (d - mean);
+		if (fabs (d - mean) > res->max_dev_us)
+			res->max_dev_us = (int)fabs (d - mean);
+	}
+	res->vsync       = 1;
+	res->intervals   = cnt;
+	res->refresh_chz = (int)(100000000.0 / mean + 0.5);
+	res->jitter_us   = (int)(cnt > 1 ? sqrt (ss / (cnt - 1)) : 0);
+	res->elapsed_ms += (now_us () - start) / 1000;
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+int fb_test_verdict (const struct fb_test_cfg *cfg, struct fb_test_result *res)
+{
+	int hz = cfg->hz > 0 ? cfg->hz : FB_TEST_HZ;
+
+	if (res->verdict == eFB_TEST_ERROR)
+		;
+	else if (res->bad_patterns)
+		res->verdict = eFB_TEST_PATTERN;
+	else if (res->vsync && (abs (res->refresh_chz - hz * 100) > FB_TEST_HZ_TOL))
+		res->verdict = eFB_TEST_REFRESH;
+	else if (res->vsync && (res->jitter_us > FB_TEST_JITTER_US))
+		res->verdict = eFB_TEST_JITTER;
+	else
+		res->verdict = eFB_TEST_PASS;
+
+	printf ("%s : write %d MB/s, read %d MB/s, bad pattern 0x%x, ", __func__,
+		res->write_mbps, res->read_mbps, res->bad_mask);
+	if (res->vsync)
+		printf ("refresh %d.%02d Hz, jitter %d us (max %d us), missed %d\n",
+			res->refresh_chz / 100, res->refresh_chz % 100, res->jitter_us, res->max_dev_us, res->missed);
+	else
+		printf ("no vsync\n");
+	return	res->verdict == eFB_TEST_PASS;
+}
+
+//------------------------------------------------------------------------------
+void fb_test_summary (const struct fb_test_result *res, char *buf, int size)
+{
+	char hz[16];
+
+	if (res->vsync)
+		snprintf (hz, sizeof(hz), "%d.%02dHz", res->refresh_chz / 100, res->refresh_chz % 100);
+	else
+		snprintf (hz, sizeof(hz), "-Hz");
+
+	switch (res->verdict) {
+	case eFB_TEST_PASS:
+		snprintf (buf, size, "%s %d.%02d/%d.%02dGB", hz,
+			res->write_mbps / 1000, res->write_mbps % 1000 / 10,
+			res->read_mbps  / 1000, res->read_mbps  % 1000 / 10);
+		break;
+	case eFB_TEST_PATTERN:
+		snprintf (buf, size, "CKSUM %d/%d", res->bad_patterns, FB_TEST_PATTERN_CNT);
+		break;
+	case eFB_TEST_REFRESH:
+		snprintf (buf, size, "RATE %s", hz);
+		break;
+	case eFB_TEST_JITTER:
+		snprintf (buf, size, "JITTER %dus", res->jitter_us);
+		break;
+	default:
+		snprintf (buf, size, "ERROR");
+		break;
+	}
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
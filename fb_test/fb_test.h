@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+/**
+ * @file fb_test.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief framebuffer write/read-back bandwidth, pattern checksum and vsync timing test.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __FB_TEST_H__
+#define __FB_TEST_H__
+
+//------------------------------------------------------------------------------
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+/* color bar, ramp, checkerboard, random */
+#define	FB_TEST_PATTERN_CNT		4
+/* vsync interval 측정 수 (60 Hz 1 초) */
+#define	FB_TEST_VSYNC_CNT		60
+/* install 의 hdmi 설정 (refresh=60), 허용 오차 (0.01 Hz) */
+#define	FB_TEST_HZ				60
+#define	FB_TEST_HZ_TOL			50
+/* vsync interval 표준편차 최대값 (us) */
+#define	FB_TEST_JITTER_US		1000
+
+enum {
+	eFB_TEST_PASS = 0,
+	/* buffer 할당 실패, 지원하지 않는 bpp */
+	eFB_TEST_ERROR,
+	/* read-back checksum 불일치 */
+	eFB_TEST_PATTERN,
+	eFB_TEST_REFRESH,
+	eFB_TEST_JITTER,
+	eFB_TEST_VERDICT_END
+};
+
+struct fb_test_cfg {
+	/* test 영역 (scanout page), byte 단위 stride */
+	char	*data;
+	int		w, h, bpp, stride;
+	/* 1 : write-combining mapping (실제 framebuffer) */
+	int		wc;
+	/* FBIO_WAITFORVSYNC, -1 : 지원 안함 */
+	int		vsync_fd;
+	/* vsync_fd < 0 인 경우 clock 으로 만든 vsync (simulation), 0 : 측정 안함 */
+	int		sim_hz;
+	/* 기대 refresh (Hz) */
+	int		hz;
+};
+
+struct fb_test_result {
+	int			verdict;
+	/* MB/s : cacheable buffer -> framebuffer, framebuffer checksum read */
+	int			write_mbps, read_mbps;
+	/* checksum 불일치 pattern (bit mask) */
+	uint32_t	bad_mask;
+	int			bad_patterns;
+	/* 1 : vsync 측정됨 */
+	int			vsync;
+	int			intervals;
+	/* 0.01 Hz, interval 표준편차/최대 편차 (us), 2 frame 이상 걸린 interval 수 */
+	int			refresh_chz;
+	int			jitter_us, max_dev_us;
+	int			missed;
+	long		elapsed_ms;
+};
+
+//------------------------------------------------------------------------------
+/* 4 lane Fletcher (32 bit word), row_bytes 는 4 의 배수 */
+extern uint64_t	fb_test_checksum	(const char *data, int stride, int row_bytes, int h);
+/* pattern 기록 -> read-back checksum 비교 후 원래 화면 복원 (호출하는 쪽에서 화면 갱신 중지) */
+extern int		fb_test_patterns	(const struct fb_test_cfg *cfg, struct fb_test_result *res);
+/* vsync interval 측정 (FB_TEST_VSYNC_CNT), return 0 : vsync 없음 */
+extern int		fb_test_vsync		(const struct fb_test_cfg *cfg, struct fb_test_result *res);
+/* return 1 : pass */
+extern int		fb_test_verdict		(const struct fb_test_cfg *cfg, struct fb_test_result *res);
+/* response_str 용 (예 "60.00Hz 1.84/0.31GB", "CKSUM 1/4") */
+extern void		fb_test_summary		(const struct fb_test_result *res, char *buf, int size);
+
+//------------------------------------------------------------------------------
+#endif	// #define __FB_TEST_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,481 @@
+//------------------------------------------------------------------------------
+/**
+ * @file hw_sim.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-M1 jig hardware simulation backend (fake sysfs, uinput, block image).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#define _XOPEN_SOURCE 700
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+#include <limits.h>
+#include <ftw.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <linux/loop.h>
+#include <linux/uinput.h>
+#include <dirent.h>
+
+#include "hw_sim.h"
+#include "../usb_hotplug/usb_hotplug.h"
+
+//------------------------------------------------------------------------------
+struct sim_block {
+	char	name[32];
+	/* loop device fd (LO_FLAGS_AUTOCLEAR, close 시 자동 해제), -1 : file */
+	int		loop_fd;
+};
+
+static char				SimRoot[HW_SIM_PATH_SIZE / 2] = HW_SIM_ROOT;
+static struct sim_block	Blocks[HW_SIM_BLOCK_MAX];
+static int				BlockCnt = 0;
+static pthread_mutex_t	SimLock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned int		UuidSeq = 0;
+
+//------------------------------------------------------------------------------
+const char *hw_sim_root (void)
+{
+	return SimRoot;
+}
+
+//------------------------------------------------------------------------------
+const char *hw_sim_path (const char *sub, char *path, int size)
+{
+	snprintf (path, size, "%s/%s", SimRoot, sub);
+	return path;
+}
+
+//------------------------------------------------------------------------------
+static int mkdir_p (const char *dir)
+{
+	char path[HW_SIM_PATH_SIZE], *p;
+
+	snprintf (path, sizeof(path), "%s", dir);
+	for (p = path + 1; *p; p++) {
+		if (*p != '/')
+			continue;
+		*p = 0;
+		if (mkdir (path, 0755) && (errno != EEXIST))
+			return -1;
+		*p = '/';
+	}
+	return	(mkdir (path, 0755) && (errno != EEXIST)) ? -1 : 0;
+}
+
+//------------------------------------------------------------------------------
+static int write_file (const char *fname, const char *str)
+{
+	int fd, len = strlen (str);
+
+	if ((fd = open (fname, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)) < 0)
+		return -1;
+	if (write (fd, str, len) != len)
+		len = -1;
+	close (fd);
+	return	(len < 0) ? -1 : 0;
+}
+
+//------------------------------------------------------------------------------
+static int remove_entry (const char *path, const struct stat *st, int flag, struct FTW *ftw)
+{
+	(void)st;	(void)flag;	(void)ftw;
+	if (remove (path) && (errno != ENOENT))
+		printf ("%s : %s (%s)\n", __func__, path, strerror (errno));
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+// simulation 전용 directory 확인
+// '/' 와 최상위 directory (/tmp, /dev ...) 는 사용 안함, 이미 있는 directory 는
+// 비어있거나 hw_sim 이 만든 표시 file (HW_SIM_MARK) 이 있는 경우만 사용.
+//------------------------------------------------------------------------------
+static int root_check (const char *root)
+{
+	char real[PATH_MAX], path[HW_SIM_PATH_SIZE];
+	struct dirent *de;
+	DIR *dir;
+	int used = 0;
+
+	if ((root == NULL) || !root[0] || (mkdir_p (root)) || (realpath (root, real) == NULL))
+		return 0;
+	if ((real[0] != '/') || (strchr (real + 1, '/') == NULL) || (strlen (real) >= sizeof(SimRoot))) {
+		printf ("%s : %s is not a dedicated simulation directory\n", __func__, real);
+		return 0;
+	}
+	memcpy (SimRoot, real, strlen (real) + 1);
+	if (access (hw_sim_path (HW_SIM_MARK, path, sizeof(path)), F_OK) == 0)
+		return 1;
+
+	if ((dir = opendir (real)) == NULL)
+		return 0;
+	while ((de = readdir (dir)) != NULL)
+		if (strcmp (de->d_name, ".") && strcmp (de->d_name, ".."))
+			used = 1;
+	closedir (dir);
+	if (used) {
+		printf ("%s : %s is not empty and not a simulation root\n", __func__, real);
+		return 0;
+	}
+	return	write_file (path, "m1-server hw_sim\n") ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+// online cpu 별 고정 clock, thermal zone 1 개 (cpu_test 의 cpufreq/thermal sample 용)
+//------------------------------------------------------------------------------
+static int cpu_sysfs_init (void)
+{
+	char path[HW_SIM_PATH_SIZE], sub[96];
+	long i, cpus = sysconf (_SC_NPROCESSORS_ONLN);
+
+	for (i = 0; i < cpus; i++) {
+		snprintf (sub, sizeof(sub), "sys/devices/system/cpu/cpu%ld/cpufreq", i);
+		if (mkdir_p (hw_sim_path (sub, path, sizeof(path))))
+			return -1;
+		strncat (path, "/scaling_cur_freq", sizeof(path) - strlen (path) - 1);
+		if (write_file (path, "1992000\n"))
+			return -1;
+	}
+	if (mkdir_p (hw_sim_path ("sys/class/thermal/thermal_zone0", path, sizeof(path))))
+		return -1;
+	if (write_file (hw_sim_path ("sys/class/thermal/thermal_zone0/type", path, sizeof(path)), "cpu-thermal\n"))
+		return -1;
+	return write_file (hw_sim_path ("sys/class/thermal/thermal_zone0/temp", path, sizeof(path)), "45000\n");
+}
+
+//------------------------------------------------------------------------------
+int hw_sim_init (const char *root)
+{
+	const char *dirs[] = { "sys/bus/usb/devices", "sys/block", "sys/devices", "dev" };
+	/* 이전 실행 결과 (usb 연결 상태, efuse image), hw_sim 이 만든 것만 삭제 */
+	const char *trees[] = { "sys", "dev" }, *files[] = { "efuse.img", "efuse.img.uuid" };
+	char path[HW_SIM_PATH_SIZE];
+	unsigned int i;
+
+	if (!root_check (root != NULL ? root : HW_SIM_ROOT))
+		return 0;
+
+	/* symbolic link 를 따라가지 않고 (FTW_PHYS) 다른 file system 으로 넘어가지 않음 (FTW_MOUNT) */
+	for (i = 0; i < sizeof(trees) / sizeof(trees[0]); i++)
+		if (nftw (hw_sim_path (trees[i], path, sizeof(path)), remove_entry, 16,
+			FTW_DEPTH | FTW_PHYS | FTW_MOUNT) && (errno != ENOENT))
+			printf ("%s : %s clean error (%s)\n", __func__, path, strerror (errno));
+	for (i = 0; i < sizeof(files) / sizeof(files[0]); i++)
+		unlink (hw_sim_path (files[i], path, sizeof(path)));
+
+	for (i = 0; i < sizeof(dirs) / sizeof(dirs[0]); i++) {
+		if (mkdir_p (hw_sim_path (dirs[i], path, sizeof(path)))) {
+			printf ("%s : %s create error (%s)\n", __func__, path, strerror (errno));
+			return 0;
+		}
+	}
+	if (cpu_sysfs_init ()) {
+		printf ("%s : cpu sysfs create error (%s)\n", __func__, strerror (errno));
+		return 0;
+	}
+	memset (Blocks, 0, sizeof(Blocks));
+	BlockCnt = 0;
+	UuidSeq  = (unsigned int)time (NULL);
+	printf ("%s : root = %s\n", __func__, SimRoot);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+void hw_sim_close (void)
+{
+	int i;
+
+	pthread_mutex_lock (&SimLock);
+	for (i = 0; i < BlockCnt; i++) {
+		if (Blocks[i].loop_fd >= 0)
+			close (Blocks[i].loop_fd);
+		Blocks[i].loop_fd = -1;
+	}
+	BlockCnt = 0;
+	pthread_mutex_unlock (&SimLock);
+}
+
+//------------------------------------------------------------------------------
+//
+// memory framebuffer
+//
+//------------------------------------------------------------------------------
+fb_info_t *hw_sim_fb_init (int w, int h, int bpp)
+{
+	fb_info_t *pfb;
+
+	if ((pfb = calloc (1, sizeof(fb_info_t))) == NULL)
+		return NULL;
+
+	pfb->fd     = -1;
+	pfb->w      = w;
+	pfb->h      = h;
+	pfb->bpp    = bpp;
+	pfb->stride = w * (bpp / 8);
+	if ((pfb->data = calloc (1, pfb->stride * h)) == NULL) {
+		free (pfb);
+		return NULL;
+	}
+	pfb->base = pfb->data;
+	return pfb;
+}
+
+//------------------------------------------------------------------------------
+void hw_sim_fb_close (fb_info_t *pfb)
+{
+	if (pfb == NULL)
+		return;
+	free (pfb->base);
+	free (pfb);
+}
+
+//------------------------------------------------------------------------------
+//
+// block device (image file, loop device)
+//
+//------------------------------------------------------------------------------
+static int loop_attach (const char *image, char *dev, int dev_size)
+{
+	struct loop_info64 info;
+	int ctl, num, fd, lfd;
+
+	if ((ctl = open ("/dev/loop-control", O_RDWR | O_CLOEXEC)) < 0)
+		return -1;
+	num = ioctl (ctl, LOOP_CTL_GET_FREE);
+	close (ctl);
+	if (num < 0)
+		return -1;
+
+	snprintf (dev, dev_size, "/dev/loop%d", num);
+	if ((lfd = open (dev, O_RDWR | O_CLOEXEC)) < 0)
+		return -1;
+	if ((fd = open (image, O_RDWR | O_CLOEXEC)) < 0) {
+		close (lfd);
+		return -1;
+	}
+	if (ioctl (lfd, LOOP_SET_FD, fd)) {
+		close (fd);
+		close (lfd);
+		return -1;
+	}
+	close (fd);
+
+	memset (&info, 0, sizeof(info));
+	info.lo_flags = LO_FLAGS_AUTOCLEAR;
+	snprintf ((char *)info.lo_file_name, sizeof(info.lo_file_name), "%.*s",
+		(int)sizeof(info.lo_file_name) - 1, image);
+	ioctl (lfd, LOOP_SET_STATUS64, &info);
+	return lfd;
+}
+
+//------------------------------------------------------------------------------
+int hw_sim_blockdev (const char *name, int size_mb, char *dev, int dev_size)
+{
+	char image[HW_SIM_PATH_SIZE], sub[64], *buf;
+	int fd, i, lfd = -1, ret = 0;
+
+	snprintf (sub, sizeof(sub), "dev/%s", name);
+	hw_sim_path (sub, image, sizeof(image));
+
+	if ((buf = malloc (1024 * 1024)) == NULL)
+		return -1;
+	/* page 단위로 다른 data (storage read 가 zero page 로 처리되지 않도록) */
+	for (i = 0; i < 1024 * 1024; i++)
+		buf[i] = (char)(i * 7 + (i >> 12));
+
+	if ((fd = open (image, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)) < 0) {
+		free (buf);
+		return -1;
+	}
+	for (i = 0; i < size_mb; i++) {
+		if (write (fd, buf, 1024 * 1024) != 1024 * 1024) {
+			ret = -1;
+			break;
+		}
+	}
+	close (fd);
+	free (buf);
+	if (ret)
+		return -1;
+
+	pthread_mutex_lock (&SimLock);
+	if (BlockCnt < HW_SIM_BLOCK_MAX) {
+		if ((lfd = loop_attach (image, dev, dev_size)) >= 0)
+			ret = 1;
+		snprintf (Blocks[BlockCnt].name, sizeof(Blocks[BlockCnt].name), "%s", name);
+		Blocks[BlockCnt++].loop_fd = lfd;
+	}
+	pthread_mutex_unlock (&SimLock);
+
+	if (lfd < 0)
+		snprintf (dev, dev_size, "%s", image);
+	return ret;
+}
+
+//------------------------------------------------------------------------------
+//
+// usb mass storage (fake sysfs + uevent)
+//
+//------------------------------------------------------------------------------
+static void usb_uevent (const char *action, const char *devpath, const char *subsystem)
+{
+	char msg[512];
+	int len;
+
+	/* "add@/devices/...\0ACTION=add\0DEVPATH=...\0SUBSYSTEM=usb\0" */
+	len  = snprintf (msg, sizeof(msg), "%s@%s", action, devpath) + 1;
+	len += snprintf (&msg[len], sizeof(msg) - len, "ACTION=%s", action) + 1;
+	len += snprintf (&msg[len], sizeof(msg) - len, "DEVPATH=%s", devpath) + 1;
+	len += snprintf (&msg[len], sizeof(msg) - len, "SUBSYSTEM=%s", subsystem) + 1;
+	usb_hotplug_uevent (msg, len);
+}
+
+//------------------------------------------------------------------------------
+int hw_sim_usb_plug (const char *port, int speed, const char *block, int size_mb)
+{
+	char path[HW_SIM_PATH_SIZE], sub[128], link[128], dev[HW_SIM_PATH_SIZE], str[16];
+
+	/* usb device : {root}/sys/bus/usb/devices/{port}/speed */
+	snprintf (sub, sizeof(sub), "sys/bus/usb/devices/%s", port);
+	if (mkdir_p (hw_sim_path (sub, path, sizeof(path))))
+		return -1;
+	snprintf (sub, sizeof(sub), "sys/bus/usb/devices/%s/speed", port);
+	snprintf (str, sizeof(str), "%d\n", speed);
+	if (write_file (hw_sim_path (sub, path, sizeof(path)), str))
+		return -1;
+	snprintf (sub, sizeof(sub), "/devices/platform/usb/%s", port);
+	usb_uevent ("add", sub, "usb");
+
+	/* mass storage : {root}/dev/{block} + {root}/sys/block/{block} link */
+	if (block == NULL)
+		return 0;
+	if (hw_sim_blockdev (block, size_mb, dev, sizeof(dev)) < 0)
+		return -1;
+	snprintf (link, sizeof(link), "../devices/platform/usb/%s/%s:1.0/host0/block/%s",
+		port, port, block);
+	snprintf (sub, sizeof(sub), "sys/block/%s", block);
+	hw_sim_path (sub, path, sizeof(path));
+	unlink (path);
+	if (symlink (link, path))
+		return -1;
+	snprintf (sub, sizeof(sub), "/devices/platform/usb/%s/%s:1.0/host0/block/%s", port, port, block);
+	usb_uevent ("add", sub, "block");
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+int hw_sim_usb_unplug (const char *port, const char *block)
+{
+	char path[HW_SIM_PATH_SIZE], sub[128];
+
+	if (block != NULL) {
+		snprintf (sub, sizeof(sub), "sys/block/%s", block);
+		unlink (hw_sim_path (sub, path, sizeof(path)));
+		snprintf (sub, sizeof(sub), "dev/%s", block);
+		unlink (hw_sim_path (sub, path, sizeof(path)));
+	}
+	snprintf (sub, sizeof(sub), "sys/bus/usb/devices/%s/speed", port);
+	unlink (hw_sim_path (sub, path, sizeof(path)));
+	snprintf (sub, sizeof(sub), "sys/bus/usb/devices/%s", port);
+	rmdir (hw_sim_path (sub, path, sizeof(path)));
+
+	snprintf (sub, sizeof(sub), "/devices/platform/usb/%s", port);
+	usb_uevent ("remove", sub, "usb");
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+//
+// uinput virtual input device (IR remote, headphone jack)
+//
+//------------------------------------------------------------------------------
+int hw_sim_input_create (const char *name, int ev_type, const int *codes, int code_cnt)
+{
+	struct uinput_setup setup;
+	int fd, i, ret = 0;
+
+	if ((fd = open ("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC)) < 0) {
+		printf ("%s : /dev/uinput open error (%s)\n", __func__, strerror (errno));
+		return -1;
+	}
+	ret |= ioctl (fd, UI_SET_EVBIT, ev_type);
+	for (i = 0; i < code_cnt; i++)
+		ret |= ioctl (fd, (ev_type == EV_SW) ? UI_SET_SWBIT : UI_SET_KEYBIT, codes[i]);
+
+	memset (&setup, 0, sizeof(setup));
+	setup.id.bustype = BUS_VIRTUAL;
+	snprintf (setup.name, sizeof(setup.name), "%s", name);
+	ret |= ioctl (fd, UI_DEV_SETUP, &setup);
+	ret |= ioctl (fd, UI_DEV_CREATE);
+	if (ret) {
+		printf ("%s : %s create error (%s)\n", __func__, name, strerror (errno));
+		close (fd);
+		return -1;
+	}
+	return fd;
+}
+
+//------------------------------------------------------------------------------
+int hw_sim_input_emit (int fd, int type, int code, int value)
+{
+	struct input_event ev[2];
+
+	memset (ev, 0, sizeof(ev));
+	ev[0].type  = type;
+	ev[0].code  = code;
+	ev[0].value = value;
+	ev[1].type  = EV_SYN;
+	ev[1].code  = SYN_REPORT;
+
+	return	(write (fd, ev, sizeof(ev)) == sizeof(ev)) ? 0 : -1;
+}
+
+//------------------------------------------------------------------------------
+void hw_sim_input_close (int fd)
+{
+	if (fd < 0)
+		return;
+	ioctl (fd, UI_DEV_DESTROY);
+	close (fd);
+}
+
+//------------------------------------------------------------------------------
+//
+// mac/nlp server stand-in
+//
+//------------------------------------------------------------------------------
+int hw_sim_mac_uuid (char *uuid, int size)
+{
+	unsigned int seq = __sync_add_and_fetch (&UuidSeq, 1);
+
+	snprintf (uuid, size, "%08x-%04x-%04x-%04x-001e06%06x",
+		seq * 2654435761u, seq & 0xffff, 0x4000 | (seq & 0xfff), 0x8000 | (seq & 0x3fff),
+		seq & 0xffffff);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+int hw_sim_nlp_write (int mtype, const char *msg)
+{
+	char fname[HW_SIM_PATH_SIZE];
+	FILE *fp;
+
+	if ((fp = fopen (hw_sim_path ("nlp.log", fname, sizeof(fname)), "a")) == NULL)
+		return 0;
+	fprintf (fp, "%ld type=%d msg=%s\n", (long)time (NULL), mtype, msg);
+	fclose (fp);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
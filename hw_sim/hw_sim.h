@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+/**
+ * @file hw_sim.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief ODROID-M1 jig hardware simulation backend (fake sysfs, uinput, block image).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __HW_SIM_H__
+#define __HW_SIM_H__
+
+//------------------------------------------------------------------------------
+#include "../lib_fbui/lib_fb.h"
+
+//------------------------------------------------------------------------------
+#define	HW_SIM_ROOT				"/tmp/m1-sim"
+/* simulation root 표시 file (hw_sim_init 은 표시가 있거나 비어있는 directory 만 정리) */
+#define	HW_SIM_MARK				".m1-sim"
+#define	HW_SIM_PATH_SIZE		256
+#define	HW_SIM_BLOCK_MAX		16
+
+/*
+	{root}/sys/bus/usb/devices/{port}/speed		usb_hotplug sysfs root = {root}/sys
+	{root}/sys/block/{block} -> ../devices/.../{port}/.../block/{block}
+	{root}/sys/devices/system/cpu/cpu{n}/cpufreq/scaling_cur_freq	cpu_test (sysfs_attr root = {root}/sys)
+	{root}/sys/class/thermal/thermal_zone0/{type,temp}
+	{root}/dev/{block}							block device image (loop 지원시 /dev/loopN)
+	{root}/efuse.img, {root}/efuse.img.uuid		efuse simulator backend
+	{root}/nlp.log								nlp server stand-in (label print 메시지)
+	{root}/fb.raw								fb_compose fake scanout page (w * h * bpp/8)
+*/
+//------------------------------------------------------------------------------
+/*
+	root 아래 기존 simulation file 삭제 후 directory 생성.
+	root 가 '/', 최상위 directory, 다른 file 이 있는 directory 인 경우 return 0
+*/
+extern int			hw_sim_init			(const char *root);
+extern const char	*hw_sim_root		(void);
+/* {root}/{sub} path */
+extern const char	*hw_sim_path		(const char *sub, char *path, int size);
+extern void			hw_sim_close		(void);
+
+/* memory framebuffer (lib_fbui fb_info_t, fd = -1) */
+extern fb_info_t	*hw_sim_fb_init		(int w, int h, int bpp);
+extern void			hw_sim_fb_close		(fb_info_t *pfb);
+
+/*
+	block device image (size_mb) 생성, loop device 로 연결 가능한 경우 dev = /dev/loopN,
+	아닌 경우 dev = image file. return 1 : loop device, 0 : file, -1 : error
+*/
+extern int			hw_sim_blockdev		(const char *name, int size_mb, char *dev, int dev_size);
+
+/* usb mass storage 연결/제거 (fake sysfs 갱신 후 usb_hotplug 에 uevent 전달) */
+extern int			hw_sim_usb_plug		(const char *port, int speed, const char *block, int size_mb);
+extern int			hw_sim_usb_unplug	(const char *port, const char *block);
+
+/* uinput virtual input device, return fd (-1 : uinput 미지원) */
+extern int			hw_sim_input_create	(const char *name, int ev_type, const int *codes, int code_cnt);
+extern int			hw_sim_input_emit	(int fd, int type, int code, int value);
+extern void			hw_sim_input_close	(int fd);
+
+/* mac server stand-in : "xxxxxxxx-xxxx-xxxx-xxxx-001e06xxxxxx" */
+extern int			hw_sim_mac_uuid		(char *uuid, int size);
+/* nlp server stand-in : label print 메시지 기록, return 1 */
+extern int			hw_sim_nlp_write	(int mtype, const char *msg);
+
+//------------------------------------------------------------------------------
+#endif	// #define __HW_SIM_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+/**
+ * @file input_reactor.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief epoll based evdev input reactor (find device by sysfs name).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <linux/input.h>
+
+#include "input_reactor.h"
+
+//------------------------------------------------------------------------------
+struct input_dev {
+	int				fd;
+	char			name[64];
+	input_handler_t	handler;
+	void			*arg;
+};
+
+static struct input_dev	InputDev[INPUT_REACTOR_DEV_MAX];
+static int				InputDevCnt = 0;
+static int				EpollFd = -1;
+static long				MaxLatency = 0;
+
+static char	SysfsInputDir[128] = "/sys/class/input";
+static char	DevInputDir[128]   = "/dev/input";
+
+//------------------------------------------------------------------------------
+int input_reactor_init (const char *sysfs_input_dir, const char *dev_input_dir)
+{
+	if (sysfs_input_dir != NULL)
+		snprintf (SysfsInputDir, sizeof(SysfsInputDir), "%s", sysfs_input_dir);
+	if (dev_input_dir != NULL)
+		snprintf (DevInputDir, sizeof(DevInputDir), "%s", dev_input_dir);
+
+	memset (InputDev, 0, sizeof(InputDev));
+	InputDevCnt = 0;
+
+	if ((EpollFd = epoll_create1 (EPOLL_CLOEXEC)) < 0) {
+		printf ("%s : epoll create error! (%s)\n", __func__, strerror(errno));
+		return 0;
+	}
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+// /sys/class/input/eventX/device/name 을 비교하여 /dev/input/eventX 를 찾음.
+// event 번호는 부팅 시 enumeration 순서에 따라 바뀔 수 있으므로 이름으로 찾는다.
+//------------------------------------------------------------------------------
+int input_reactor_find (const char *dev_name, char *node, int node_size)
+{
+	DIR *dir;
+	struct dirent *ent;
+	char fname[512], name[128];
+	int found = 0;
+
+	if ((dir = opendir (SysfsInputDir)) == NULL)
+		return 0;
+
+	while (!found && ((ent = readdir (dir)) != NULL)) {
+		FILE *fp;
+
+		if (strncmp (ent->d_name, "event", strlen("event")))
+			continue;
+
+		snprintf (fname, sizeof(fname), "%s/%s/device/name", SysfsInputDir, ent->d_name);
+		if ((fp = fopen (fname, "r")) == NULL)
+			continue;
+
+		memset (name, 0, sizeof(name));
+		if (fgets (name, sizeof(name), fp) != NULL) {
+			name[strcspn (name, "\n")] = 0;
+			if (!strcmp (name, dev_name)) {
+				snprintf (node, node_size, "%s/%s", DevInputDir, ent->d_name);
+				found = 1;
+			}
+		}
+		fclose (fp);
+	}
+	closedir (dir);
+	return found;
+}
+
+//------------------------------------------------------------------------------
+int input_reactor_add (const char *dev_name, input_handler_t handler, void *arg)
+{
+	struct input_dev *pdev;
+	struct epoll_event ev;
+	char node[128];
+	int clk = CLOCK_MONOTONIC;
+
+	if ((EpollFd < 0) || (InputDevCnt >= INPUT_REACTOR_DEV_MAX))
+		return 0;
+
+	if (!input_reactor_find (dev_name, node, sizeof(node))) {
+		printf ("%s : input device not found! (%s)\n", __func__, dev_name);
+		return 0;
+	}
+
+	pdev = &InputDev[InputDevCnt];
+	if ((pdev->fd = open (node, O_RDONLY | O_NONBLOCK | O_CLOEXEC)) < 0) {
+		printf ("%s : %s open error!\n", __func__, node);
+		return 0;
+	}
+	/* latency 계산을 위하여 event timestamp를 monotonic clock 으로 설정 */
+	ioctl (pdev->fd, EVIOCSCLOCKID, &clk);
+
+	snprintf (pdev->name, sizeof(pdev->name), "%s", dev_name);
+	pdev->handler = handler;
+	pdev->arg     = arg;
+
+	memset (&ev, 0, sizeof(ev));
+	ev.events   = EPOLLIN;
+	ev.data.ptr = pdev;
+	if (epoll_ctl (EpollFd, EPOLL_CTL_ADD, pdev->fd, &ev) < 0) {
+		printf ("%s : epoll add error! (%s)\n", __func__, strerror(errno));
+		close (pdev->fd);
+		return 0;
+	}
+	InputDevCnt++;
+	printf ("%s : %s = %s, fd = %d\n", __func__, dev_name, node, pdev->fd);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+long input_reactor_latency_us (const struct input_event *ev)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	return	(now.tv_sec - ev->input_event_sec) * 1000000L +
+			(now.tv_nsec / 1000 - ev->input_event_usec);
+}
+
+//------------------------------------------------------------------------------
+long input_reactor_max_latency_us (void)
+{
+	return MaxLatency;
+}
+
+//------------------------------------------------------------------------------
+static void input_reactor_dispatch (struct input_dev *pdev)
+{
+	struct input_event events[INPUT_REACTOR_EVENT_BATCH];
+	int len, i, cnt;
+
+	/* non-block fd 이므로 queue가 빌 때까지 batch 단위로 읽음 */
+	while ((len = read (pdev->fd, events, sizeof(events))) > 0) {
+		cnt = len / sizeof(struct input_event);
+		for (i = 0; i < cnt; i++) {
+			long latency;
+
+			if ((events[i].type != EV_KEY) && (events[i].type != EV_SW))
+				continue;
+
+			pdev->handler (&events[i], pdev->arg);
+
+			if ((latency = input_reactor_latency_us (&events[i])) > MaxLatency)
+				MaxLatency = latency;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// stop_flag (char *) 가 set 되면 thread 종료.
+// wakeup은 event 발생시에만 하고 stop 확인을 위하여 1초 마다 timeout.
+//------------------------------------------------------------------------------
+#define	INPUT_REACTOR_STOP_CHECK_MS	1000
+
+void *input_reactor_thread (void *stop_flag)
+{
+	volatile char *stop = (volatile char *)stop_flag;
+	struct epoll_event events[INPUT_REACTOR_DEV_MAX];
+	int nfds, i;
+
+	while (!*stop) {
+		nfds = epoll_wait (EpollFd, events, INPUT_REACTOR_DEV_MAX,
+							INPUT_REACTOR_STOP_CHECK_MS);
+		if ((nfds < 0) && (errno != EINTR)) {
+			printf ("%s : epoll wait error! (%s)\n", __func__, strerror(errno));
+			break;
+		}
+		for (i = 0; i < nfds; i++)
+			input_reactor_dispatch ((struct input_dev *)events[i].data.ptr);
+	}
+	return stop_flag;
+}
+
+//------------------------------------------------------------------------------
+void input_reactor_close (void)
+{
+	int i;
+
+	for (i = 0; i < InputDevCnt; i++)
+		close (InputDev[i].fd);
+	InputDevCnt = 0;
+
+	if (EpollFd >= 0)
+		close (EpollFd);
+	EpollFd = -1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,40 @@
+//------------------------------------------------------------------------------
+/**
+ * @file input_reactor.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief epoll based evdev input reactor (find device by sysfs name).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __INPUT_REACTOR_H__
+#define __INPUT_REACTOR_H__
+
+//------------------------------------------------------------------------------
+#include <linux/input.h>
+
+//------------------------------------------------------------------------------
+#define	INPUT_REACTOR_DEV_MAX		8
+/* 1회 read syscall로 가져오는 최대 event 수 */
+#define	INPUT_REACTOR_EVENT_BATCH	64
+
+//------------------------------------------------------------------------------
+/* ev->time : kernel event timestamp (CLOCK_MONOTONIC) */
+typedef void (*input_handler_t) (const struct input_event *ev, void *arg);
+
+//------------------------------------------------------------------------------
+/* NULL : default path (/sys/class/input, /dev/input) */
+extern int		input_reactor_init		(const char *sysfs_input_dir, const char *dev_input_dir);
+extern int		input_reactor_find		(const char *dev_name, char *node, int node_size);
+extern int		input_reactor_add		(const char *dev_name, input_handler_t handler, void *arg);
+extern long		input_reactor_latency_us(const struct input_event *ev);
+extern long		input_reactor_max_latency_us	(void);
+extern void		*input_reactor_thread	(void *stop_flag);
+extern void		input_reactor_close		(void);
+
+//------------------------------------------------------------------------------
+#endif	// #define __INPUT_REACTOR_H__
+//------------------------------------------------------------------------------
@@ -6,6 +6,10 @@
 # mixer control path
 # amixer -c 1
 
+# m1-server 의 AUDIO (loopback) test 는 같은 device (hw:1,0) 를 사용하므로
+# test 중에는 m1-audio.service 를 stop 하고 test 후 다시 start 함.
+# service 없이 직접 실행한 경우 AUDIO test 는 device busy 로 fail 됨.
+
 # mixer control path set
 amixer -c 1 sset 'Playback Path' 'HP'
 
@@ -28,6 +28,7 @@
 #include <sys/ioctl.h>
 #include <sys/sysinfo.h>
 #include <sys/mman.h>
+#include <sys/resource.h>
 #include <linux/fb.h>
 #include <linux/input.h>
 #include <getopt.h>
@@ -41,6 +42,31 @@
 #include "lib_fbui/lib_fb.h"
 #include "lib_fbui/lib_ui.h"
 
+//------------------------------------------------------------------------------
+// in-tree module header include
+//------------------------------------------------------------------------------
+#include "event_notify/event_notify.h"
+#include "input_reactor/input_reactor.h"
+#include "usb_hotplug/usb_hotplug.h"
+#include "ui_dirty/ui_dirty.h"
+#include "ui_cache/ui_cache.h"
+#include "fb_kernel/fb_kernel.h"
+#include "fb_compose/fb_compose.h"
+#include "test_sched/test_sched.h"
+#include "net_perf/net_perf.h"
+#include "eth_link/eth_link.h"
+#include "efuse/efuse.h"
+#include "storage_bench/storage_bench.h"
+#include "report_queue/report_queue.h"
+#include "result_log/result_log.h"
+#include "trace/trace.h"
+#include "hw_sim/hw_sim.h"
+#include "audio_test/audio_test.h"
+#include "mem_test/mem_test.h"
+#include "fb_test/fb_test.h"
+#include "cpu_test/cpu_test.h"
+#include "sysfs_attr/sysfs_attr.h"
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 #define	RUN_BOX_ON	RGB_TO_UINT(204, 204, 0)
@@ -51,6 +77,8 @@ enum {
 	eSTATUS_RUNNING,
 	eSTATUS_FINISH,
 	eSTATUS_STOP,
+	/* test registry(m1-test.cfg)에서 disable 된 item */
+	eSTATUS_SKIP,
 };
 
 //------------------------------------------------------------------------------
@@ -60,6 +88,7 @@ enum {
 	eUI_IPERF_SPEED = 0,
 	eUI_EFUSE_UUIDD,
 	eUI_BOARD_MEM,
+	eUI_CPU_LOAD,
 	eUI_FB_SIZE,
 	eUI_EMMC_SPEED,
 	eUI_SATA_SPEED,
@@ -72,6 +101,7 @@ enum {
 	eUI_ETH_ORANGE,
 	eUI_HP_IN,
 	eUI_HP_OUT,
+	eUI_AUDIO_LOOP,
 	eUI_SPIBT_DN,
 	eUI_SPIBT_UP,
 	eUI_IR_INPUT,
@@ -90,15 +120,77 @@ char BoardIP    [20] = {0,};
 char NlpServerIP[20] = {0,};
 char MacStr     [20] = {0,};
 char EmergencyStop = 0;
+/* report queue thread stop (EmergencyStop 이후에도 결과 전송) */
+char ReportStop = 0;
+
+/* board 1회 test 시작 시간 (cycle time 측정) */
+struct timespec CycleStart;
+
+//------------------------------------------------------------------------------
+static long cycle_time_ms (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return	(ts.tv_sec - CycleStart.tv_sec) * 1000L +
+		(ts.tv_nsec - CycleStart.tv_nsec) / 1000000L;
+}
+
+/* item status 변경 알림 (UI thread wakeup) */
+struct event_notify ItemNotify;
+/* input event(HP/IR/ETH/BT) 변경 알림 (test thread wakeup) */
+struct event_notify InputNotify;
+/* network bootstrap (board ip, nlp server) 완료 알림, iperf/efuse(factory server) 만 대기 */
+struct event_notify NetNotify;
+char NetReady = 0;
+/* 결과 저장 완료 (CycleDone) 알림, benchmark 종료 대기 */
+struct event_notify CycleNotify;
+/* input event 대기 thread 의 EmergencyStop 확인 주기 */
+#define	INPUT_WAIT_MS	1000
+
+/* cycle time 기준 bootstrap 시간 측정 (ms, 0 : 아직 없음) */
+long NetReadyMs = 0, FirstResultMs = 0;
+
+#define	DEV_PATH_SIZE	64
+
+/* 측정 기록 (result report, result log) */
+struct m1_item_stat {
+	long		start_ms;			/* RUNNING 시작 시간 (cycle time ms) */
+	long		elapsed_ms;			/* RUNNING -> FINISH/STOP 소요 시간 */
+	int			value;				/* 측정값 (threshold 와 같은 단위), measured 인 경우 유효 */
+	int			link;				/* usb/eth link speed (Mbps), 0 : 확인 안됨 */
+	int			tries;				/* 측정 횟수 (retry 포함) */
+	char		measured;
+	long		trace_us;			/* RUNNING 시작 시간 (trace_now_us) */
+	long		end_ms;				/* FINISH/STOP 시간 (cycle time ms) */
+	/* RUNNING -> FINISH 를 같은 thread 에서 처리한 경우만 유효 (timeout 제외) */
+	long		cpu_start_us;
+	long		cpu_us;				/* thread cpu time (user + sys) */
+	pthread_t	cpu_thread;
+	char		cpu_measured;
+	/* timeout 으로 FINISH 처리됨, 이후 test thread 의 결과 기록은 버림 */
+	char		timed_out;
+};
 
 struct m1_item {
 	char		item_id;
 	char		response_str[RESPONSE_STR_SIZE];
 	char		status;
 	char		result;
-	char		ui_id;
-	char		thread_enable;
+	int			ui_id;
+	/* 0 : skip (m1-test.cfg), 1 : test run */
+	char		enable;
 	const char	error_str[ERROR_STR_SIZE];
+
+	/* test registry */
+	void		*(*func)(void *);	/* test thread entry, NULL : thread 생성 안함 */
+	const char	*arg_str;			/* storage type (emmc, sata, nvme) */
+	int			threshold;			/* pass 기준 (MB/s, Mbits/s, GB) */
+	int			retry;				/* 측정 retry 횟수 */
+	int			timeout;			/* sec, 0 : TIMEOVER_COUNT만 적용 */
+	int			resource;			/* RES_xxx (test_sched.h) */
+	char		dev_path[DEV_PATH_SIZE];	/* 필요한 device, 없으면 바로 fail */
+	struct m1_item_stat	stat;
 };
 
 struct m1_server {
@@ -107,27 +199,6 @@ struct m1_server {
 	struct m1_item	*items;
 };
 
-struct m1_item	M1_Items[eUI_ITEM_END] = {
-	{ eUI_IPERF_SPEED, "\0", eSTATUS_WAIT, 0, 147, 0, "IPERF" },
-	{ eUI_EFUSE_UUIDD, "\0", eSTATUS_WAIT, 0, 167, 0, "EFUSE" },
-	{ eUI_BOARD_MEM  , "\0", eSTATUS_WAIT, 0,   8, 0, "MEM" },
-	{ eUI_FB_SIZE    , "\0", eSTATUS_WAIT, 0,  42, 0, "HDMI" },
-	{ eUI_EMMC_SPEED , "\0", eSTATUS_WAIT, 0,  62, 0, "EMMC" },
-	{ eUI_SATA_SPEED , "\0", eSTATUS_WAIT, 0,  82, 0, "SATA" },
-	{ eUI_NVME_SPEED , "\0", eSTATUS_WAIT, 0,  87, 0, "NVME" },
-	{ eUI_USB30_UP   , "\0", eSTATUS_WAIT, 0, 102, 0, "USB3U" },
-	{ eUI_USB30_DN   , "\0", eSTATUS_WAIT, 0, 122, 0, "USB3D" },
-	{ eUI_USB20_UP   , "\0", eSTATUS_WAIT, 0, 107, 0, "USB2U" },
-	{ eUI_USB20_DN   , "\0", eSTATUS_WAIT, 0, 127, 0, "USB2D" },
-	{ eUI_ETH_GREEN  , "\0", eSTATUS_WAIT, 0, 162, 0, "ETH_G" },
-	{ eUI_ETH_ORANGE , "\0", eSTATUS_WAIT, 0, 163, 0, "ETH_O" },
-	{ eUI_HP_IN      , "\0", eSTATUS_WAIT, 0, 182, 0, "HP_I" },
-	{ eUI_HP_OUT     , "\0", eSTATUS_WAIT, 0, 183, 0, "HP_O" },
-	{ eUI_SPIBT_DN   , "\0", eSTATUS_WAIT, 0, 187, 0, "BT_DN" },
-	{ eUI_SPIBT_UP   , "\0", eSTATUS_WAIT, 0, 188, 0, "BT_UP" },
-	{ eUI_IR_INPUT   , "\0", eSTATUS_WAIT, 0, 142, 0, "IR_IN" },
-};
-
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -135,6 +206,55 @@ struct m1_item	M1_Items[eUI_ITEM_END] = {
 //------------------------------------------------------------------------------
 const char *OPT_DEVICE_NAME = "/dev/fb0";
 const char *OPT_FBUI_CFG = "fbui.cfg";
+const char *OPT_TEST_CFG = "m1-test.cfg";
+const char *OPT_ETH_NAME = "eth0";
+/* 1 : eth link fake backend (PHY 없이 test) */
+int OptFakeLink = 0;
+/* efuse simulator image file, NULL : /dev/efuse 사용 */
+const char *OptEfuseSim = NULL;
+/* board 결과 기록 file (-L), overlayroot 사용시 persistent partition 경로 지정 */
+const char *OptResultLog = RESULT_LOG_FILE;
+/* trace/metrics 저장 directory (-O) */
+const char *OptTraceDir = "/tmp";
+/*
+	결과 frame (M1RPT) 을 nlp server REPORT_PORT 로 전송 (-R).
+	nlp server 는 M1RPT 를 처리하지 않으므로 nlp server 에서 m1-server -r 이 실행중인 경우만 사용.
+*/
+int OptReport = 0;
+/* 결과 frame/label 메시지 spool file (-L 과 같은 persistent partition) */
+const char *OptSpoolFile = REPORT_SPOOL_FILE;
+/* hardware simulation root (-s), NULL : 실제 device 사용 */
+const char *OptSimRoot = NULL;
+/* 1 : simulation 에서 scripted 1 cycle 실행 후 stage 별 wall/cpu time 출력 (-B) */
+int OptBench = 0;
+
+/* memory test 설정 (m1-test.cfg 'M', SKU 별 bandwidth 기준), 결과 (result log 기록) */
+struct mem_test_cfg MemCfg = { 0, MEM_TEST_PERCENT, MEM_TEST_BUDGET_MS, {0,} };
+struct mem_test_result MemResult;
+char MemMeasured = 0;
+/* HDMI (fb_test) 결과 (result log 기록) */
+struct fb_test_result FbResult;
+char FbMeasured = 0;
+/* cpu load test 설정 (m1-test.cfg 'C'), 결과 (result log, trace 기록) */
+struct cpu_test_cfg CpuCfg = { 0, CPU_TEST_RUN_MS, CPU_TEST_SAMPLE_MS, CPU_TEST_THROTTLE_PCT, CPU_TEST_BALANCE_PCT, 0 };
+struct cpu_test_result CpuResult;
+char CpuMeasured = 0;
+/* storage item (eMMC, SATA, NVMe) 마지막 storage_bench 결과 (window sample, error, result log 기록) */
+struct storage_bench_result StorageResult[RESULT_LOG_STORAGE];
+char StorageMeasured[RESULT_LOG_STORAGE] = { 0, };
+
+/* UI thread 결과 저장 완료 (benchmark 종료 조건), 결과 저장 시점의 cycle time */
+volatile char CycleDone = 0;
+long CycleMs = 0;
+
+/* lib_fbui draw buffer(offscreen) -> visible framebuffer */
+struct fb_compose FbCompose;
+char *FbVisibleData = NULL;
+/* lib_fbui framebuffer, 화면 갱신 lock (HDMI test pattern 기록 중 갱신 중지) */
+fb_info_t *MainFb = NULL;
+pthread_mutex_t FbLock = PTHREAD_MUTEX_INITIALIZER;
+/* item status/result/response_str 갱신 lock (test thread 와 timeout 확인) */
+pthread_mutex_t ItemLock = PTHREAD_MUTEX_INITIALIZER;
 
 //------------------------------------------------------------------------------
 #define	DEV_SPEED_EMMC	150
@@ -143,29 +263,84 @@ const char *OPT_FBUI_CFG = "fbui.cfg";
 #define	DEV_SPEED_SATA	400
 
 #define	IPERF_SPEED		800
+/* audio loopback THD+N (-dB) */
+#define	AUDIO_THDN_DB	40
 
 //------------------------------------------------------------------------------
 // function prototype define
 //------------------------------------------------------------------------------
 int		run_interval_check	(struct timeval *t, double interval_ms);
+void	item_set_status		(struct m1_item *m1, char status);
+int		item_finish			(struct m1_item *m1, int result, const char *fmt, ...);
+void	item_set_response	(struct m1_item *m1, const char *fmt, ...);
+void	item_set_value		(struct m1_item *m1, int value, int link);
+void	item_timeout_check	(void);
 int		system_memory		(void);
 int		change_eth_speed	(int speed);
 void	macaddr_print		(void);
 void 	errcode_print		(void);
+void	result_report		(void);
+void	result_log_save		(void);
+void	trace_save			(void);
 int		get_efuse_mac		(char *mac_str);
 int		write_efuse			(char *uuid);
 
 void	*test_board_mem		(void *arg);
-void	*test_emmc_speed	(void *arg);
-void	*test_sata_speed	(void *arg);
-void	*test_nvme_speed	(void *arg);
+void	*test_cpu_load		(void *arg);
+void	*test_storage_speed	(void *arg);
+void	iperf_report		(int index, int mbps, int lost, void *arg);
 void	*test_iperf_speed	(void *arg);
 void	*test_efuse_uuid	(void *arg);
+void	*test_hp_detect		(void *arg);
+void	*test_audio_loopback	(void *arg);
+void	*test_hdmi			(void *arg);
+void	*test_ir_input		(void *arg);
+void	*test_eth_change	(void *arg);
+void	*test_spibt_input	(void *arg);
+void	*test_usb_speed		(void *arg);
 void	*thread_ui_update 	(void *arg);
 
-void	bootup_test			(fb_info_t *pfb, ui_grp_t *pui);
+void	*thread_net_bootstrap	(void *arg);
+int		wait_network		(void);
+int		test_registry_load	(const char *cfg_fname);
+void	test_thread_run		(void);
 int		main				(int argc, char **argv);
 
+//------------------------------------------------------------------------------
+// test registry
+// 새로운 test 추가 시 eUI_xxx, 아래 table, fbui.cfg(ui_id) 만 수정.
+// enable/ui_id/threshold/retry/timeout/dev_path 는 m1-test.cfg 로 board(SKU)별 변경 가능.
+//------------------------------------------------------------------------------
+#define	USB30_MASS_SPEED	60
+#define	USB20_MASS_SPEED	20
+#define	BOARD_MEM_SIZE		4
+/* core 별 최소 Mops/s (cpu_test), 0 : 판정 안함 (throttling, core 간 편차만 확인) */
+#define	CPU_LOAD_MOPS		0
+
+struct m1_item	M1_Items[eUI_ITEM_END] = {
+	/* item_id        resp  status        res ui_id en  error_str func                arg      threshold         retry                 timeout resource              dev_path stat */
+	{ eUI_IPERF_SPEED, "\0", eSTATUS_WAIT, 0, 147, 1, "IPERF", test_iperf_speed  , NULL   , IPERF_SPEED     , TEST_RETRY_COUNT * 2, 60, RES_ETH | RES_CPU     , "", {0} },
+	{ eUI_EFUSE_UUIDD, "\0", eSTATUS_WAIT, 0, 167, 1, "EFUSE", test_efuse_uuid   , NULL   , 0               , 1                   , 30, RES_EFUSE           , "", {0} },
+	{ eUI_BOARD_MEM  , "\0", eSTATUS_WAIT, 0,   8, 1, "MEM"  , test_board_mem    , NULL   , BOARD_MEM_SIZE  , 1                   , 30, RES_CPU             , "", {0} },
+	{ eUI_CPU_LOAD   , "\0", eSTATUS_WAIT, 0,  28, 1, "CPU"  , test_cpu_load     , NULL   , CPU_LOAD_MOPS   , 1                   , 20, RES_CPU             , "", {0} },
+	{ eUI_FB_SIZE    , "\0", eSTATUS_WAIT, 0,  42, 1, "HDMI" , test_hdmi         , NULL   , FB_TEST_HZ      , 1                   , 10, RES_CPU             , "", {0} },
+	{ eUI_EMMC_SPEED , "\0", eSTATUS_WAIT, 0,  62, 1, "EMMC" , test_storage_speed, "emmc" , DEV_SPEED_EMMC  , TEST_RETRY_COUNT    , 60, RES_EMMC | RES_CPU    , "", {0} },
+	{ eUI_SATA_SPEED , "\0", eSTATUS_WAIT, 0,  82, 1, "SATA" , test_storage_speed, "sata" , DEV_SPEED_SATA  , TEST_RETRY_COUNT    , 60, RES_PCIE | RES_CPU    , "", {0} },
+	{ eUI_NVME_SPEED , "\0", eSTATUS_WAIT, 0,  87, 1, "NVME" , test_storage_speed, "nvme" , DEV_SPEED_NVME  , TEST_RETRY_COUNT    , 60, RES_PCIE | RES_CPU    , "", {0} },
+	{ eUI_USB30_UP   , "\0", eSTATUS_WAIT, 0, 102, 1, "USB3U", test_usb_speed    , NULL   , USB30_MASS_SPEED, 1                   ,  0, RES_USB | RES_INPUT   , "", {0} },
+	{ eUI_USB30_DN   , "\0", eSTATUS_WAIT, 0, 122, 1, "USB3D", test_usb_speed    , NULL   , USB30_MASS_SPEED, 1                   ,  0, RES_USB | RES_INPUT   , "", {0} },
+	{ eUI_USB20_UP   , "\0", eSTATUS_WAIT, 0, 107, 1, "USB2U", test_usb_speed    , NULL   , USB20_MASS_SPEED, 1                   ,  0, RES_USB | RES_INPUT   , "", {0} },
+	{ eUI_USB20_DN   , "\0", eSTATUS_WAIT, 0, 127, 1, "USB2D", test_usb_speed    , NULL   , USB20_MASS_SPEED, 1                   ,  0, RES_USB | RES_INPUT   , "", {0} },
+	{ eUI_ETH_GREEN  , "\0", eSTATUS_WAIT, 0, 162, 1, "ETH_G", test_eth_change   , NULL   , 0               , 1                   ,  0, RES_INPUT           , "", {0} },
+	{ eUI_ETH_ORANGE , "\0", eSTATUS_WAIT, 0, 163, 1, "ETH_O", test_eth_change   , NULL   , 0               , 1                   ,  0, RES_INPUT           , "", {0} },
+	{ eUI_HP_IN      , "\0", eSTATUS_WAIT, 0, 182, 1, "HP_I" , test_hp_detect    , NULL   , 0               , 1                   ,  0, RES_INPUT           , "", {0} },
+	{ eUI_HP_OUT     , "\0", eSTATUS_WAIT, 0, 183, 1, "HP_O" , test_hp_detect    , NULL   , 0               , 1                   ,  0, RES_INPUT           , "", {0} },
+	{ eUI_AUDIO_LOOP , "\0", eSTATUS_WAIT, 0,  43, 1, "AUDIO", test_audio_loopback, NULL  , AUDIO_THDN_DB   , 3                   , 10, RES_NONE            , "", {0} },
+	{ eUI_SPIBT_DN   , "\0", eSTATUS_WAIT, 0, 187, 1, "BT_DN", test_spibt_input  , NULL   , 0               , 1                   ,  0, RES_INPUT           , "", {0} },
+	{ eUI_SPIBT_UP   , "\0", eSTATUS_WAIT, 0, 188, 1, "BT_UP", test_spibt_input  , NULL   , 0               , 1                   ,  0, RES_INPUT           , "", {0} },
+	{ eUI_IR_INPUT   , "\0", eSTATUS_WAIT, 0, 142, 1, "IR_IN", test_ir_input     , NULL   , 0               , 1                   ,  0, RES_INPUT           , "", {0} },
+};
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 int run_interval_check (struct timeval *t, double interval_ms)
@@ -193,6 +368,165 @@ int run_interval_check (struct timeval *t, double interval_ms)
 	return 1;
 }
 
+//------------------------------------------------------------------------------
+static long thread_cpu_us (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts);
+	return	ts.tv_sec * 1000000L + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+// ItemLock 안에서 호출
+//------------------------------------------------------------------------------
+static void item_status_locked (struct m1_item *m1, char status)
+{
+	if ((status == eSTATUS_RUNNING) && (m1->status != eSTATUS_RUNNING)) {
+		m1->stat.start_ms     = cycle_time_ms ();
+		m1->stat.trace_us     = trace_now_us ();
+		m1->stat.cpu_start_us = thread_cpu_us ();
+		m1->stat.cpu_thread   = pthread_self ();
+	}
+	if (((status == eSTATUS_FINISH) || (status == eSTATUS_STOP)) &&
+		(m1->status == eSTATUS_RUNNING)) {
+		m1->stat.elapsed_ms = cycle_time_ms () - m1->stat.start_ms;
+		trace_end ("test", m1->error_str, m1->stat.trace_us, m1->result);
+		if (pthread_equal (m1->stat.cpu_thread, pthread_self ())) {
+			m1->stat.cpu_us       = thread_cpu_us () - m1->stat.cpu_start_us;
+			m1->stat.cpu_measured = 1;
+		}
+	}
+	/* process 시작 후 첫 결과 시간 (test thread 에서 동시 호출) */
+	if ((status == eSTATUS_FINISH) || (status == eSTATUS_STOP)) {
+		m1->stat.end_ms = cycle_time_ms ();
+		__sync_bool_compare_and_swap (&FirstResultMs, 0, m1->stat.end_ms);
+	}
+	m1->status = status;
+	event_notify_post (&ItemNotify);
+}
+
+//------------------------------------------------------------------------------
+// timeout 처리된 item 은 변경하지 않음
+//------------------------------------------------------------------------------
+void item_set_status (struct m1_item *m1, char status)
+{
+	pthread_mutex_lock (&ItemLock);
+	if (!m1->stat.timed_out)
+		item_status_locked (m1, status);
+	pthread_mutex_unlock (&ItemLock);
+}
+
+//------------------------------------------------------------------------------
+// test 결과 (result, response_str) 기록 후 status 변경. fmt NULL : response_str 유지
+// return 0 : 이미 timeout 처리됨 (늦은 결과는 버림)
+//------------------------------------------------------------------------------
+static int item_result (struct m1_item *m1, int result, char status, const char *fmt, va_list ap)
+{
+	pthread_mutex_lock (&ItemLock);
+	if (m1->stat.timed_out) {
+		pthread_mutex_unlock (&ItemLock);
+		printf ("%s : %s late result dropped (timeout)\n", __func__, m1->error_str);
+		return 0;
+	}
+	if (fmt != NULL) {
+		memset    (m1->response_str, 0x00, RESPONSE_STR_SIZE);
+		vsnprintf (m1->response_str, RESPONSE_STR_SIZE, fmt, ap);
+	}
+	m1->result = result ? 1 : 0;
+	item_status_locked (m1, status);
+	pthread_mutex_unlock (&ItemLock);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+// test 결과 기록 후 FINISH
+//------------------------------------------------------------------------------
+int item_finish (struct m1_item *m1, int result, const char *fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start (ap, fmt);
+	ret = item_result (m1, result, eSTATUS_FINISH, fmt, ap);
+	va_end   (ap);
+	return	ret;
+}
+
+//------------------------------------------------------------------------------
+// fail 결과 기록 후 STOP (장치 재연결시 다시 test)
+//------------------------------------------------------------------------------
+int item_stop (struct m1_item *m1, const char *fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start (ap, fmt);
+	ret = item_result (m1, 0, eSTATUS_STOP, fmt, ap);
+	va_end   (ap);
+	return	ret;
+}
+
+//------------------------------------------------------------------------------
+// 측정 중간 결과 표시 (RUNNING 유지)
+//------------------------------------------------------------------------------
+void item_set_response (struct m1_item *m1, const char *fmt, ...)
+{
+	va_list ap;
+
+	pthread_mutex_lock (&ItemLock);
+	if (!m1->stat.timed_out) {
+		memset    (m1->response_str, 0x00, RESPONSE_STR_SIZE);
+		va_start  (ap, fmt);
+		vsnprintf (m1->response_str, RESPONSE_STR_SIZE, fmt, ap);
+		va_end    (ap);
+	}
+	pthread_mutex_unlock (&ItemLock);
+	event_notify_post (&ItemNotify);
+}
+
+//------------------------------------------------------------------------------
+// result log 용 측정값 기록 (response_str 는 UI 표시용 문자열), value < 0 : 측정값 없음 (link 만 기록)
+//------------------------------------------------------------------------------
+void item_set_value (struct m1_item *m1, int value, int link)
+{
+	pthread_mutex_lock (&ItemLock);
+	if (!m1->stat.timed_out) {
+		if (value >= 0) {
+			m1->stat.value    = value;
+			m1->stat.measured = 1;
+		}
+		if (link)
+			m1->stat.link = link;
+	}
+	pthread_mutex_unlock (&ItemLock);
+}
+
+//------------------------------------------------------------------------------
+// test 진행 중 item 별 timeout 확인. timeout 이후 test thread 의 결과는 기록하지 않음
+//------------------------------------------------------------------------------
+void item_timeout_check (void)
+{
+	long now = cycle_time_ms ();
+	int i;
+
+	pthread_mutex_lock (&ItemLock);
+	for (i = 0; i < eUI_ITEM_END; i++) {
+		struct m1_item *m1 = &M1_Items[i];
+
+		if (!m1->timeout || (m1->status != eSTATUS_RUNNING))
+			continue;
+		if ((now - m1->stat.start_ms) / 1000 > m1->timeout) {
+			memset  (m1->response_str, 0x00, RESPONSE_STR_SIZE);
+			sprintf (m1->response_str, "%s", "TIMEOUT");
+			m1->result = 0;
+			item_status_locked (m1, eSTATUS_FINISH);
+			m1->stat.timed_out = 1;
+		}
+	}
+	pthread_mutex_unlock (&ItemLock);
+}
+
 //------------------------------------------------------------------------------
 int system_memory (void)
 {
@@ -213,59 +547,36 @@ int system_memory (void)
 }
 
 //------------------------------------------------------------------------------
-// change eth speed -> ethtool used
-// eth speed change cmd (apt install ethtool), speed {100|1000}
-// ethtool -s eth0 speed {speed} duplex full
-// check eth link speed "/sys/class/net/eth0/speed"
+// change eth speed -> SIOCETHTOOL (ethtool -s eth0 speed {speed} duplex full)
+// speed {100|1000}, link up(RTM_NEWLINK) 시 바로 return.
+// return -1 : 이미 요청 속도, 1 : 변경 완료, 0 : 변경 실패 (timeout)
 //------------------------------------------------------------------------------
 int change_eth_speed (int speed)
 {
-	FILE *fp;
-	char cmd_line[128], retry = TEST_RETRY_COUNT;
-
-	if (access ("/sys/class/net/eth0/speed", F_OK) != 0)
-		return 0;
-
-	memset (cmd_line, 0x00, sizeof(cmd_line));
-	if ((fp = fopen ("/sys/class/net/eth0/speed", "r")) != NULL) {
-		memset (cmd_line, 0x00, sizeof(cmd_line));
-		if (NULL != fgets (cmd_line, sizeof(cmd_line), fp)) {
-			if (speed == atoi(cmd_line)) {
-				fclose (fp);
-				return -1;
-			}
-		}
-		fclose (fp);
-	}
-	memset (cmd_line, 0x00, sizeof(cmd_line));
-	sprintf(cmd_line,"ethtool -s eth0 speed %d duplex full 2<&1", speed);
-	if ((fp = popen(cmd_line, "w")) != NULL)
-		pclose(fp);
-
-	while (retry) {
-		if ((fp = fopen ("/sys/class/net/eth0/speed", "r")) != NULL) {
-			memset (cmd_line, 0x00, sizeof(cmd_line));
-			if (NULL != fgets (cmd_line, sizeof(cmd_line), fp)) {
-				if (speed == atoi(cmd_line)) {
-					fclose (fp);
-					return 1;
-				}
-				retry--;
-				fprintf (stderr, "%s : change speed = %d, read speed = %d, retry remain = %d\n",
-						__func__, speed, atoi(cmd_line), retry);
-			}
-			fclose (fp);
-		}
-		sleep (1);
+	struct eth_link_state state;
+	long start = cycle_time_ms (), trace_us = trace_now_us ();
+	int changed = 0;
+
+	/* 모든 return 경로에서 trace span 을 닫음 */
+	if (!eth_link_get (&state))
+		changed = 0;
+	else if (state.up && (state.speed == speed))
+		changed = -1;
+	else if (!eth_link_set_speed (speed)) {
+		changed = eth_link_wait (speed, TEST_RETRY_COUNT * 1000);
+		eth_link_get (&state);
+		printf ("%s : change speed = %d, link speed = %d, %s (%ld ms)\n", __func__,
+			speed, state.speed, changed ? "done" : "timeout", cycle_time_ms () - start);
 	}
-	return 0;
+	trace_end ("call", "eth_speed", trace_us, speed);
+	return changed;
 }
 
 //------------------------------------------------------------------------------
 void macaddr_print (void)
 {
-	/* mac address print */
-	nlp_server_write (NlpServerIP, NLP_SERVER_MSG_TYPE_MAC, MacStr, 0);
+	/* mac address print (report_queue thread 에서 전송) */
+	report_queue_nlp (NLP_SERVER_MSG_TYPE_MAC, MacStr);
 }
 
 //------------------------------------------------------------------------------
@@ -290,42 +601,202 @@ void errcode_print (void)
 	}
 	if (pos || line) {
 		for (i = 0; i < line+1; i++) {
-			nlp_server_write (NlpServerIP, NLP_SERVER_MSG_TYPE_ERR, &err_msg[i][0], 0);
+			report_queue_nlp (NLP_SERVER_MSG_TYPE_ERR, &err_msg[i][0]);
 			printf ("%s : msg = %s\n", __func__, &err_msg[i][0]);
 		}
 	}
 }
 
 //------------------------------------------------------------------------------
+// board/item 결과를 1 frame (json line) 으로 nlp server (REPORT_PORT) 에 전송
+//------------------------------------------------------------------------------
+static const char *item_status_str (char status)
+{
+	switch (status) {
+		case eSTATUS_WAIT:		return "WAIT";
+		case eSTATUS_RUNNING:	return "RUNNING";
+		case eSTATUS_SKIP:		return "SKIP";
+		case eSTATUS_STOP:		return "STOP";
+		case eSTATUS_FINISH:	return "FINISH";
+		default:				return "UNKNOWN";
+	}
+}
+
+void result_report (void)
+{
+	int i, error_cnt;
+
+	for (i = 0, error_cnt = 0; i < eUI_ITEM_END; i++)
+		error_cnt += M1_Items[i].result ? 0 : 1;
+
+	report_queue_record ("{\"type\":\"board\",\"mac\":\"%s\",\"ip\":\"%s\",\"cycle_ms\":%ld,"
+		"\"first_ms\":%ld,\"net_ms\":%ld,\"error\":%d}",
+		MacStr, BoardIP, cycle_time_ms (), FirstResultMs, NetReadyMs, error_cnt);
+
+	for (i = 0; i < eUI_ITEM_END; i++) {
+		struct m1_item *m1 = &M1_Items[i];
+
+		report_queue_record ("{\"type\":\"item\",\"name\":\"%s\",\"status\":\"%s\","
+			"\"result\":%d,\"value\":\"%s\",\"raw\":%d,\"threshold\":%d,"
+			"\"link\":%d,\"tries\":%d,\"ms\":%ld}",
+			m1->error_str, item_status_str (m1->status), m1->result,
+			m1->response_str, m1->stat.measured ? m1->stat.value : -1, m1->threshold,
+			m1->stat.link, m1->stat.tries, m1->stat.elapsed_ms);
+	}
+	report_queue_flush ();
+}
+
+//------------------------------------------------------------------------------
+// board 1회 test 결과를 result log (OptResultLog) 에 추가
+//------------------------------------------------------------------------------
+void result_log_save (void)
+{
+	struct result_log_rec rec;
+	int i;
+
+	memset (&rec, 0, sizeof(rec));
+	rec.time     = time (NULL);
+	rec.cycle_ms = cycle_time_ms ();
+	result_log_set_mac (&rec, MacStr);
+
+	for (i = 0; (i < eUI_ITEM_END) && (i < RESULT_LOG_ITEM_MAX); i++) {
+		struct m1_item *m1 = &M1_Items[i];
+		struct result_log_item *it = &rec.items[i];
+
+		strncpy (it->name, m1->error_str, RESULT_LOG_NAME_SIZE);
+		it->value      = m1->stat.value;
+		it->elapsed_ms = m1->stat.elapsed_ms;
+		it->link       = m1->stat.link;
+		it->status     = m1->status;
+		it->result     = m1->result;
+		it->tries      = m1->stat.tries;
+		it->flags      = (m1->stat.measured ? RESULT_LOG_F_VALUE : 0) |
+						 (m1->stat.link     ? RESULT_LOG_F_LINK  : 0);
+		rec.error_cnt += m1->result ? 0 : 1;
+	}
+	rec.item_cnt = i;
+
+	if (MemMeasured) {
+		for (i = 0; i < eMEM_BW_END; i++)
+			rec.mem.bw[i] = MemResult.bw[i];
+		rec.mem.tested_mb = MemResult.tested_mb;
+		rec.mem.errors    = MemResult.errors;
+		for (i = 0; (i < MemResult.err_cnt) && (i < RESULT_LOG_MEM_ERR); i++)
+			rec.mem.err_addr[i] = MemResult.err[i].paddr ? MemResult.err[i].paddr : MemResult.err[i].vaddr;
+	}
+	if (FbMeasured) {
+		rec.fb.write_mbps   = FbResult.write_mbps;
+		rec.fb.read_mbps    = FbResult.read_mbps;
+		rec.fb.refresh_chz  = FbResult.vsync ? FbResult.refresh_chz : 0;
+		rec.fb.jitter_us    = FbResult.jitter_us;
+		rec.fb.max_dev_us   = FbResult.max_dev_us;
+		rec.fb.bad_patterns = FbResult.bad_patterns;
+	}
+
+	if (CpuMeasured && (CpuResult.verdict != eCPU_ERROR)) {
+		struct result_log_cpu *cpu = &rec.cpu;
+		int b, c;
+
+		for (i = 0; (i < CpuResult.threads) && (i < RESULT_LOG_CPU_CORES); i++)
+			cpu->mops[i] = CpuResult.mops[i];
+		cpu->mhz_min       = CpuResult.mhz_min;
+		cpu->mhz_max       = CpuResult.mhz_max;
+		cpu->temp_start_dc = CpuResult.temp_start_dc;
+		cpu->temp_max_dc   = CpuResult.temp_max_dc;
+		cpu->throttle_ms   = CpuResult.throttle_ms < 0 ? 0xffff :
+							 CpuResult.throttle_ms < 0xffff ? CpuResult.throttle_ms : 0xfffe;
+		cpu->verdict       = CpuResult.verdict;
+		/* sample 을 RESULT_LOG_CPU_SAMPLES 구간으로 나눠 구간 별 최소 clock, 최대 온도 */
+		for (i = 0; i < CpuResult.sample_cnt; i++) {
+			const struct cpu_test_sample *s = &CpuResult.sample[i];
+
+			b = i * RESULT_LOG_CPU_SAMPLES / CpuResult.sample_cnt;
+			for (c = 0; c < CpuResult.threads; c++)
+				if (s->mhz[c] && (!cpu->mhz[b] || (s->mhz[c] < cpu->mhz[b])))
+					cpu->mhz[b] = s->mhz[c];
+			for (c = 0; c < CpuResult.zones; c++)
+				if (!cpu->temp_dc[b] || (s->temp_dc[c] > cpu->temp_dc[b]))
+					cpu->temp_dc[b] = s->temp_dc[c];
+			cpu->samples = b + 1;
+		}
+	}
+
+	for (i = 0; i < RESULT_LOG_STORAGE; i++) {
+		const struct storage_bench_result *res = &StorageResult[i];
+		struct result_log_storage *st = &rec.storage[i];
+		int w;
+
+		if (!StorageMeasured[i])
+			continue;
+		strncpy (st->name, M1_Items[eUI_EMMC_SPEED + i].error_str, RESULT_LOG_NAME_SIZE);
+		for (w = 0; (w < res->sample_cnt) && (w < RESULT_LOG_STORAGE_WIN); w++)
+			st->win_mbps[w] = res->samples[w] < 0xffff ? res->samples[w] : 0xffff;
+		st->wins       = res->sample_cnt < 0xff ? res->sample_cnt : 0xff;
+		st->verdict    = res->verdict;
+		st->errors     = res->errors < 0xffff ? res->errors : 0xffff;
+		st->lat_p99_us = res->lat_p99_us;
+	}
+
+	if (!result_log_append (OptResultLog, &rec))
+		printf ("%s : %s (%d items)\n", __func__, OptResultLog, rec.item_cnt);
+}
+
+//------------------------------------------------------------------------------
+// 1회 실행 trace (chrome trace json) 와 histogram snapshot (prometheus text) 저장
+//------------------------------------------------------------------------------
+void trace_save (void)
+{
+	char fname[256];
+
+	if (OptTraceDir == NULL)
+		return;
+
+	snprintf (fname, sizeof(fname), "%s/m1-trace-%s-%ld.json", OptTraceDir,
+		MacStr[0] ? MacStr : "unknown", (long)time (NULL));
+	if (trace_export_chrome (fname) >= 0)
+		printf ("%s : %s (%d events)\n", __func__, fname, trace_event_cnt ());
+
+	snprintf (fname, sizeof(fname), "%s/m1-metrics.prom", OptTraceDir);
+	trace_export_prom (fname);
+}
+
 //------------------------------------------------------------------------------
-const char	*EFUSE_UUID_FILE = "/sys/class/efuse/uuid";
+static int report_nlp_send (int mtype, const char *msg, void *arg)
+{
+	long t = trace_now_us ();
+	int ret;
+
+	(void)arg;
+	if (OptSimRoot != NULL)
+		ret = hw_sim_nlp_write (mtype, msg);
+	else
+		ret = nlp_server_write (NlpServerIP, mtype, (char *)msg, 0);
+	trace_end ("call", "nlp_server_write", t, ret);
+	return	ret ? 0 : -1;
+}
 
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// efuse uuid (/sys/class/efuse/uuid) 에서 mac (001e06xxxxxx) 확인
+//------------------------------------------------------------------------------
 int get_efuse_mac (char *mac_str)
 {
-	FILE *fp;
 	char cmd_line[128];
 
-	if (access (EFUSE_UUID_FILE, F_OK) != 0)
-		return 0;
-
-	if ((fp = fopen(EFUSE_UUID_FILE, "r")) != NULL) {
-		if (fgets (cmd_line, sizeof(cmd_line), fp) != NULL) {
-			char *ptr;
-			int i;
-			if ((ptr = strstr(cmd_line, "001e06")) != NULL) {
-				for (i = 0; i < 12; i++)
-					mac_str[i] = *(ptr + i);
-				printf ("%s : mac str = %s\n", __func__, mac_str);
-				fclose (fp);
-				return 1;
-			} else {
-				/* display hex value */
-				int i, len = strlen(cmd_line);
-				for (i = 0; i < len; i++)
-					printf ("%d - 0x%02x\n", i, cmd_line[i]);
-			}
+	if (efuse_read_uuid (cmd_line, sizeof(cmd_line))) {
+		char *ptr;
+		int i;
+		if ((ptr = strstr(cmd_line, "001e06")) != NULL) {
+			for (i = 0; i < 12; i++)
+				mac_str[i] = *(ptr + i);
+			printf ("%s : mac str = %s\n", __func__, mac_str);
+			return 1;
+		} else {
+			/* display hex value */
+			int i, len = strlen(cmd_line);
+			for (i = 0; i < len; i++)
+				printf ("%d - 0x%02x\n", i, cmd_line[i]);
 		}
-		fclose(fp);
 	}
 	return 0;
 }
@@ -352,127 +823,361 @@ int get_efuse_mac (char *mac_str)
 //------------------------------------------------------------------------------
 int write_efuse (char *uuid)
 {
-	FILE *fp;
-	char cmd_line[128], offset = 0;
+	int offset = 0, ret;
+	long t = trace_now_us ();
 
-	if (access ("/dev/efuse", F_OK) != 0)
-		return 0;
+	/* efuse ioctl 후 /sys/class/efuse/uuid 로 기록 확인 */
+	ret = efuse_provision (uuid, offset);
+	trace_end ("call", "efuse_provision", t, ret);
+	return	ret;
+}
 
-	memset (cmd_line, 0x00, sizeof(cmd_line));
-	sprintf(cmd_line,"python3 efuse/efuse_ctl.py -w %s %d", uuid, offset);
+//------------------------------------------------------------------------------
+// MEM/CPU 는 RES_CPU slot 을 모두 사용하므로 RES_CPU 를 같이 쓰는 I/O test (EMMC/SATA/NVME/IPERF) 가
+// 끝난 후 실행 (먼저 실행하면 I/O test 가 그 동안 대기). 결과가 나오지 않는 I/O test 가 있어도
+// EXCL_DEFER_MAX_MS 이후에는 실행.
+//------------------------------------------------------------------------------
+#define	EXCL_DEFER_MAX_MS	30000
 
-	if ((fp = popen(cmd_line, "r")) != NULL) {
-		memset (cmd_line, 0x00, sizeof(cmd_line));
-		while (fgets (cmd_line, sizeof(cmd_line), fp) != NULL) {
-			if (strstr (cmd_line, "efuse write success") != NULL) {
-				printf ("%s : efuse write success! uuid = %s \n", __func__, uuid);
-				pclose (fp);
-				return 1;
-			}
-			memset (cmd_line, 0x00, sizeof(cmd_line));
+static int excl_pending (void)
+{
+	int i, pending = 0;
+
+	for (i = 0; i < eUI_ITEM_END; i++) {
+		struct m1_item *m1 = &M1_Items[i];
+
+		if ((m1->item_id == eUI_BOARD_MEM) || (m1->item_id == eUI_CPU_LOAD))
+			continue;
+		if (m1->enable && (m1->resource & RES_CPU) &&
+			(m1->status != eSTATUS_FINISH) && (m1->status != eSTATUS_SKIP))
+			pending++;
+	}
+	return	pending;
+}
+
+static void excl_defer (struct m1_item *m1)
+{
+	unsigned int seq = event_notify_seq (&ItemNotify);
+	long end = cycle_time_ms () + EXCL_DEFER_MAX_MS;
+	int pending;
+
+	while ((pending = excl_pending ()) && !EmergencyStop) {
+		if (cycle_time_ms () >= end) {
+			printf ("%s : %s start with %d io test pending\n", __func__, m1->error_str, pending);
+			break;
 		}
-		pclose(fp);
+		event_notify_wait (&ItemNotify, &seq, INPUT_WAIT_MS);
 	}
-	return 0;
 }
 
+//------------------------------------------------------------------------------
+// memory 크기 (m1->threshold GB) 확인 후 bandwidth/integrity test (MemCfg, m1-test.cfg 'M')
+// 전체 core 를 사용하므로 다른 cpu benchmark 와 동시에 실행하지 않음.
 //------------------------------------------------------------------------------
 void *test_board_mem (void *arg)
 {
 	struct m1_item *m1 = (struct m1_item *)arg;
-	int mem = system_memory ();
-
-	m1->status = eSTATUS_RUNNING;
-
-	memset  (m1->response_str, 0x00, RESPONSE_STR_SIZE);
-	sprintf (m1->response_str, "%d GB", mem);
-
-	m1->result = mem ? 1 : 0;
-
-	m1->status = eSTATUS_FINISH;
+	char str[RESPONSE_STR_SIZE - 8];
+	int mem = system_memory (), ok;
+	long t;
+
+	excl_defer (m1);
+	test_sched_acquire_excl (m1->resource);
+	item_set_status (m1, eSTATUS_RUNNING);
+
+	trace_instant ("retry", m1->error_str, ++m1->stat.tries);
+	t  = trace_now_us ();
+	ok = mem_test_run (&MemCfg, &MemResult);
+	trace_end ("call", "mem_test", t, MemResult.bw[eMEM_BW_COPY]);
+	MemMeasured = 1;
+	test_sched_release_excl (m1->resource);
+
+	mem_test_summary (&MemResult, str, sizeof(str));
+	item_set_value (m1, mem, 0);
+	item_finish (m1, (mem >= m1->threshold) && ok, "%dGB %s", mem, str);
 	return arg;
 }
 
 //------------------------------------------------------------------------------
-void *test_emmc_speed (void *arg)
+// cpu_test sample 을 trace counter 로 기록 (cat "cpu", chrome trace 에서 시간축 graph)
+//------------------------------------------------------------------------------
+static void cpu_trace_samples (const struct cpu_test_result *res)
 {
-	struct m1_item *m1 = (struct m1_item *)arg;
-	int speed = 0, retry = TEST_RETRY_COUNT;
-
-	m1->status = eSTATUS_RUNNING;
-
-	while ((retry--) && (speed < DEV_SPEED_EMMC)) {
-		memset (m1->response_str, 0x00, RESPONSE_STR_SIZE);
-		speed = storage_test ("emmc", m1->response_str);
+	static const char *mhz_names[CPU_TEST_CPU_MAX] = {
+		"cpu0_mhz", "cpu1_mhz", "cpu2_mhz", "cpu3_mhz", "cpu4_mhz", "cpu5_mhz", "cpu6_mhz", "cpu7_mhz"
+	};
+	static const char *mops_names[CPU_TEST_CPU_MAX] = {
+		"cpu0_mops", "cpu1_mops", "cpu2_mops", "cpu3_mops", "cpu4_mops", "cpu5_mops", "cpu6_mops", "cpu7_mops"
+	};
+	static const char *temp_names[CPU_TEST_ZONE_MAX] = {
+		"zone0_temp_dc", "zone1_temp_dc", "zone2_temp_dc", "zone3_temp_dc"
+	};
+	int i, c;
+
+	for (i = 0; i < res->sample_cnt; i++) {
+		const struct cpu_test_sample *s = &res->sample[i];
+
+		for (c = 0; c < res->threads; c++) {
+			if (s->mhz[c])
+				trace_counter ("cpu", mhz_names[c], s->ts_us, s->mhz[c]);
+			/* sample 0 은 시작 시점 (구간 ops 없음) */
+			if (i)
+				trace_counter ("cpu", mops_names[c], s->ts_us, s->mops[c]);
+		}
+		for (c = 0; c < res->zones; c++)
+			trace_counter ("cpu", temp_names[c], s->ts_us, s->temp_dc[c]);
 	}
-	m1->result = speed < DEV_SPEED_EMMC ? 0 : 1;
+}
 
-	m1->status = eSTATUS_FINISH;
+//------------------------------------------------------------------------------
+// 전체 core 에 int/fp/mem kernel 부하 (CpuCfg, m1-test.cfg 'C') 후 core 별 Mops/s,
+// clock 저하 (throttling), 다른 core 보다 느린 core 확인. m1->threshold : core 별 최소 Mops/s
+//------------------------------------------------------------------------------
+void *test_cpu_load (void *arg)
+{
+	struct m1_item *m1 = (struct m1_item *)arg;
+	struct cpu_test_cfg cfg = CpuCfg;
+	char str[RESPONSE_STR_SIZE];
+	int i, ok, min;
+	long t;
+
+	cfg.mops_min = m1->threshold;
+	excl_defer (m1);
+	test_sched_acquire_excl (m1->resource);
+	item_set_status (m1, eSTATUS_RUNNING);
+
+	trace_instant ("retry", m1->error_str, ++m1->stat.tries);
+	t  = trace_now_us ();
+	ok = cpu_test_run (&cfg, &CpuResult);
+	trace_end ("call", "cpu_test", t, CpuResult.verdict);
+	CpuMeasured = 1;
+	test_sched_release_excl (m1->resource);
+	cpu_trace_samples (&CpuResult);
+
+	cpu_test_summary (&CpuResult, str, sizeof(str));
+	for (i = 0, min = 0; i < CpuResult.threads; i++)
+		min = (!i || (CpuResult.mops[i] < min)) ? CpuResult.mops[i] : min;
+	if (CpuResult.verdict != eCPU_ERROR)
+		item_set_value (m1, min, 0);
+
+	item_finish (m1, ok, "%s", str);
 	return arg;
 }
 
 //------------------------------------------------------------------------------
-void *test_sata_speed (void *arg)
+// HDMI : 해상도 (1920x1080), framebuffer write/read-back bandwidth 와 pattern checksum,
+// vsync interval 로 refresh (m1->threshold Hz) 확인. vsync 가 없는 경우 refresh 는 판정 안함.
+//------------------------------------------------------------------------------
+void *test_hdmi (void *arg)
 {
 	struct m1_item *m1 = (struct m1_item *)arg;
-	int speed = 0, retry = TEST_RETRY_COUNT;
+	struct fb_test_cfg cfg;
+	char str[RESPONSE_STR_SIZE - 10];
+	int ok;
+	long t;
+
+	/* framebuffer bandwidth, vsync wakeup 측정은 다른 benchmark 와 core 를 나누어 사용 (RES_CPU slot) */
+	test_sched_acquire (m1->resource);
+	item_set_status (m1, eSTATUS_RUNNING);
+	trace_instant ("retry", m1->error_str, ++m1->stat.tries);
+
+	memset (&cfg, 0, sizeof(cfg));
+	cfg.w      = MainFb->w;
+	cfg.h      = MainFb->h;
+	cfg.bpp    = MainFb->bpp;
+	cfg.hz     = m1->threshold;
+	/* simulation : memory framebuffer, clock vsync */
+	cfg.sim_hz = (OptSimRoot != NULL) ? FB_TEST_HZ : 0;
+
+	t = trace_now_us ();
+	pthread_mutex_lock (&FbLock);
+	/* lib_fbui 가 offscreen 에 그리는 경우 현재 scanout page */
+	if (FbVisibleData != NULL) {
+		cfg.data     = FbCompose.visible + FbCompose.page * FbCompose.page_size;
+		cfg.stride   = FbCompose.stride;
+		cfg.wc       = (FbCompose.mode != eFB_COMPOSE_FAKE) ? 1 : 0;
+		cfg.vsync_fd = (FbCompose.mode != eFB_COMPOSE_FAKE) ? FbCompose.fd : -1;
+	} else {
+		cfg.data     = MainFb->data;
+		cfg.stride   = MainFb->stride;
+		cfg.wc       = (OptSimRoot == NULL) ? 1 : 0;
+		cfg.vsync_fd = (OptSimRoot == NULL) ? MainFb->fd : -1;
+	}
+	fb_test_patterns (&cfg, &FbResult);
+	pthread_mutex_unlock (&FbLock);
 
-	m1->status = eSTATUS_RUNNING;
+	fb_test_vsync (&cfg, &FbResult);
+	test_sched_release (m1->resource);
+	ok = fb_test_verdict (&cfg, &FbResult);
+	trace_end ("call", "fb_test", t, FbResult.write_mbps);
+	FbMeasured = 1;
 
-	while ((retry--) && (speed < DEV_SPEED_SATA)) {
-		memset (m1->response_str, 0x00, RESPONSE_STR_SIZE);
-		speed = storage_test ("sata", m1->response_str);
-	}
-	m1->result = speed < DEV_SPEED_SATA ? 0 : 1;
+	fb_test_summary (&FbResult, str, sizeof(str));
+	if (FbResult.vsync)
+		item_set_value (m1, (FbResult.refresh_chz + 50) / 100, 0);
 
-	m1->status = eSTATUS_FINISH;
+	item_finish (m1, (MainFb->w == 1920) && (MainFb->h == 1080) && ok,
+		"%dx%d %s", MainFb->w, MainFb->h, str);
 	return arg;
 }
 
 //------------------------------------------------------------------------------
-void *test_nvme_speed (void *arg)
+// O_DIRECT/aio read benchmark (type 별 block size, queue depth)
+// size_mb 0 : type 기본값, target 0 : 고정 크기 측정
+// target != 0 : window sample 의 신뢰구간이 target 위/아래로 결정되면 바로 종료 (res->verdict)
+// return : MB/s, -1 : benchmark 실패 (storage_test 사용)
+//------------------------------------------------------------------------------
+static int storage_bench_speed (struct m1_item *m1, const char *type, const char *path,
+								int size_mb, int target, struct storage_bench_result *res)
 {
-	struct m1_item *m1 = (struct m1_item *)arg;
-	int speed = 0, retry = TEST_RETRY_COUNT;
+	struct storage_bench_cfg cfg;
+	char json[1024];
+	long t;
+	int ret;
+
+	storage_bench_cfg_default (&cfg, type, path);
+	if (size_mb)
+		cfg.size_mb = size_mb;
+	cfg.target_mbps = target;
+
+	t = trace_now_us ();
+	ret = storage_bench_run (&cfg, res);
+	trace_end ("call", "storage_bench", t, ret ? -1 : res->mbps);
+	if (ret)
+		return -1;
+
+	/* 결과 기록용 (1 line json) */
+	storage_bench_json (&cfg, res, json, sizeof(json));
+	printf ("%s : %s %s\n", __func__, m1->error_str, json);
+	return	res->mbps;
+}
 
-	m1->status = eSTATUS_RUNNING;
+//------------------------------------------------------------------------------
+// eMMC/SATA/NVMe : m1->arg_str = storage type, m1->threshold = MB/s
+// device : m1->dev_path (m1-test.cfg) 또는 /sys/block 에서 type 으로 검색 (없으면 NO DEVICE)
+//------------------------------------------------------------------------------
+void *test_storage_speed (void *arg)
+{
+	struct m1_item *m1 = (struct m1_item *)arg;
+	struct storage_bench_result res;
+	char path[64], str[RESPONSE_STR_SIZE];
+	int speed = 0, retry = m1->retry, errors = 0, slot = m1->item_id - eUI_EMMC_SPEED;
+	long t;
+
+	memset (str,  0, sizeof(str));
+	memset (path, 0, sizeof(path));
+	if (m1->dev_path[0])
+		snprintf (path, sizeof(path), "%s", m1->dev_path);
+	else if (!storage_bench_find (m1->arg_str, path, sizeof(path))) {
+		/* 장착된 device 가 없으면 storage_test 재시도 없이 바로 fail */
+		item_finish (m1, 0, "%s", "NO DEVICE");
+		return arg;
+	}
 
-	while ((retry--) && (speed < DEV_SPEED_NVME)) {
-		memset (m1->response_str, 0x00, RESPONSE_STR_SIZE);
-		speed = storage_test ("nvme", m1->response_str);
+	/* 같은 resource(pcie lane, cpu slot)를 사용하는 측정은 순서대로 실행 */
+	test_sched_acquire (m1->resource);
+	item_set_status (m1, eSTATUS_RUNNING);
+
+	while ((retry--) && (speed < m1->threshold)) {
+		trace_instant ("retry", m1->error_str, ++m1->stat.tries);
+		memset (str, 0x00, sizeof(str));
+		if (path[0] && ((speed = storage_bench_speed (m1, m1->arg_str, path, 0,
+											m1->threshold, &res)) >= 0)) {
+			storage_bench_summary (&res, str, sizeof(str));
+			item_set_response (m1, "%s", str);
+			/* result log 용 window sample, read error 가 있으면 속도와 관계없이 fail */
+			StorageResult[slot]   = res;
+			StorageMeasured[slot] = 1;
+			errors = res.errors;
+			/* PASS/FAIL 이 통계적으로 결정된 경우 재측정 하지 않음 */
+			if (res.verdict != eVERDICT_NONE)
+				break;
+			continue;
+		}
+		t = trace_now_us ();
+		speed = storage_test ((char *)m1->arg_str, str);
+		trace_end ("call", "storage_test", t, speed);
+		item_set_response (m1, "%s", str);
 	}
-	m1->result = speed < DEV_SPEED_NVME ? 0 : 1;
+	if (speed > 0)
+		item_set_value (m1, speed, 0);
+	test_sched_release (m1->resource);
 
-	m1->status = eSTATUS_FINISH;
+	item_finish (m1, (speed >= m1->threshold) && !errors, "%s", str);
 	return arg;
 }
 
 //------------------------------------------------------------------------------
-volatile char IperfTestFlag = 0;
+// net_perf interval 결과 (receiver 측정 기준)를 UI에 바로 표시
+//------------------------------------------------------------------------------
+void iperf_report (int index, int mbps, int lost, void *arg)
+{
+	struct m1_item *m1 = (struct m1_item *)arg;
+
+	printf ("iperf interval : %d, speed = %d Mbits/s, lost = %d\n", index, mbps, lost);
+	item_set_response (m1, "%d MBits/sec", mbps);
+}
 
+//------------------------------------------------------------------------------
+// iperf 진행 중에는 RES_ETH 사용 중이므로 IR 입력에 의한 eth speed 변경을 하지 않음.
+// nlp server의 receiver (m1-server -r) 가 응답하지 않는 경우 iperf3 로 측정.
+// 측정 중 link down(flap)이 발생한 경우 속도와 관계없이 fail 처리.
+//------------------------------------------------------------------------------
 void *test_iperf_speed (void *arg)
 {
 	struct m1_item *m1 = (struct m1_item *)arg;
-	int speed = 0, retry = TEST_RETRY_COUNT * 2;
-
-	m1->status = eSTATUS_RUNNING;
-	IperfTestFlag = 1;
-	// UDP = 3, TCP = 4
-	nlp_server_write   (NlpServerIP, NLP_SERVER_MSG_TYPE_UDP, "start", 0);
-	sleep(1);
-	while ((retry--) && (speed < IPERF_SPEED)) {
-		speed = iperf3_speed_check (NlpServerIP, NLP_SERVER_MSG_TYPE_UDP);
+	struct net_perf_cfg cfg;
+	struct eth_link_state state;
+	unsigned int flaps;
+	int speed = 0, retry = m1->retry;
+	long t;
+
+	/* nlp server 확인 전에는 WAIT 상태 유지 (timeout 은 RUNNING 이후 적용) */
+	wait_network ();
+
+	test_sched_acquire (m1->resource);
+	item_set_status (m1, eSTATUS_RUNNING);
+
+	memset (&state, 0, sizeof(state));
+	eth_link_get (&state);
+	flaps = state.flaps;
+
+	net_perf_cfg_default (&cfg, NlpServerIP, NET_PERF_UDP);
+	cfg.target_mbps = m1->threshold;
+	while ((retry--) && (speed < m1->threshold)) {
+		t = trace_now_us ();
+		speed = net_perf_client (&cfg, iperf_report, m1);
+		trace_end ("call", "net_perf", t, speed);
+		if (speed < 0)
+			break;
+		trace_instant ("retry", m1->error_str, ++m1->stat.tries);
 		printf ("iperf result : retry = %d, speed = %d Mbits/s\n", retry, speed);
 	}
-	sleep(1);
-	nlp_server_write   (NlpServerIP, NLP_SERVER_MSG_TYPE_UDP, "stop", 0);
 
-	memset  (m1->response_str, 0x00, RESPONSE_STR_SIZE);
-	sprintf (m1->response_str, "%d MBits/sec", speed);
-	m1->result = speed > IPERF_SPEED ? 1 : 0;
+	if (speed < 0) {
+		speed = 0;	retry = m1->retry;
+		// UDP = 3, TCP = 4
+		nlp_server_write   (NlpServerIP, NLP_SERVER_MSG_TYPE_UDP, "start", 0);
+		sleep(1);
+		while ((retry--) && (speed < m1->threshold)) {
+			t = trace_now_us ();
+			speed = iperf3_speed_check (NlpServerIP, NLP_SERVER_MSG_TYPE_UDP);
+			trace_end ("call", "iperf3", t, speed);
+			trace_instant ("retry", m1->error_str, ++m1->stat.tries);
+			printf ("iperf result : retry = %d, speed = %d Mbits/s\n", retry, speed);
+		}
+		sleep(1);
+		nlp_server_write   (NlpServerIP, NLP_SERVER_MSG_TYPE_UDP, "stop", 0);
+	}
 
-	IperfTestFlag = 0;
-	m1->status = eSTATUS_FINISH;
+	item_set_value (m1, speed, eth_link_get (&state) ? state.speed : 0);
+	test_sched_release (m1->resource);
+
+	if (eth_link_get (&state) && (state.flaps != flaps)) {
+		printf ("iperf result : link flap detected (%u)\n", state.flaps - flaps);
+		item_finish (m1, 0, "LINK FLAP %u", state.flaps - flaps);
+	} else
+		item_finish (m1, speed > m1->threshold, "%d MBits/sec", speed);
 	return arg;
 }
 
@@ -481,14 +1186,26 @@ void *test_efuse_uuid (void *arg)
 {
 	struct m1_item *m1 = (struct m1_item *)arg;
 
-	m1->status = eSTATUS_RUNNING;
+	/* efuse 에 mac 이 없는 경우 factory server 에서 uuid 를 받아야 하므로 network 대기 */
+	if (!get_efuse_mac (MacStr))
+		wait_network ();
+
+	test_sched_acquire (m1->resource);
+	item_set_status (m1, eSTATUS_RUNNING);
 
 	if (!get_efuse_mac (MacStr)) {
 		char uuid[MAC_SERVER_CTRL_TYPE_UUID_SIZE+1];
+		long t;
+		int ret;
+
 		memset (uuid, 0, sizeof(uuid));
 		// get mac from server (mac server : FACTORY_SERVER | DEV_SERVER)
 		printf ("request uuid from factory server\n");
-		if (get_mac_uuid ("m1", MAC_SERVER_CTRL_TYPE_UUID, uuid, MAC_SERVER_CTRL_FACTORY_SERVER)) {
+		t   = trace_now_us ();
+		ret = (OptSimRoot != NULL) ? hw_sim_mac_uuid (uuid, sizeof(uuid)) :
+			get_mac_uuid ("m1", MAC_SERVER_CTRL_TYPE_UUID, uuid, MAC_SERVER_CTRL_FACTORY_SERVER);
+		trace_end ("call", "get_mac_uuid", t, ret);
+		if (ret) {
 			// write efuse...compare uuid in efuse...
 			printf ("write uuid to efuse\n");
 			if (write_efuse (uuid)) {
@@ -501,24 +1218,54 @@ void *test_efuse_uuid (void *arg)
 				printf ("efuse write fail.");
 		}
 	}
-	memset (m1->response_str, 0x00, RESPONSE_STR_SIZE);
-	if (!strncmp (MacStr, "001e06", strlen("001e06"))) {
-		sprintf (m1->response_str,"00:1e:06:%c%c:%c%c:%c%c",
+	test_sched_release (m1->resource);
+
+	if (!strncmp (MacStr, "001e06", strlen("001e06")))
+		item_finish (m1, 1, "00:1e:06:%c%c:%c%c:%c%c",
 			MacStr[6],	MacStr[7],	MacStr[8],	MacStr[9],	MacStr[10], MacStr[11]);
-		m1->result = 1;
-	} else {
-		sprintf (m1->response_str,"%s", "unknown mac");
-		m1->result = 0;
-	}
+	else
+		item_finish (m1, 0, "%s", "unknown mac");
 
-	m1->status = eSTATUS_FINISH;
+	return arg;
+}
 
+//------------------------------------------------------------------------------
+// multi-tone 재생 후 codec loopback 으로 capture, 1 kHz level / flatness / THD+N 판정.
+// threshold : THD+N 기준 (-dB), 측정값은 -THD+N (dB) 으로 기록.
+//------------------------------------------------------------------------------
+void *test_audio_loopback (void *arg)
+{
+	struct m1_item *m1 = (struct m1_item *)arg;
+	struct audio_result res;
+	char str[RESPONSE_STR_SIZE];
+	int retry = m1->retry, pass = 0;
+	long t;
+
+	test_sched_acquire (m1->resource);
+	item_set_status (m1, eSTATUS_RUNNING);
+
+	memset (&res, 0, sizeof(res));
+	while ((retry--) && !pass) {
+		trace_instant ("retry", m1->error_str, ++m1->stat.tries);
+		t = trace_now_us ();
+		pass = audio_test_run (&res, m1->threshold);
+		trace_end ("call", "audio_test", t, res.verdict);
+		printf ("%s : verdict %d, 1kHz %.1f dBFS, flat %.1f dB, THD+N %.1f dB, %ld ms (analyze %ld us)\n",
+			__func__, res.verdict, res.ref_db, res.flat_db, res.thdn_db, res.elapsed_ms, res.analyze_us);
+	}
+	audio_test_summary (&res, str, sizeof(str));
+	if ((res.verdict == eAUDIO_PASS) || (res.verdict == eAUDIO_THDN))
+		item_set_value (m1, (int)(0.5f - res.thdn_db), 0);
+	test_sched_release (m1->resource);
+
+	item_finish (m1, pass, "%s", str);
 	return arg;
 }
 
 //------------------------------------------------------------------------------
 // apt install evetest
-// /dev/input/event2, /sys/class/input/input2/name = ODROID-M1-FRONT Headphones
+// /sys/class/input/eventX/device/name = ODROID-M1-FRONT Headphones
+// (event 번호는 고정이 아니므로 input_reactor에서 이름으로 찾음)
 //------------------------------------------------------------------------------
 /* 0 : event none, 1 : insert, 2 : remove */
 volatile char HP_Event = 0;
@@ -526,32 +1273,29 @@ volatile char HP_Event = 0;
 void *test_hp_detect (void *arg)
 {
 	struct m1_item *m1 = (struct m1_item *)arg;
+	unsigned int seq = event_notify_seq (&InputNotify);
 
-	memset (m1->response_str, 0x00, sizeof(RESPONSE_STR_SIZE));
-
-	while (m1->status != eSTATUS_FINISH) {
+	while (!EmergencyStop && (m1->status != eSTATUS_FINISH)) {
 		switch(m1->item_id) {
 			case eUI_HP_IN:
-				if (HP_Event == 1) {
-					m1->result = 1;
-					m1->status = eSTATUS_FINISH;
-				}
+				if ((HP_Event == 1) && !item_finish (m1, 1, "%s", ""))
+					return arg;
 			break;
 			case eUI_HP_OUT:
-				if (HP_Event == 2) {
-					m1->result = 1;
-					m1->status = eSTATUS_FINISH;
-				}
+				if ((HP_Event == 2) && !item_finish (m1, 1, "%s", ""))
+					return arg;
 			break;
 		}
-		usleep(1000);
+		/* producer(hp_event_handler)의 event_notify_post까지 대기 (EmergencyStop 확인) */
+		if (m1->status != eSTATUS_FINISH)
+			event_notify_wait (&InputNotify, &seq, INPUT_WAIT_MS);
 	}
 	return arg;
 }
 
 //------------------------------------------------------------------------------
 // apt install evetest
-// /dev/input/event0, /sys/class/input/input0/name = fdd70030.pwm
+// /sys/class/input/eventX/device/name = fdd70030.pwm
 // int change_eth_speed (int speed)
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -561,12 +1305,14 @@ volatile char IR_Event = 0;
 void *test_ir_input (void *arg)
 {
 	struct m1_item *m1 = (struct m1_item *)arg;
-	while (!IR_Event)	sleep(1);
+	unsigned int seq = event_notify_seq (&InputNotify);
+
+	while (!IR_Event && !EmergencyStop)
+		event_notify_wait (&InputNotify, &seq, INPUT_WAIT_MS);
+	if (!IR_Event)
+		return arg;
 
-	memset (m1->response_str, 0x00, sizeof(RESPONSE_STR_SIZE));
-	sprintf (m1->response_str, "%s", "PASS");
-	m1->status = eSTATUS_FINISH;
-	m1->result = 1;
+	item_finish (m1, 1, "%s", "PASS");
 	return arg;
 }
 
@@ -579,29 +1325,28 @@ volatile char IR_ETH_Event = 0;
 void *test_eth_change (void *arg)
 {
 	struct m1_item *m1 = (struct m1_item *)arg;
+	unsigned int seq = event_notify_seq (&InputNotify);
 
-	memset (m1->response_str, 0x00, sizeof(RESPONSE_STR_SIZE));
-
-	while (m1->status != eSTATUS_FINISH) {
+	while (!EmergencyStop && (m1->status != eSTATUS_FINISH)) {
 		switch(m1->item_id) {
 			case eUI_ETH_GREEN:
-				if (IR_ETH_Event == 5)
-					m1->status = eSTATUS_RUNNING;
-				if ((IR_ETH_Event == 1) || (IR_ETH_Event == 2)) {
-					m1->result = (IR_ETH_Event == 2) ? 1 : 0;
-					m1->status = eSTATUS_FINISH;
-				}
+				if ((IR_ETH_Event == 5) && (m1->status != eSTATUS_RUNNING))
+					item_set_status (m1, eSTATUS_RUNNING);
+				if (((IR_ETH_Event == 1) || (IR_ETH_Event == 2)) &&
+					!item_finish (m1, (IR_ETH_Event == 2), "%s", ""))
+					return arg;
 			break;
 			case eUI_ETH_ORANGE:
-				if (IR_ETH_Event == 6)
-					m1->status = eSTATUS_RUNNING;
-				if ((IR_ETH_Event == 3) || (IR_ETH_Event == 4)) {
-					m1->result = (IR_ETH_Event == 4) ? 1 : 0;
-					m1->status = eSTATUS_FINISH;
-				}
+				if ((IR_ETH_Event == 6) && (m1->status != eSTATUS_RUNNING))
+					item_set_status (m1, eSTATUS_RUNNING);
+				if (((IR_ETH_Event == 3) || (IR_ETH_Event == 4)) &&
+					!item_finish (m1, (IR_ETH_Event == 4), "%s", ""))
+					return arg;
 			break;
 		}
-		usleep(100000);
+		/* producer(thread_eth_event)의 event_notify_post까지 대기 (EmergencyStop 확인) */
+		if (m1->status != eSTATUS_FINISH)
+			event_notify_wait (&InputNotify, &seq, INPUT_WAIT_MS);
 	}
 	return arg;
 }
@@ -613,25 +1358,22 @@ volatile char BT_Event = 0;
 void *test_spibt_input (void *arg)
 {
 	struct m1_item *m1 = (struct m1_item *)arg;
+	unsigned int seq = event_notify_seq (&InputNotify);
 
-	memset (m1->response_str, 0x00, sizeof(RESPONSE_STR_SIZE));
-
-	while (m1->status != eSTATUS_FINISH) {
+	while (!EmergencyStop && (m1->status != eSTATUS_FINISH)) {
 		switch(m1->item_id) {
 			case eUI_SPIBT_DN:
-				if (BT_Event == 1) {
-					m1->result = 1;
-					m1->status = eSTATUS_FINISH;
-				}
+				if ((BT_Event == 1) && !item_finish (m1, 1, "%s", ""))
+					return arg;
 			break;
 			case eUI_SPIBT_UP:
-				if (BT_Event == 2) {
-					m1->result = 1;
-					m1->status = eSTATUS_FINISH;
-				}
+				if ((BT_Event == 2) && !item_finish (m1, 1, "%s", ""))
+					return arg;
 			break;
 		}
-		usleep(1000);
+		/* producer(thread_bt_event)의 event_notify_post까지 대기 (EmergencyStop 확인) */
+		if (m1->status != eSTATUS_FINISH)
+			event_notify_wait (&InputNotify, &seq, INPUT_WAIT_MS);
 	}
 	return arg;
 }
@@ -639,18 +1381,15 @@ void *test_spibt_input (void *arg)
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 /*
-	find /sys/devices/platform -name *sd* | grep 8-1 2<&1
-	strstr "/block/sd"
+	usb_hotplug (netlink uevent) 에서 port -> link speed -> block node map 관리.
 	usb detect speed = /sys/bus/usb/devices/{usb_device_name}/speed
-	get node (ptr + 9) = 'a,b,c,d,....'
+	block node = /sys/block/sdX link 중 /{usb_device_name}/ 포함된 node
 	apt install usbutils (lsusb -t...)
 */
 //------------------------------------------------------------------------------
-/* 0 : event none, 1 : BUSY */
-volatile char USB_Event = 0;
+/* usb topology 변경 알림 (usb test thread wakeup) */
+struct event_notify UsbNotify;
 
-const char	*USB_DEVICE_DIR = "/sys/bus/usb/devices";
-const char	*USB_PLATFORM_DIR = "/sys/devices/platform";
 const char	USB_DEVICE_NAME[][4] = {
 	"8-1",	/* usb3.0 port up : detect usb 3.0*/
 	"7-1",	/* usb3.0 port up : detect usb 2.0*/
@@ -663,161 +1402,162 @@ const char	USB_DEVICE_NAME[][4] = {
 };
 
 //------------------------------------------------------------------------------
-#define	USB30_MASS_SPEED	60
-#define	USB20_MASS_SPEED	20
+// USB_DEVICE_NAME index 2개씩 하나의 test item에 해당됨.
+//------------------------------------------------------------------------------
+static int usb_port_item (int port_idx)
+{
+	switch (port_idx) {
+		case 0:	case 1:	return eUI_USB30_UP;
+		case 2:	case 3:	return eUI_USB30_DN;
+		case 4:	case 5:	return eUI_USB20_UP;
+		case 6:	case 7:	return eUI_USB20_DN;
+		default :		return -1;
+	}
+}
+
+//------------------------------------------------------------------------------
+static void usb_port_test (struct m1_item *m1, struct usb_port_info *info)
+{
+	struct storage_bench_result res;
+	char fname[HW_SIM_PATH_SIZE];
+	int speed = -1, usb30 = 0, size_mb;
+
+	usb30 = ((m1->item_id == eUI_USB30_UP) || (m1->item_id == eUI_USB30_DN)) ? 1 : 0;
+
+	/* simulation : {root}/dev/{block} image */
+	memset   (fname, 0x00, sizeof(fname));
+	snprintf (fname, sizeof(fname), "%s/dev/%s", OptSimRoot ? OptSimRoot : "", info->block);
+
+	test_sched_acquire (m1->resource);
+	item_set_status (m1, eSTATUS_RUNNING);
+	if (info->speed > 12) {
+		size_mb = info->speed > (usb30 ? 480 : 12) ? 5 : 1;
+		if ((speed = storage_bench_speed (m1, "usb", fname, size_mb, 0, &res)) < 0) {
+			long t = trace_now_us ();
+			speed = storage_read_test (fname, size_mb);
+			trace_end ("call", "storage_read_test", t, speed);
+		}
+	}
+	test_sched_release (m1->resource);
+	trace_instant ("retry", m1->error_str, ++m1->stat.tries);
+	item_set_value (m1, speed, info->speed);
+	if (speed == -1)
+		item_stop (m1, NULL);
+	else if (speed > m1->threshold)
+		item_finish (m1, 1, "%dM - %d MB/s", info->speed, speed);
+	else
+		item_stop (m1, "%dM - %d MB/s", info->speed, speed);
+}
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 void *test_usb_speed (void *arg)
 {
 	struct m1_item *m1 = (struct m1_item *)arg;
-	int item_cnt, i, usb_prev_check = -1, usb_detect_cnt;;
-	char fname[256];
+	struct usb_port_info info;
+	int item_cnt, i, usb_prev_check = -1;
+	unsigned int seq = event_notify_seq (&UsbNotify);
 
 	item_cnt = sizeof(USB_DEVICE_NAME) / sizeof(USB_DEVICE_NAME[0]);
 
 	while (!EmergencyStop && (m1->status != eSTATUS_FINISH)) {
-		for (i = 0, usb_detect_cnt = 0; i < item_cnt; i++) {
-			memset (fname, 0, sizeof(fname));
-			sprintf (fname, "%s/%s", USB_DEVICE_DIR, USB_DEVICE_NAME[i]);
-			if (access (fname, F_OK) == 0) {
-				FILE *fp;
-				int usb_det_speed = 0;
-
-				usb_detect_cnt++;
-				/* get detect usb speed */
-				memset (fname, 0, sizeof(fname));
-				sprintf (fname, "%s/%s/speed", USB_DEVICE_DIR, USB_DEVICE_NAME[i]);
-				if ((fp = fopen(fname, "r")) != NULL) {
-					memset (fname, 0, sizeof(fname));
-					if (fgets (fname, sizeof(fname), fp) != NULL)
-						usb_det_speed = atoi(fname);
-					fclose (fp);
-				}
-				/* find block node for usb mass */
-				memset (fname, 0, sizeof(fname));
-				sprintf (fname, "find %s -name *sd* | grep %s 2<&1",
-						USB_PLATFORM_DIR, USB_DEVICE_NAME[i]);
-
-				if ((fp = popen(fname, "r")) != NULL) {
-					int speed = -1;
-
-					memset (fname, 0x00, sizeof(fname));
-					if (fgets (fname, sizeof(fname), fp) != NULL) {
-						char *str = strstr (fname, "/block/sd"), node = str[9];
-						memset (fname, 0x00, sizeof(fname));
-						sprintf (fname, "/dev/sd%c", node);
-					}
-					pclose (fp);
-					if (strncmp(fname, "/dev/sd", strlen("/dev/sd")))
-						continue;
-
-					if (usb_prev_check == i)
-						continue;
-
-					usb_prev_check = i;
-					switch (i) {
-						case 0:	case 1:
-							if (m1->item_id == eUI_USB30_UP) {
-								m1->status = eSTATUS_RUNNING;
-								if (usb_det_speed > 12)
-									speed = storage_read_test (fname, usb_det_speed > 480 ? 5 : 1);
-								m1->result = (speed > USB30_MASS_SPEED) ? 1 : 0;
-								m1->status = m1->result ? eSTATUS_FINISH : eSTATUS_STOP;
-								if (speed != -1) {
-									memset  (m1->response_str, 0x00, RESPONSE_STR_SIZE);
-									sprintf (m1->response_str, "%dM - %d MB/s", usb_det_speed, speed);
-								}
-							}
-						break;
-						case 2:	case 3:
-							if (m1->item_id == eUI_USB30_DN) {
-								m1->status = eSTATUS_RUNNING;
-								if (usb_det_speed > 12)
-									speed = storage_read_test (fname, usb_det_speed > 480 ? 5 : 1);
-								m1->result = (speed > USB30_MASS_SPEED) ? 1 : 0;
-								m1->status = m1->result ? eSTATUS_FINISH : eSTATUS_STOP;
-								if (speed != -1) {
-									memset  (m1->response_str, 0x00, RESPONSE_STR_SIZE);
-									sprintf (m1->response_str, "%dM - %d MB/s", usb_det_speed, speed);
-								}
-							}
-						break;
-						case 4:	case 5:
-							if (m1->item_id == eUI_USB20_UP) {
-								m1->status = eSTATUS_RUNNING;
-								if (usb_det_speed > 12)
-									speed = storage_read_test (fname, usb_det_speed > 12 ? 5 : 1);
-								m1->result = (speed > USB20_MASS_SPEED) ? 1 : 0;
-								m1->status = m1->result ? eSTATUS_FINISH : eSTATUS_STOP;
-								if (speed != -1) {
-									memset  (m1->response_str, 0x00, RESPONSE_STR_SIZE);
-									sprintf (m1->response_str, "%dM - %d MB/s", usb_det_speed, speed);
-								}
-							}
-						break;
-						case 6:	case 7:
-							if (m1->item_id == eUI_USB20_DN) {
-								m1->status = eSTATUS_RUNNING;
-								if (usb_det_speed > 12)
-									speed = storage_read_test (fname, usb_det_speed > 12 ? 5 : 1);
-								m1->result = (speed > USB20_MASS_SPEED) ? 1 : 0;
-								m1->status = m1->result ? eSTATUS_FINISH : eSTATUS_STOP;
-								if (speed != -1) {
-									memset  (m1->response_str, 0x00, RESPONSE_STR_SIZE);
-									sprintf (m1->response_str, "%dM - %d MB/s", usb_det_speed, speed);
-								}
-							}
-						break;
-						default :
-						break;
-					}
-				}
-			}
+		for (i = 0; i < item_cnt; i++) {
+			if (usb_port_item (i) != m1->item_id)
+				continue;
+			if (!usb_hotplug_get (i, &info) || !info.present || !info.block[0])
+				continue;
+			if (usb_prev_check == i)
+				continue;
+
+			usb_prev_check = i;
+			usb_port_test (m1, &info);
+			break;
 		}
 		// remove all usb port
-		if (!usb_detect_cnt)
+		if (!usb_hotplug_present_cnt ())
 			usb_prev_check = -1;
-		usleep(1000);
+
+		/* usb_hotplug thread에서 topology 변경 시 wakeup (EmergencyStop 확인을 위하여 1초 timeout) */
+		if (m1->status != eSTATUS_FINISH)
+			event_notify_wait (&UsbNotify, &seq, 1000);
 	}
 	return	arg;
 }
 
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+void fb_damage (int x, int y, int w, int h, void *arg)
+{
+	fb_compose_damage ((struct fb_compose *)arg, x, y, w, h);
+}
+
+//------------------------------------------------------------------------------
+void fb_present (void)
+{
+	if (FbVisibleData != NULL)
+		fb_compose_present (&FbCompose);
+}
+
+//------------------------------------------------------------------------------
+// 변경된 box 갱신 (HDMI test 의 pattern 기록 중에는 FbLock 대기)
+//------------------------------------------------------------------------------
+void ui_refresh (fb_info_t *pfb, ui_grp_t *pui)
+{
+	pthread_mutex_lock (&FbLock);
+	if (ui_dirty_flush (pfb, pui))
+		fb_present ();
+	pthread_mutex_unlock (&FbLock);
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 #define	TIMEOVER_COUNT	90
+#define	UI_TICK_MS		500
 
 void *thread_ui_update (void *arg)
 {
 	struct m1_server *m1_server = (struct m1_server *)arg;
 	int i, timeover = TIMEOVER_COUNT, fin_cnt, loop_cnt = 0;;
+	int item_changed = 1, tick = 1;
+	unsigned int seq = event_notify_seq (&ItemNotify);
+	struct timeval tick_time;
+	unsigned long pixel_rate, pixel_rate_last = 0;
 
 	/* default status */
-	ui_set_sitem (m1_server->pfb, m1_server->pui, 47, -1, -1, "WAIT");
-	ui_set_ritem (m1_server->pfb, m1_server->pui, 47, COLOR_GRAY, -1);
+	ui_dirty_sitem (47, "WAIT");
+	ui_dirty_ritem (47, COLOR_GRAY);
+
+	run_interval_check (&tick_time, 0);
 
 	while (!EmergencyStop && timeover) {
 		for (i = 0, fin_cnt = 0; i < eUI_ITEM_END; i++) {
-			if (m1_server->items[i].status != eSTATUS_WAIT) {
+			if (item_changed && (m1_server->items[i].status != eSTATUS_WAIT)) {
 				switch (m1_server->items[i].status) {
 					case eSTATUS_RUNNING:
-						ui_set_ritem (m1_server->pfb, m1_server->pui,
-							m1_server->items[i].ui_id, COLOR_YELLOW, -1);
+						ui_dirty_ritem (m1_server->items[i].ui_id, COLOR_YELLOW);
+						/* 측정 중간 결과 표시 (iperf interval) */
+						if (m1_server->items[i].response_str[0] != 0) {
+							ui_dirty_sitem (m1_server->items[i].ui_id,
+								m1_server->items[i].response_str);
+						}
+					break;
+					case eSTATUS_SKIP:
+						ui_dirty_ritem (m1_server->items[i].ui_id, COLOR_GRAY);
+						ui_dirty_sitem (m1_server->items[i].ui_id, "SKIP");
 					break;
 					case eSTATUS_STOP:
 					case eSTATUS_FINISH:
-						ui_set_ritem (m1_server->pfb, m1_server->pui,
-							m1_server->items[i].ui_id,
-							m1_server->items[i].result ? COLOR_GREEN : COLOR_RED, -1);
+						ui_dirty_ritem (m1_server->items[i].ui_id,
+							m1_server->items[i].result ? COLOR_GREEN : COLOR_RED);
 						if (m1_server->items[i].response_str[0] != 0) {
-							ui_set_sitem (m1_server->pfb, m1_server->pui,
-								m1_server->items[i].ui_id, -1, -1,
+							ui_dirty_sitem (m1_server->items[i].ui_id,
 								m1_server->items[i].response_str);
 						}
 					break;
 				}
 			}
-			if (m1_server->items[i].status == eSTATUS_FINISH)
+			if ((m1_server->items[i].status == eSTATUS_FINISH) ||
+				(m1_server->items[i].status == eSTATUS_SKIP))
 				fin_cnt++;
 		}
 
@@ -830,249 +1570,361 @@ void *thread_ui_update (void *arg)
 						printf ("%s : item err = %s\n", __func__, m1_server->items[i].error_str);
 					}
 				}
-				ui_set_sitem (m1_server->pfb, m1_server->pui, 47, -1, -1, "FINISH");
-				ui_set_ritem (m1_server->pfb, m1_server->pui, 47,
-										error_cnt ? COLOR_RED : COLOR_GREEN, -1);
+				printf ("%s : cycle time = %ld ms (first result %ld ms, network ready %ld ms)\n",
+					__func__, cycle_time_ms (), FirstResultMs, NetReadyMs);
+				ui_dirty_sitem (47, "FINISH");
+				ui_dirty_ritem (47, error_cnt ? COLOR_RED : COLOR_GREEN);
 				break;
-			} else {
+			} else if (tick) {
 				char status_msg[32];
 				memset  (status_msg, 0x00, sizeof(status_msg));
 				sprintf (status_msg, "RUNNING - %d", timeover);
-				ui_set_sitem (m1_server->pfb, m1_server->pui, 47, -1, -1, status_msg);
-				ui_set_ritem (m1_server->pfb, m1_server->pui, 47,
-					((loop_cnt % 2) == 0) ? RUN_BOX_ON : RUN_BOX_OFF, -1);
-				ui_update (m1_server->pfb, m1_server->pui, -1);
+				ui_dirty_sitem (47, status_msg);
+				ui_dirty_ritem (47, ((loop_cnt % 2) == 0) ? RUN_BOX_ON : RUN_BOX_OFF);
 			}
 		}
-		if ((loop_cnt++ % 2) == 0)
+		if (tick && ((loop_cnt++ % 2) == 0)) {
 			timeover--;
+			item_timeout_check ();
+		}
 
-		usleep(500000);
+		/* fb write pixels/sec : 값이 바뀐 경우만 trace counter 기록 (idle 중 event 누적 방지) */
+		if (tick && ((pixel_rate = ui_dirty_pixel_rate ()) != pixel_rate_last)) {
+			trace_counter ("ui", "fb_pixels_per_sec", trace_now_us (), (long)pixel_rate);
+			pixel_rate_last = pixel_rate;
+#if defined(__DEBUG_APP__)
+			printf ("%s : fb write %lu pixels/sec\n", __func__, pixel_rate);
+#endif
+		}
+		/*
+			변경된 box만 갱신 (UI_DIRTY_FRAME_MS 단위로 모아서 처리).
+			item status가 변경되면 즉시 wakeup하여 화면 갱신.
+			변경이 없는 경우 STATUS(47) box의 blink/countdown을 위하여 UI_TICK_MS 마다 wakeup.
+		*/
+		ui_refresh (m1_server->pfb, m1_server->pui);
+		item_changed = event_notify_wait (&ItemNotify, &seq,
+			ui_dirty_pending () ? UI_DIRTY_FRAME_MS : UI_TICK_MS);
+		tick = run_interval_check (&tick_time, UI_TICK_MS);
 	}
 
-	macaddr_print ();	errcode_print ();
+	CycleMs = cycle_time_ms ();
+	macaddr_print ();	errcode_print ();	result_report ();
+	result_log_save ();	trace_save ();
+	{
+		struct ui_cache_stat st;
+
+		ui_cache_get_stat (&st);
+		printf ("%s : ui cache hit %lu, recolor %lu, miss %lu, evict %lu (%d entries, %ld KB)\n",
+			__func__, st.hit, st.recolor, st.miss, st.evict, st.entries, st.bytes / 1024);
+	}
+	CycleDone = 1;
+	event_notify_post (&CycleNotify);
 
 	if (EmergencyStop || !timeover) {
-		ui_set_sitem (m1_server->pfb, m1_server->pui, 47, -1, -1, "STOP");
-		ui_set_ritem (m1_server->pfb, m1_server->pui, 47, COLOR_RED, -1);
+		ui_dirty_sitem (47, "STOP");
+		ui_dirty_ritem (47, COLOR_RED);
 	}
 
 	while (1) {
 		EmergencyStop = 1;
-		fprintf(stdout, "%s finish...\n", __func__);
+		fprintf(stdout, "%s finish... (fb write total %lu pixels, present avg %lu us, max %lu us)\n",
+			__func__, ui_dirty_pixel_total (), fb_compose_avg_us (&FbCompose), FbCompose.max_us);
 		fflush (stdout);
 		sleep(1);
-		ui_update (m1_server->pfb, m1_server->pui, -1);
+		/* 마지막 STOP/FINISH 표시 이후 변경이 없으므로 전체 화면 갱신은 하지 않음 */
+		ui_refresh (m1_server->pfb, m1_server->pui);
 	}
 	return arg;
 }
 
 //------------------------------------------------------------------------------
-void bootup_test (fb_info_t *pfb, ui_grp_t *pui)
+//------------------------------------------------------------------------------
+// network 이 필요한 test (iperf, factory server uuid) 는 bootstrap 완료 후 진행
+// return 1 : network ready, 0 : EmergencyStop
+//------------------------------------------------------------------------------
+int wait_network (void)
 {
-	int retry;
+	unsigned int seq = event_notify_seq (&NetNotify);
+
+	while (!NetReady && !EmergencyStop)
+		event_notify_wait (&NetNotify, &seq, 1000);
 
-	memset (BoardIP, 0, sizeof(BoardIP));
-	memset (NlpServerIP, 0, sizeof(NlpServerIP));
-	memset (MacStr, 0, sizeof(MacStr));
+	return	NetReady;
+}
 
-	/* default network speed GBits/sec */
+//------------------------------------------------------------------------------
+// eth speed 설정 -> board ip (dhcp) -> nlp server 검색. local test 와 동시에 실행.
+//------------------------------------------------------------------------------
+/* board ip / nlp server 확인 재시도 간격 (실패 시 2배씩 증가) */
+#define	NLP_FIND_BACKOFF_MS		250
+#define	NLP_FIND_BACKOFF_MAX_MS	4000
+
+void *thread_net_bootstrap (void *arg)
+{
+	int retry = 0, backoff = NLP_FIND_BACKOFF_MS;
+	long t;
+
+	/* default network speed GBits/sec (IR 입력에 의한 speed 변경과 겹치지 않도록) */
+	test_sched_acquire (RES_ETH);
 	change_eth_speed (1000);
+	test_sched_release (RES_ETH);
+
+	/* RTM_NEWADDR (dhcp 완료) 시 바로 확인, 1초 마다 화면 표시 갱신 */
+	/* simulation : loopback 의 net_perf/report receiver 사용 */
+	if (OptSimRoot != NULL) {
+		sprintf (BoardIP,     "%s", "127.0.0.1");
+		sprintf (NlpServerIP, "%s", "127.0.0.1");
+	}
 
-	while (!get_my_ip (BoardIP)) {
+	t = trace_now_us ();
+	while ((OptSimRoot == NULL) && !get_my_ip (BoardIP)) {
 		memset (BoardIP, 0, sizeof(BoardIP));
 		sprintf(BoardIP, "%s", "Network Error!");
-		ui_set_sitem (pfb, pui, 4, -1, -1, BoardIP);
-		ui_set_ritem (pfb, pui, 4, (retry++ % 2)
-			? COLOR_RED : COLOR_DIM_GRAY, -1);
-		sleep(1);
+		ui_dirty_sitem (4, BoardIP);
+		ui_dirty_ritem (4, (retry++ % 2)
+			? COLOR_RED : COLOR_DIM_GRAY);
+		if (EmergencyStop)
+			return arg;
+		/* 주소가 이미 있는데 get_my_ip 가 실패하면 바로 return 하므로 backoff 필요 */
+		if (eth_link_wait_addr (1000)) {
+			usleep (backoff * 1000);
+			backoff = (backoff * 2 > NLP_FIND_BACKOFF_MAX_MS)
+				? NLP_FIND_BACKOFF_MAX_MS : backoff * 2;
+		}
 	}
-	ui_set_sitem (pfb, pui, 4, -1, -1, BoardIP);
-	ui_set_ritem (pfb, pui, 4, COLOR_GREEN, -1);
+	backoff = NLP_FIND_BACKOFF_MS;
+	ui_dirty_sitem (4, BoardIP);
+	ui_dirty_ritem (4, COLOR_GREEN);
+	trace_end ("boot", "board_ip", t, retry);
 
-	while (!nlp_server_find (NlpServerIP)) {
+	t = trace_now_us ();
+	while ((OptSimRoot == NULL) && !nlp_server_find (NlpServerIP)) {
 		memset (NlpServerIP, 0, sizeof(NlpServerIP));
 		sprintf(NlpServerIP, "%s", "Network Error!");
-		ui_set_sitem (pfb, pui, 24, -1, -1, NlpServerIP);
-		ui_set_ritem (pfb, pui, 24, (retry++ % 2)
-			? COLOR_RED : COLOR_DIM_GRAY, -1);
-		sleep(1);
+		ui_dirty_sitem (24, NlpServerIP);
+		ui_dirty_ritem (24, (retry++ % 2)
+			? COLOR_RED : COLOR_DIM_GRAY);
+		if (EmergencyStop)
+			return arg;
+		/* server 가 늦게 뜨는 경우 빠르게 재시도, 계속 없으면 간격을 늘림 */
+		usleep (backoff * 1000);
+		backoff = (backoff * 2 > NLP_FIND_BACKOFF_MAX_MS)
+			? NLP_FIND_BACKOFF_MAX_MS : backoff * 2;
 	}
-	ui_set_sitem (pfb, pui, 24, -1, -1, NlpServerIP);
-	ui_set_ritem (pfb, pui, 24, COLOR_GREEN, -1);
-
-	// thread run
-	M1_Items[eUI_FB_SIZE].status = eSTATUS_RUNNING;
-	memset  (M1_Items[eUI_FB_SIZE].response_str, 0x00, RESPONSE_STR_SIZE);
-	sprintf (M1_Items[eUI_FB_SIZE].response_str, "%d x %d", pfb->w, pfb->h);
-	if ((pfb->w != 1920) || (pfb->h != 1080))
-		M1_Items[eUI_FB_SIZE].result = 0;
-	else
-		M1_Items[eUI_FB_SIZE].result = 1;
-	M1_Items[eUI_FB_SIZE].status = eSTATUS_FINISH;
-
+	ui_dirty_sitem (24, NlpServerIP);
+	ui_dirty_ritem (24, COLOR_GREEN);
+	trace_end ("boot", "nlp_server_find", t, retry);
+	report_queue_server (NlpServerIP, OptReport ? REPORT_PORT : 0);
+
+	NetReadyMs = cycle_time_ms ();
+	NetReady   = 1;
+	event_notify_post (&NetNotify);
+	printf ("%s : board ip = %s, nlp server = %s (%ld ms)\n", __func__,
+		BoardIP, NlpServerIP, NetReadyMs);
+	return arg;
 }
 
 //------------------------------------------------------------------------------
-void test_thread_run (void)
+// m1-test.cfg 'T' command
+// T(cmd), 이름(error_str), 실행(enable), 아이디(ui_id), 기준값(threshold), 재시도(retry),
+// 시간제한(timeout sec), 필요장치(dev_path, '-' = 없음)
+// m1-test.cfg 'M' command (memory test)
+// M(cmd), 비율(free memory %), 시간제한(ms), write, read, copy, triad 기준값(MB/s, 0 = 판정 안함)
+// m1-test.cfg 'C' command (cpu load test)
+// C(cmd), 부하시간(ms), sample 주기(ms), throttling 기준(최대 clock %), core 편차 기준(중앙값 %)
+//------------------------------------------------------------------------------
+int test_registry_load (const char *cfg_fname)
 {
-	pthread_t thread_iperf, thread_efuse;
-	pthread_t thread_board_mem, thread_emmc, thread_sata, thread_nvme;
-	pthread_t thread_hp_in, thread_hp_out, thread_ir_input;
-	pthread_t thread_eth_green, thread_eth_orange;
-	pthread_t thread_spibt_up, thread_spibt_dn;
-	pthread_t thread_usb30_up, thread_usb30_dn, thread_usb20_up, thread_usb20_dn;
-
-	pthread_create (&thread_efuse, NULL, test_efuse_uuid,  &M1_Items[eUI_EFUSE_UUIDD]);
-	pthread_create (&thread_iperf, NULL, test_iperf_speed, &M1_Items[eUI_IPERF_SPEED]);
+	FILE *fp;
+	char line[256], name[ERROR_STR_SIZE+1], dev_path[DEV_PATH_SIZE];
+	int i, enable, ui_id, threshold, retry, timeout, cnt = 0;
 
-	pthread_create (&thread_board_mem, NULL, test_board_mem,  &M1_Items[eUI_BOARD_MEM]);
-	pthread_create (&thread_emmc, NULL, test_emmc_speed, &M1_Items[eUI_EMMC_SPEED]);
-	pthread_create (&thread_sata, NULL, test_sata_speed, &M1_Items[eUI_SATA_SPEED]);
-	pthread_create (&thread_nvme, NULL, test_nvme_speed, &M1_Items[eUI_NVME_SPEED]);
+	if ((fp = fopen (cfg_fname, "r")) == NULL) {
+		printf ("%s : %s not found. default registry used.\n", __func__, cfg_fname);
+		return 0;
+	}
+	while (fgets (line, sizeof(line), fp) != NULL) {
+		if (line[0] == 'M') {
+			struct mem_test_cfg mc = MemCfg;
+
+			if (sscanf (line, "M, %d, %d, %d, %d, %d, %d", &mc.percent, &mc.budget_ms,
+				&mc.bw_min[eMEM_BW_WRITE], &mc.bw_min[eMEM_BW_READ],
+				&mc.bw_min[eMEM_BW_COPY], &mc.bw_min[eMEM_BW_TRIAD]) == 6)
+				MemCfg = mc;
+			continue;
+		}
+		if (line[0] == 'C') {
+			struct cpu_test_cfg cc = CpuCfg;
 
-	pthread_create (&thread_hp_in,  NULL, test_hp_detect, &M1_Items[eUI_HP_IN]);
-	pthread_create (&thread_hp_out, NULL, test_hp_detect, &M1_Items[eUI_HP_OUT]);
+			if (sscanf (line, "C, %d, %d, %d, %d", &cc.run_ms, &cc.sample_ms,
+				&cc.throttle_pct, &cc.balance_pct) == 4)
+				CpuCfg = cc;
+			continue;
+		}
+		if (line[0] != 'T')
+			continue;
+
+		memset (name, 0, sizeof(name));
+		memset (dev_path, 0, sizeof(dev_path));
+		if (sscanf (line, "T, %8[^,], %d, %d, %d, %d, %d, %63s",
+			name, &enable, &ui_id, &threshold, &retry, &timeout, dev_path) != 7)
+			continue;
+		/* 이름 정렬용 공백 제거 */
+		for (i = strlen (name) - 1; (i >= 0) && (name[i] == ' '); i--)
+			name[i] = 0;
+
+		for (i = 0; i < eUI_ITEM_END; i++) {
+			struct m1_item *m1 = &M1_Items[i];
+
+			if (strcmp (m1->error_str, name))
+				continue;
+			m1->enable    = enable ? 1 : 0;
+			m1->ui_id     = ui_id;
+			m1->threshold = threshold;
+			m1->retry     = retry > 0 ? retry : 1;
+			m1->timeout   = timeout;
+			memset (m1->dev_path, 0, DEV_PATH_SIZE);
+			if (strcmp (dev_path, "-"))
+				strncpy (m1->dev_path, dev_path, DEV_PATH_SIZE -1);
+			cnt++;
+			break;
+		}
+	}
+	fclose (fp);
+	printf ("%s : %s, %d items loaded.\n", __func__, cfg_fname, cnt);
+	return cnt;
+}
 
-	pthread_create (&thread_ir_input, NULL, test_ir_input, &M1_Items[eUI_IR_INPUT]);
+//------------------------------------------------------------------------------
+// disable 된 test는 thread 생성없이 SKIP, 필요장치가 없는 경우 측정없이 바로 fail.
+//------------------------------------------------------------------------------
+void test_thread_run (void)
+{
+	static pthread_t test_threads[eUI_ITEM_END];
+	pthread_attr_t attr;
+	int i;
 
-	pthread_create (&thread_eth_green,  NULL, test_eth_change, &M1_Items[eUI_ETH_GREEN]);
-	pthread_create (&thread_eth_orange, NULL, test_eth_change, &M1_Items[eUI_ETH_ORANGE]);
+	/* test thread는 UI/input core(SCHED_UI_CPU)를 제외한 core에서 실행 */
+	pthread_attr_init (&attr);
+	test_sched_attr (&attr, 1);
 
-	pthread_create (&thread_spibt_up, NULL, test_spibt_input, &M1_Items[eUI_SPIBT_UP]);
-	pthread_create (&thread_spibt_dn, NULL, test_spibt_input, &M1_Items[eUI_SPIBT_DN]);
+	for (i = 0; i < eUI_ITEM_END; i++) {
+		struct m1_item *m1 = &M1_Items[i];
 
-	pthread_create (&thread_usb30_up, NULL, test_usb_speed, &M1_Items[eUI_USB30_UP]);
-	pthread_create (&thread_usb30_dn, NULL, test_usb_speed, &M1_Items[eUI_USB30_DN]);
-	pthread_create (&thread_usb20_up, NULL, test_usb_speed, &M1_Items[eUI_USB20_UP]);
-	pthread_create (&thread_usb20_dn, NULL, test_usb_speed, &M1_Items[eUI_USB20_DN]);
+		if (!m1->enable) {
+			m1->result = 1;
+			item_set_status (m1, eSTATUS_SKIP);
+			continue;
+		}
+		if (m1->func == NULL)
+			continue;
 
-	#if 0
-	test_iperf_speed (&M1_Items[eUI_IPERF_SPEED]);
-	#endif
+		if (m1->dev_path[0] && (access (m1->dev_path, F_OK) != 0)) {
+			item_finish (m1, 0, "%s", "NO DEVICE");
+			continue;
+		}
+		pthread_create (&test_threads[i], &attr, m1->func, m1);
+	}
+	pthread_attr_destroy (&attr);
 }
 
 //------------------------------------------------------------------------------
-void *thread_ir_event (void *arg)
-{
-	struct input_event event;
+#define	INPUT_NAME_IR	"fdd70030.pwm"
+#define	INPUT_NAME_HP	"ODROID-M1-FRONT Headphones"
 
-	struct timeval  timeout;
-	fd_set readFds;
-	static int fd = -1, green_test = 0, orange_test = 0;
+/* 0 : request none, 100 : 100Mbps(GREEN), 1000 : 1Gbps(ORANGE) */
+volatile int EthSpeedReq = 0;
+volatile char EthGreenTest = 0, EthOrangeTest = 0;
 
-	if ((fd = open("/dev/input/event0", O_RDONLY)) < 0) {
-		printf ("%s : /dev/input/event0 open error!\n", __func__);
-		return arg;
+//------------------------------------------------------------------------------
+// input_reactor thread context에서 호출되므로 blocking 작업(ethtool)은
+// thread_eth_event로 넘기고 바로 return 한다.
+//------------------------------------------------------------------------------
+void ir_event_handler (const struct input_event *event, void *arg)
+{
+	(void)arg;
+
+	if (event->type != EV_KEY)
+		return;
+
+	IR_Event = 1;
+	switch (event->code) {
+		/* emergency stop */
+		case	KEY_HOME:
+			EmergencyStop = 1;
+			printf ("%s : EmergencyStop!!\n", __func__);
+		break;
+		case	KEY_VOLUMEDOWN:
+			if (EthGreenTest || test_sched_busy (RES_ETH) || EthSpeedReq)
+				break;
+			EthGreenTest = 1;	IR_ETH_Event = 5;	EthSpeedReq = 100;
+		break;
+		case	KEY_VOLUMEUP:
+			if (!EthGreenTest || EthOrangeTest || test_sched_busy (RES_ETH) || EthSpeedReq)
+				break;
+			EthOrangeTest = 1;	IR_ETH_Event = 6;	EthSpeedReq = 1000;
+		break;
+		default :
+		break;
 	}
-	printf("%s fd = %d\n", __func__, fd);
+#if defined(__DEBUG_APP__)
+	printf ("%s : code = %d, value = %d, latency = %ld us\n", __func__,
+		event->code, event->value, input_reactor_latency_us (event));
+#endif
+	event_notify_post (&InputNotify);
+}
 
-	while (!EmergencyStop) {
-		// recive time out config
-		// Set 1ms timeout counter
-		timeout.tv_sec  = 0;
-		// timeout.tv_usec = timeout_ms*1000;
-		timeout.tv_usec = 100000;
-
-		FD_ZERO(&readFds);
-		FD_SET(fd, &readFds);
-		select(fd+1, &readFds, NULL, NULL, &timeout);
-
-		if(FD_ISSET(fd, &readFds))
-		{
-			if(fd && read(fd, &event, sizeof(struct input_event))) {
-				int changed = -1;
-				switch (event.type) {
-					case	EV_SYN:
-						break;
-					case	EV_KEY:
-						IR_Event = 1;
-						switch (event.code) {
-							/* emergency stop */
-							case	KEY_HOME:
-								EmergencyStop = 1;
-								printf ("%s : EmergencyStop!!\n", __func__);
-							break;
-							case	KEY_VOLUMEDOWN:
-								if (green_test || IperfTestFlag)
-									break;
-								IR_ETH_Event = 5;
-								if ((changed = change_eth_speed(100)) != -1) {
-									green_test = 1;
-									IR_ETH_Event = changed ? 2 : 1;
-								}
-							break;
-							case	KEY_VOLUMEUP:
-								if (!green_test || orange_test || IperfTestFlag)
-									break;
-								IR_ETH_Event = 6;
-								if ((changed = change_eth_speed(1000)) != -1) {
-									orange_test = 1;
-									IR_ETH_Event = changed ? 4 : 3;
-								}
-							break;
-							default :
-							break;
-						}
-						break;
-					default	:
-						IR_Event = 0;
-						printf("unknown event\n");
-						break;
-				}
-			}
-		}
-		usleep(100000);
+//------------------------------------------------------------------------------
+void hp_event_handler (const struct input_event *event, void *arg)
+{
+	(void)arg;
+
+	if (event->type != EV_SW)
+		return;
+
+	switch (event->code) {
+		case	SW_HEADPHONE_INSERT:
+			HP_Event = event->value ? 1 : 2;
+		break;
+		default :
+			HP_Event = 0;
+		break;
 	}
-	return arg;
+#if defined(__DEBUG_APP__)
+	printf ("%s : code = %d, value = %d, latency = %ld us\n", __func__,
+		event->code, event->value, input_reactor_latency_us (event));
+#endif
+	event_notify_post (&InputNotify);
 }
 
 //------------------------------------------------------------------------------
-void *thread_hp_event (void *arg)
+void *thread_eth_event (void *arg)
 {
-	struct input_event event;
-	struct timeval  timeout;
-	fd_set readFds;
-	int fd;
-
-	if ((fd = open("/dev/input/event2", O_RDONLY)) < 0) {
-		printf ("%s : /dev/input/event2 open error!\n", __func__);
-		return arg;
-	}
-	printf("%s fd = %d\n", __func__, fd);
+	unsigned int seq = event_notify_seq (&InputNotify);
+	int speed, changed;
 
 	while (!EmergencyStop) {
-		// recive time out config
-		// Set 1ms timeout counter
-		timeout.tv_sec  = 0;
-		// timeout.tv_usec = timeout_ms*1000;
-		timeout.tv_usec = 100000;
-
-		FD_ZERO(&readFds);
-		FD_SET(fd, &readFds);
-		select(fd+1, &readFds, NULL, NULL, &timeout);
-
-		if(FD_ISSET(fd, &readFds)) {
-			if(fd && read(fd, &event, sizeof(struct input_event))) {
-				switch (event.type) {
-					case	EV_SYN:
-						break;
-					case	EV_SW:
-						switch (event.code) {
-							case	SW_HEADPHONE_INSERT:
-								HP_Event = event.value ? 1 : 2;
-							break;
-							default :
-								HP_Event = 0;
-							break;
-						}
-						break;
-					default	:
-						break;
-				}
-			}
+		if (!(speed = EthSpeedReq)) {
+			event_notify_wait (&InputNotify, &seq, 1000);
+			continue;
 		}
-		usleep(1000);
+		/* -1 : 이미 요청 속도인 경우 test를 진행하지 않음 (key 재입력 가능) */
+		test_sched_acquire (RES_ETH);
+		changed = change_eth_speed (speed);
+		test_sched_release (RES_ETH);
+		if (changed != -1) {
+			if (speed == 100)
+				IR_ETH_Event = changed ? 2 : 1;
+			else
+				IR_ETH_Event = changed ? 4 : 3;
+		} else {
+			if (speed == 100)
+				EthGreenTest  = 0;
+			else
+				EthOrangeTest = 0;
+		}
+		EthSpeedReq = 0;
+		event_notify_post (&InputNotify);
 	}
 	return arg;
 }
@@ -1091,65 +1943,556 @@ void *thread_bt_event (void *arg)
 				// key_press wait
 				if(get_efuse_mac(mac_str) == 0) {
 					bt_state = 1;	BT_Event = 1;
+					event_notify_post (&InputNotify);
 				}
 			break;
 			case	1:
 				// key_release wait
 				if(get_efuse_mac(mac_str) == 1) {
 					bt_state = 2;	BT_Event = 2;
+					event_notify_post (&InputNotify);
 				}
 			break;
 			default	:
 			break;
 		}
-		usleep(200000);
+		/* uuid attribute 는 fd 유지 (pread), 변경 notify 미지원시 200ms 후 return */
+		efuse_uuid_wait (200);
+	}
+	return arg;
+}
+
+//------------------------------------------------------------------------------
+static void *thread_report_server (void *arg)
+{
+	report_server (REPORT_PORT, (volatile char *)arg);
+	return arg;
+}
+
+//------------------------------------------------------------------------------
+static void *thread_net_perf_server (void *arg)
+{
+	net_perf_server (NET_PERF_PORT, (volatile char *)arg);
+	return arg;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+/*
+	hardware simulation (-s sim_root, -B)
+	fake sysfs (usb), block image (emmc/sata/nvme/usb), memory framebuffer,
+	uinput (IR/HP), efuse image, loopback net_perf/report receiver, nlp/mac server stand-in.
+	SPI button 은 efuse uuid 로 확인하므로 efuse 기록 전(DN)/후(UP) 로 처리됨.
+*/
+//------------------------------------------------------------------------------
+#define	SIM_STORAGE_MB		32
+#define	SIM_USB_MB			16
+/* script 의 item 별 대기 시간 (ms) */
+#define	SIM_WAIT_MS			(TIMEOVER_COUNT * 1000)
+
+struct sim_usb {
+	const char	*port;
+	int			speed;
+	const char	*block;
+	int			item_id;
+};
+
+static const struct sim_usb SimUsb[] = {
+	{ "8-1", 5000, "sda", eUI_USB30_UP },
+	{ "6-1", 5000, "sdb", eUI_USB30_DN },
+	{ "1-1",  480, "sdc", eUI_USB20_UP },
+	{ "2-1",  480, "sdd", eUI_USB20_DN },
+};
+
+/* uinput fd, -1 : input_reactor 를 거치지 않고 handler 직접 호출 */
+int SimIrFd = -1, SimHpFd = -1;
+
+//------------------------------------------------------------------------------
+// storage item 의 dev_path 를 block image (loop device) 로 설정, loopback receiver 실행
+//------------------------------------------------------------------------------
+static void sim_devices_init (void)
+{
+	static pthread_t perf_thread, report_thread;
+	const int storage[] = { eUI_EMMC_SPEED, eUI_SATA_SPEED, eUI_NVME_SPEED };
+	const int ir_keys[] = { KEY_HOME, KEY_VOLUMEDOWN, KEY_VOLUMEUP };
+	const int hp_sw[]   = { SW_HEADPHONE_INSERT };
+	unsigned int i;
+
+	for (i = 0; i < sizeof(storage) / sizeof(storage[0]); i++) {
+		struct m1_item *m1 = &M1_Items[storage[i]];
+
+		if (!m1->enable)
+			continue;
+		if (hw_sim_blockdev (m1->arg_str, SIM_STORAGE_MB, m1->dev_path, DEV_PATH_SIZE) < 0)
+			printf ("%s : %s block image error\n", __func__, m1->arg_str);
+	}
+	pthread_create (&perf_thread,   NULL, thread_net_perf_server, &EmergencyStop);
+	pthread_create (&report_thread, NULL, thread_report_server,   &ReportStop);
+
+	SimIrFd = hw_sim_input_create (INPUT_NAME_IR, EV_KEY, ir_keys, sizeof(ir_keys) / sizeof(ir_keys[0]));
+	SimHpFd = hw_sim_input_create (INPUT_NAME_HP, EV_SW,  hp_sw,   sizeof(hp_sw)   / sizeof(hp_sw[0]));
+}
+
+//------------------------------------------------------------------------------
+static void sim_input (int fd, int type, int code, int value)
+{
+	struct input_event event;
+
+	if ((fd >= 0) && !hw_sim_input_emit (fd, type, code, value))
+		return;
+
+	memset (&event, 0, sizeof(event));
+	gettimeofday (&event.time, NULL);
+	event.type  = type;
+	event.code  = code;
+	event.value = value;
+	if (type == EV_SW)
+		hp_event_handler (&event, NULL);
+	else
+		ir_event_handler (&event, NULL);
+}
+
+//------------------------------------------------------------------------------
+static int sim_item_done (int item_id)
+{
+	char status = M1_Items[item_id].status;
+
+	return	(status == eSTATUS_FINISH) || (status == eSTATUS_STOP) || (status == eSTATUS_SKIP);
+}
+
+//------------------------------------------------------------------------------
+// return 1 : item 결과 확인, 0 : timeout
+//------------------------------------------------------------------------------
+static int sim_wait_item (int item_id, int timeout_ms)
+{
+	unsigned int seq = event_notify_seq (&ItemNotify);
+	long end = cycle_time_ms () + timeout_ms;
+
+	while (!sim_item_done (item_id)) {
+		if (EmergencyStop || (cycle_time_ms () >= end)) {
+			printf ("%s : %s timeout\n", __func__, M1_Items[item_id].error_str);
+			return 0;
+		}
+		event_notify_wait (&ItemNotify, &seq, 100);
+	}
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+// RES_ETH 사용 중에는 IR 입력이 무시되므로 결과가 나올 때까지 1초 마다 재입력
+//------------------------------------------------------------------------------
+static void sim_key_item (int code, int item_id)
+{
+	long end = cycle_time_ms () + SIM_WAIT_MS;
+
+	while (!sim_item_done (item_id) && !EmergencyStop && (cycle_time_ms () < end)) {
+		sim_input (SimIrFd, EV_KEY, code, 1);
+		sim_input (SimIrFd, EV_KEY, code, 0);
+		sim_wait_item (item_id, 1000);
 	}
+}
+
+//------------------------------------------------------------------------------
+// 작업자 동작 (usb 연결, IR key, headphone 연결/제거) 순서 실행
+//------------------------------------------------------------------------------
+static void *thread_sim_script (void *arg)
+{
+	unsigned int i;
+
+	for (i = 0; i < sizeof(SimUsb) / sizeof(SimUsb[0]); i++) {
+		if (hw_sim_usb_plug (SimUsb[i].port, SimUsb[i].speed, SimUsb[i].block, SIM_USB_MB))
+			printf ("%s : usb %s plug error\n", __func__, SimUsb[i].port);
+	}
+	for (i = 0; i < sizeof(SimUsb) / sizeof(SimUsb[0]); i++)
+		sim_wait_item (SimUsb[i].item_id, SIM_WAIT_MS);
+
+	/* iperf 종료 (RES_ETH 해제) 후 eth speed 변경 */
+	sim_wait_item (eUI_IPERF_SPEED, SIM_WAIT_MS);
+	sim_key_item  (KEY_VOLUMEDOWN, eUI_ETH_GREEN);
+	sim_key_item  (KEY_VOLUMEUP,   eUI_ETH_ORANGE);
+
+	sim_input     (SimHpFd, EV_SW, SW_HEADPHONE_INSERT, 1);
+	sim_wait_item (eUI_HP_IN, SIM_WAIT_MS);
+	sim_input     (SimHpFd, EV_SW, SW_HEADPHONE_INSERT, 0);
+	sim_wait_item (eUI_HP_OUT, SIM_WAIT_MS);
+
+	for (i = 0; i < sizeof(SimUsb) / sizeof(SimUsb[0]); i++)
+		hw_sim_usb_unplug (SimUsb[i].port, SimUsb[i].block);
 	return arg;
 }
 
+//------------------------------------------------------------------------------
+// stage(item) 별 시작/종료 시간, wall time, test thread cpu time 및 process 전체 사용량
+//------------------------------------------------------------------------------
+static void bench_report (void)
+{
+	struct rusage ru;
+	int i, error_cnt = 0;
+
+	printf ("\n%-8s %-6s %10s %10s %10s %10s\n",
+		"stage", "result", "start_ms", "end_ms", "wall_ms", "cpu_ms");
+	printf ("%-8s %-6s %10d %10ld %10ld %10s\n",
+		"NETWORK", NetReady ? "PASS" : "FAIL", 0, NetReadyMs, NetReadyMs, "-");
+
+	for (i = 0; i < eUI_ITEM_END; i++) {
+		struct m1_item *m1 = &M1_Items[i];
+		char cpu_ms[16];
+
+		if (m1->status == eSTATUS_SKIP) {
+			printf ("%-8s %-6s\n", m1->error_str, "SKIP");
+			continue;
+		}
+		error_cnt += m1->result ? 0 : 1;
+		snprintf (cpu_ms, sizeof(cpu_ms), "%.1f", m1->stat.cpu_us / 1000.0);
+		printf ("%-8s %-6s %10ld %10ld %10ld %10s\n",
+			m1->error_str, m1->result ? "PASS" : "FAIL",
+			m1->stat.start_ms, m1->stat.end_ms,
+			m1->stat.elapsed_ms ? m1->stat.elapsed_ms : m1->stat.end_ms - m1->stat.start_ms,
+			m1->stat.cpu_measured ? cpu_ms : "-");
+	}
+	printf ("%-8s %-6s %10d %10ld %10ld %10s\n",
+		"CYCLE", error_cnt ? "FAIL" : "PASS", 0, CycleMs, CycleMs, "-");
+
+	getrusage (RUSAGE_SELF, &ru);
+	printf ("\nprocess cpu : user %ld.%03ld s, sys %ld.%03ld s, max rss %ld KB, first result %ld ms\n",
+		(long)ru.ru_utime.tv_sec, (long)ru.ru_utime.tv_usec / 1000,
+		(long)ru.ru_stime.tv_sec, (long)ru.ru_stime.tv_usec / 1000,
+		ru.ru_maxrss, FirstResultMs);
+}
+
+//------------------------------------------------------------------------------
+static void print_usage (const char *prog)
+{
+	printf ("Usage: %s [-e] [-E efuse_image] [-L result_log] [-O trace_dir] [-r] [-R] [-c server_ip] [-t] [-p port]\n"
+		"          [-d duration_ms] [-S storage_path [-T storage_type]] [-Q result_log [-N item]]\n"
+		"          [-s sim_root] [-B] [-K loops] [-A wav] [-M] [-C]\n", prog);
+	puts ("\n"
+		"  -r  network throughput/result report receiver (nlp server 에서 실행)\n"
+		"  -R  결과 frame 을 nlp server 의 result report receiver (-r, port 5203) 로 전송\n"
+		"  -c  network throughput sender (receiver 로 측정 후 종료)\n"
+		"  -t  tcp 측정 (default udp)\n"
+		"  -p  receiver port (default 5202)\n"
+		"  -d  sender 측정 시간 (default 10000 ms)\n"
+		"  -e  eth link fake backend (PHY 없이 eth speed/link test)\n"
+		"  -E  efuse simulator image file (uuid file = {image}.uuid)\n"
+		"  -S  storage read benchmark (block device, loop device, file) 후 종료\n"
+		"  -T  storage type (emmc, sata, nvme, usb) block size/queue depth 설정\n"
+		"  -L  board 결과 기록 file (default " RESULT_LOG_FILE ")\n"
+		"  -O  test 시간 trace (chrome trace json), metrics (prometheus) 저장 directory (default /tmp)\n"
+		"  -Q  결과 기록 file 의 item 별 측정값 분포/percentile/drift 출력 후 종료\n"
+		"  -N  -Q 출력 item (error_str, 예 NVME, IPERF)\n"
+		"  -s  hardware simulation (fake sysfs, block image, uinput, memory framebuffer) root\n"
+		"  -B  simulation 에서 작업자 동작 script 로 1 cycle 실행 후 stage 별 wall/cpu time 출력\n"
+		"      (-s 없는 경우 " HW_SIM_ROOT ")\n"
+		"  -A  audio loopback 분석 (wav capture file, 없는 경우 stimulus 기록) 및 fft 속도 출력 후 종료\n"
+		"  -K  framebuffer kernel (fill/outline/copy/rgb-bgr/recolor) 과 기존 pixel 단위 경로 비교 후 종료\n"
+		"      (framebuffer 가 없는 경우 1920x1080 memory framebuffer)\n"
+		"  -M  memory bandwidth/integrity test (m1-test.cfg 'M' 설정) 후 종료\n"
+		"  -C  cpu load/throttling test (m1-test.cfg 'C' 설정), sample 출력 후 종료\n"
+		"  option이 없는 경우 M1 board test 실행\n");
+	exit(1);
+}
+
+//------------------------------------------------------------------------------
+// return 1 : network throughput/storage benchmark mode 실행 완료 (board test 진행하지 않음)
+//------------------------------------------------------------------------------
+static int parse_opts (int argc, char **argv)
+{
+	struct net_perf_cfg cfg;
+	const char *ip = NULL, *storage = NULL, *storage_type = NULL;
+	const char *query = NULL, *query_item = NULL, *audio_wav = NULL;
+	int opt, receiver = 0, proto = NET_PERF_UDP, port = NET_PERF_PORT, fb_loops = 0, mem_only = 0, cpu_only = 0;
+	int duration = NET_PERF_DURATION_MS, speed;
+
+	while ((opt = getopt (argc, argv, "rRc:tp:d:eE:S:T:L:O:Q:N:s:BK:A:MCh")) != -1) {
+		switch (opt) {
+			case 's':	OptSimRoot   = optarg;		break;
+			case 'B':	OptBench     = 1;			break;
+			case 'K':	fb_loops     = atoi (optarg);	break;
+			case 'A':	audio_wav    = optarg;		break;
+			case 'M':	mem_only     = 1;			break;
+			case 'C':	cpu_only     = 1;			break;
+			case 'L':	OptResultLog = optarg;		break;
+			case 'O':	OptTraceDir  = optarg;		break;
+			case 'Q':	query        = optarg;		break;
+			case 'N':	query_item   = optarg;		break;
+			case 'S':	storage      = optarg;		break;
+			case 'T':	storage_type = optarg;		break;
+			case 'E':	OptEfuseSim = optarg;		break;
+			case 'e':	OptFakeLink = 1;			break;
+			case 'r':	receiver = 1;				break;
+			case 'R':	OptReport = 1;				break;
+			case 'c':	ip       = optarg;			break;
+			case 't':	proto    = NET_PERF_TCP;	break;
+			case 'p':	port     = atoi (optarg);	break;
+			case 'd':	duration = atoi (optarg);	break;
+			default:	print_usage (argv[0]);		break;
+		}
+	}
+	if (receiver) {
+		pthread_t report_thread;
+
+		/* result report (REPORT_PORT) test receiver */
+		pthread_create (&report_thread, NULL, thread_report_server, &EmergencyStop);
+		return	net_perf_server (port, &EmergencyStop) ? -1 : 1;
+	}
+
+	if (query != NULL)
+		return	result_log_query (query, query_item) < 0 ? -1 : 1;
+
+	if (audio_wav != NULL)
+		return	audio_test_bench (audio_wav, 1000) < 0 ? -1 : 1;
+
+	if (mem_only) {
+		struct mem_test_result res;
+		char str[RESPONSE_STR_SIZE];
+
+		test_registry_load (OPT_TEST_CFG);
+		mem_test_run (&MemCfg, &res);
+		mem_test_summary (&res, str, sizeof(str));
+		printf ("%s\n", str);
+		return	(res.verdict != eMEM_PASS) ? -1 : 1;
+	}
+
+	if (cpu_only) {
+		static struct cpu_test_result res;
+		char str[RESPONSE_STR_SIZE];
+		int i, c;
+
+		test_registry_load (OPT_TEST_CFG);
+		CpuCfg.mops_min = M1_Items[eUI_CPU_LOAD].threshold;
+		cpu_test_run (&CpuCfg, &res);
+		for (i = 0; i < res.sample_cnt; i++) {
+			printf ("%6d ms :", res.sample[i].ms);
+			for (c = 0; c < res.threads; c++)
+				printf (" %4d MHz %5d M", res.sample[i].mhz[c], res.sample[i].mops[c]);
+			for (c = 0; c < res.zones; c++)
+				printf (" %d.%d C", res.sample[i].temp_dc[c] / 10, abs (res.sample[i].temp_dc[c] % 10));
+			printf ("\n");
+		}
+		cpu_test_summary (&res, str, sizeof(str));
+		printf ("%s\n", str);
+		return	(res.verdict != eCPU_PASS) ? -1 : 1;
+	}
+
+	if (fb_loops > 0) {
+		fb_info_t *pfb;
+		int ret;
+
+		if ((pfb = fb_init (OPT_DEVICE_NAME)) != NULL) {
+			ret = fb_kernel_bench (pfb, fb_loops);
+			fb_close (pfb);
+		} else {
+			if ((pfb = hw_sim_fb_init (1920, 1080, 32)) == NULL)
+				return -1;
+			ret = fb_kernel_bench (pfb, fb_loops);
+			hw_sim_fb_close (pfb);
+		}
+		return	ret < 0 ? -1 : 1;
+	}
+
+	/* simulation : eth link fake backend, efuse/result log/sysfs attribute 는 sim root 아래 사용 */
+	if (OptBench && (OptSimRoot == NULL))
+		OptSimRoot = HW_SIM_ROOT;
+	if (OptSimRoot != NULL) {
+		static char efuse_img[HW_SIM_PATH_SIZE], result_log[HW_SIM_PATH_SIZE];
+		static char spool_file[HW_SIM_PATH_SIZE];
+		char sysfs_root[HW_SIM_PATH_SIZE];
+
+		if (!hw_sim_init (OptSimRoot))
+			return -1;
+		sysfs_attr_set_root (hw_sim_path ("sys", sysfs_root, sizeof(sysfs_root)));
+		OptFakeLink = 1;
+		if (OptEfuseSim == NULL)
+			OptEfuseSim = hw_sim_path ("efuse.img", efuse_img, sizeof(efuse_img));
+		if (!strcmp (OptResultLog, RESULT_LOG_FILE))
+			OptResultLog = hw_sim_path ("m1-result.log", result_log, sizeof(result_log));
+		/* loopback receiver (sim_devices_init) 로 결과 frame 전송 */
+		OptSpoolFile = hw_sim_path ("m1-report.spool", spool_file, sizeof(spool_file));
+		OptReport    = 1;
+	}
+
+	if (storage != NULL) {
+		struct storage_bench_cfg scfg;
+		struct storage_bench_result res;
+		char json[1024];
+
+		storage_bench_cfg_default (&scfg, storage_type, storage);
+		if (storage_bench_run (&scfg, &res))
+			return -1;
+		storage_bench_json (&scfg, &res, json, sizeof(json));
+		printf ("%s\n", json);
+		return 1;
+	}
+
+	if (ip == NULL)
+		return 0;
+
+	net_perf_cfg_default (&cfg, ip, proto);
+	cfg.port        = port;
+	cfg.duration_ms = duration;
+	speed = net_perf_client (&cfg, NULL, NULL);
+	printf ("%s : %s %s speed = %d Mbits/s\n", __func__, ip,
+		proto == NET_PERF_TCP ? "tcp" : "udp", speed);
+	return	(speed < 0) ? -1 : 1;
+}
+
 //------------------------------------------------------------------------------
 int main(int argc, char **argv)
 {
-	pthread_t ui_thread, ir_thread, hp_thread, bt_thread;
+	pthread_t ui_thread, input_thread, eth_thread, bt_thread, usb_thread, link_thread;
+	pthread_t report_thread, net_thread, sim_thread;
 
 	struct m1_server m1_server;
 	fb_info_t	*pfb;
 	ui_grp_t 	*pui;
+	char		fb_raw[HW_SIM_PATH_SIZE];
+	int			ret;
+
+	/* CLI mode (-r/-c/-S/-Q/-A/-M/-C/-K) 실행 후 종료, 실패시 exit code 1 */
+	if ((ret = parse_opts (argc, argv)) != 0)
+		return (ret < 0) ? 1 : 0;
+
+	clock_gettime (CLOCK_MONOTONIC, &CycleStart);
+	trace_init ();
 
-	if ((pfb = fb_init (OPT_DEVICE_NAME)) == NULL) {
+	/* main 이후 생성되는 UI/input/event thread는 SCHED_UI_CPU에서 실행 */
+	test_sched_init ();
+	test_sched_pin_self (0);
+
+	/* simulation : memory framebuffer */
+	pfb = (OptSimRoot != NULL) ? hw_sim_fb_init (1920, 1080, 32) : fb_init (OPT_DEVICE_NAME);
+	if (pfb == NULL) {
 		fprintf(stdout, "ERROR: frame buffer init fail!\n");
 		exit(1);
 	}
-    fb_cursor (0);
+	if (OptSimRoot == NULL)
+		fb_cursor (0);
+
+	/*
+		lib_fbui는 cacheable offscreen buffer에 그리고 변경된 영역만 visible page로
+		전달 (2 page 지원시 FBIOPAN_DISPLAY flip, 미지원시 copy).
+		simulation : {sim_root}/fb.raw file 을 scanout page 로 사용 (fake mode).
+	*/
+	if ((OptSimRoot == NULL) ? fb_compose_init (&FbCompose, OPT_DEVICE_NAME) :
+		fb_compose_init_fake (&FbCompose, hw_sim_path ("fb.raw", fb_raw, sizeof(fb_raw)),
+			pfb->w, pfb->h, pfb->bpp)) {
+		if ((FbCompose.w == pfb->w) && (FbCompose.h == pfb->h)) {
+			FbVisibleData = pfb->data;
+			pfb->data     = FbCompose.compose;
+			ui_dirty_set_damage (fb_damage, &FbCompose);
+		} else
+			fb_compose_close (&FbCompose);
+	}
 
 	if ((pui = ui_init (pfb, OPT_FBUI_CFG)) == NULL) {
 		fprintf(stdout, "ERROR: User interface create fail!\n");
 		exit(1);
 	}
-	ui_update(pfb, pui, -1);
+	event_notify_init (&ItemNotify);
+	event_notify_init (&InputNotify);
+	event_notify_init (&UsbNotify);
+	event_notify_init (&NetNotify);
+	event_notify_init (&CycleNotify);
+
+	/* efuse backend (-E : file image simulator) */
+	if (OptEfuseSim != NULL) {
+		char uuid_file[256];
+		snprintf (uuid_file, sizeof(uuid_file), "%s.uuid", OptEfuseSim);
+		efuse_init (eEFUSE_BACKEND_SIM, OptEfuseSim, uuid_file);
+	} else
+		efuse_init (eEFUSE_BACKEND_DEV, NULL, NULL);
+
+	/* audio backend (simulation : wav file 기록 후 다시 읽음) */
+	if (OptSimRoot != NULL) {
+		static char audio_wav[HW_SIM_PATH_SIZE];
+		audio_test_init (eAUDIO_BACKEND_WAV, hw_sim_path ("audio.wav", audio_wav, sizeof(audio_wav)), NULL);
+	} else
+		audio_test_init (eAUDIO_BACKEND_ALSA, NULL, NULL);
+
+	/* layout 이 없으면 ui_dirty_sitem/ritem 이 무시되어 화면이 멈추므로 종료 */
+	if (!ui_dirty_init (pfb, OPT_FBUI_CFG, &ItemNotify)) {
+		fprintf(stdout, "ERROR: UI layout (%s) load fail!\n", OPT_FBUI_CFG);
+		exit(1);
+	}
+	test_registry_load (OPT_TEST_CFG);
+	if (OptSimRoot != NULL)
+		sim_devices_init ();
+	ui_dirty_full (pfb, pui);
+	fb_present ();
 
 	m1_server.items = &M1_Items[0];
 	m1_server.pfb   = pfb;
+	MainFb          = pfb;
 	m1_server.pui   = pui;
 
+	/*
+		nlp server 로 전송하는 메시지/결과는 report queue thread 에서 처리 (test thread block 방지).
+		UI thread 종료 시 EmergencyStop 이 set 되므로 별도 stop flag 사용.
+	*/
+	report_queue_init (OptSpoolFile, report_nlp_send, NULL);
+	pthread_create(&report_thread, NULL, report_queue_thread, &ReportStop);
+
 	/* UI Thread running */
 	pthread_create(&ui_thread, NULL, thread_ui_update, &m1_server);
-	bootup_test(pfb, pui);
 
-	/* IR Thread running */
-	pthread_create(&ir_thread, NULL, thread_ir_event, &m1_server);
-	/* HP Thread running */
-	pthread_create(&hp_thread, NULL, thread_hp_event, &m1_server);
+	/* ETH link/address monitor (RTM_NEWLINK/RTM_NEWADDR) Thread running, network bootstrap 전 실행 */
+	if (eth_link_init (OPT_ETH_NAME, OptFakeLink, NULL))
+		pthread_create(&link_thread, NULL, eth_link_thread, &EmergencyStop);
+
+	/* Network bootstrap Thread running (ip/nlp server 확인), local test 는 기다리지 않음 */
+	pthread_create(&net_thread, NULL, thread_net_bootstrap, &m1_server);
+
+	/* IR/HP input event reactor running */
+	if (input_reactor_init (NULL, NULL)) {
+		/* simulation : uinput device 를 찾지 못한 경우 script 에서 handler 직접 호출 */
+		if (!input_reactor_add (INPUT_NAME_IR, ir_event_handler, &m1_server) && (SimIrFd >= 0)) {
+			hw_sim_input_close (SimIrFd);	SimIrFd = -1;
+		}
+		if (!input_reactor_add (INPUT_NAME_HP, hp_event_handler, &m1_server) && (SimHpFd >= 0)) {
+			hw_sim_input_close (SimHpFd);	SimHpFd = -1;
+		}
+		pthread_create(&input_thread, NULL, input_reactor_thread, &EmergencyStop);
+	}
+	/* ETH speed change Thread running */
+	pthread_create(&eth_thread, NULL, thread_eth_event, &m1_server);
+	/* USB hotplug(uevent) Thread running, simulation : {sim_root}/sys */
+	{
+		char sysfs_root[HW_SIM_PATH_SIZE];
+
+		usb_hotplug_init ((OptSimRoot != NULL) ? hw_sim_path ("sys", sysfs_root, sizeof(sysfs_root)) : NULL,
+			USB_DEVICE_NAME, sizeof(USB_DEVICE_NAME) / sizeof(USB_DEVICE_NAME[0]), &UsbNotify);
+	}
+	usb_hotplug_scan ();
+	pthread_create(&usb_thread, NULL, usb_hotplug_thread, &EmergencyStop);
 	/* SPI Button Thread rinning */
 	pthread_create(&bt_thread, NULL, thread_bt_event, &m1_server);
 
 	test_thread_run ();
 
-	while (1)
-		sleep(1);
+	/* simulation : 작업자 동작 script */
+	if (OptSimRoot != NULL)
+		pthread_create(&sim_thread, NULL, thread_sim_script, &m1_server);
+
+	/* board test : UI thread 는 종료하지 않으므로 계속 대기 */
+	if (!OptBench) {
+		pthread_join (ui_thread, NULL);
+		return 0;
+	}
+	/* benchmark : 결과 저장 완료 후 stage 별 시간 출력, report queue 전송 후 종료 */
+	{
+		unsigned int seq = event_notify_seq (&CycleNotify);
+
+		while (!CycleDone)
+			event_notify_wait (&CycleNotify, &seq, -1);
+	}
 
-	ui_close(pui);
-	fb_close (pfb);
+	bench_report ();
+	report_queue_drain (REPORT_IO_TIMEOUT_MS * 3);
+	hw_sim_input_close (SimIrFd);
+	hw_sim_input_close (SimHpFd);
+	/* loop device 해제, framebuffer/ui 는 UI thread 가 계속 사용하므로 process 종료시 해제 */
+	hw_sim_close ();
 
 	return 0;
 }
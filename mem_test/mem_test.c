@@ -0,0 +1,784 @@
+//------------------------------------------------------------------------------
+/**
+ * @file mem_test.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief multi-thread memory bandwidth (NEON/SSE stream) and integrity test.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/sysinfo.h>
+
+/* float64 vector (triad) 는 aarch64 NEON 만 지원 */
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "mem_test.h"
+
+//------------------------------------------------------------------------------
+/*
+	1. bandwidth : thread 별 a/b/c array (MEM_TEST_BW_MB) 에 write/read/copy/triad 를
+	   barrier 로 동시에 시작, repeat 중 가장 빠른 회차 (회차 별 가장 늦은 thread 기준).
+	2. integrity : 측정된 copy bandwidth 로 budget 안에 끝나는 크기를 계산하여
+	   (MemAvailable * percent 이하) thread 별 영역을 할당 후
+	   address -> walking 1/0 -> March C- (0/1) -> March C- (checkerboard, 시간이 남는 경우)
+	   pass 는 MEM_TEST_CHUNK_MB 단위로 deadline 확인.
+	영역은 각 thread 가 mmap (MAP_POPULATE) 하므로 실행 core 에서 first touch 됨.
+*/
+//------------------------------------------------------------------------------
+#define	BLOCK_WORDS		8		/* 64 byte */
+#define	PAGE_WORDS		(65536 / sizeof(uint64_t))	/* 영역 크기 단위 (64 KB page 까지) */
+#define	ADDR_SEED		0x5A3CC3A55A3CC3A5ULL
+#define	CHECKERBOARD	0x5555555555555555ULL
+/*
+	integrity 영역 크기 계산 : 영역 1 MB 당 소요 시간 (copy bandwidth 1 MB 기준 배수)
+	populate + address 2 pass + March C- (Makefile 기본 -O0 build 에서 측정, 약 64)
+*/
+#define	MARCH_TRAFFIC	64
+/* March C- 시간 / address 2 pass 시간 (address 측정 후 영역 축소에 사용) */
+#define	MARCH_ADDR_RATIO	4
+
+struct mem_ctx {
+	const struct mem_test_cfg	*cfg;
+	struct mem_test_result		*res;
+	pthread_barrier_t	barrier;
+	pthread_mutex_t		lock;
+	/* 생성된 thread 수 (-1 : 생성중, thread 는 시작 대기), barrier 크기 */
+	pthread_cond_t		start;
+	int					started;
+	struct timespec		deadline;
+	int					pagemap_fd;
+	size_t				region_words;
+};
+
+struct mem_worker {
+	struct mem_ctx	*ctx;
+	int				id, cpu;
+	/* bandwidth : a = b + s * c */
+	double			*a, *b, *c;
+	size_t			bw_words;
+	long			us[eMEM_BW_END][MEM_TEST_BW_REPEAT];
+	uint64_t		sink;
+	/* integrity */
+	uint64_t		*mem;
+	size_t			words;
+	int				passes, complete, alloc_error;
+	unsigned long	errors;
+};
+
+//------------------------------------------------------------------------------
+const char *mem_test_isa (void)
+{
+#if defined(__ARM_NEON) && defined(__aarch64__)
+	return "neon";
+#elif defined(__SSE2__)
+	return "sse";
+#else
+	return "c";
+#endif
+}
+
+//------------------------------------------------------------------------------
+const char *mem_test_bw_name (int kind)
+{
+	static const char *names[eMEM_BW_END] = { "write", "read", "copy", "triad" };
+
+	return	((kind >= 0) && (kind < eMEM_BW_END)) ? names[kind] : "?";
+}
+
+//------------------------------------------------------------------------------
+void mem_test_cfg_default (struct mem_test_cfg *cfg)
+{
+	memset (cfg, 0, sizeof(struct mem_test_cfg));
+	cfg->percent   = MEM_TEST_PERCENT;
+	cfg->budget_ms = MEM_TEST_BUDGET_MS;
+}
+
+//------------------------------------------------------------------------------
+static long now_us (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return	ts.tv_sec * 1000000L + ts.tv_nsec / 1000L;
+}
+
+//------------------------------------------------------------------------------
+static long left_ms (const struct timespec *deadline)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return	(deadline->tv_sec - ts.tv_sec) * 1000L + (deadline->tv_nsec - ts.tv_nsec) / 1000000L;
+}
+
+//------------------------------------------------------------------------------
+static void *map_words (size_t words)
+{
+	void *p = mmap (NULL, words * sizeof(uint64_t), PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+
+	return	(p == MAP_FAILED) ? NULL : p;
+}
+
+//------------------------------------------------------------------------------
+static void unmap_words (void *p, size_t words)
+{
+	if (p)
+		munmap (p, words * sizeof(uint64_t));
+}
+
+//------------------------------------------------------------------------------
+static long mem_available_mb (void)
+{
+	struct sysinfo sinfo;
+	char line[128];
+	long kb = -1;
+	FILE *fp;
+
+	if ((fp = fopen ("/proc/meminfo", "r")) != NULL) {
+		while (fgets (line, sizeof(line), fp) != NULL) {
+			if (sscanf (line, "MemAvailable: %ld kB", &kb) == 1)
+				break;
+		}
+		fclose (fp);
+	}
+	if (kb >= 0)
+		return	kb / 1024;
+	if (!sysinfo (&sinfo))
+		return	(long)((unsigned long long)sinfo.freeram * sinfo.mem_unit / 1024 / 1024);
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+// virtual -> physical (pagemap PFN 은 CAP_SYS_ADMIN 인 경우만 0 이 아님)
+//------------------------------------------------------------------------------
+static uint64_t virt_to_phys (int fd, const void *p)
+{
+	long page = sysconf (_SC_PAGESIZE);
+	uint64_t ent, va = (uintptr_t)p;
+
+	if ((fd < 0) || (pread (fd, &ent, sizeof(ent), (off_t)(va / page) * sizeof(ent)) != sizeof(ent)))
+		return 0;
+	if (!(ent & (1ULL << 63)) || !(ent & ((1ULL << 55) - 1)))
+		return 0;
+	return	(ent & ((1ULL << 55) - 1)) * page + (va % page);
+}
+
+//------------------------------------------------------------------------------
+static void mem_error (struct mem_worker *w, const uint64_t *p, uint64_t expect, uint64_t actual)
+{
+	struct mem_test_result *res = w->ctx->res;
+	struct mem_test_error *e;
+
+	w->errors++;
+	pthread_mutex_lock (&w->ctx->lock);
+	if (res->err_cnt < MEM_TEST_ERR_MAX) {
+		e = &res->err[res->err_cnt++];
+		e->vaddr  = (uintptr_t)p;
+		e->paddr  = virt_to_phys (w->ctx->pagemap_fd, p);
+		e->expect = expect;
+		e->actual = actual;
+	}
+	pthread_mutex_unlock (&w->ctx->lock);
+}
+
+//------------------------------------------------------------------------------
+// 오류가 있는 block (64 byte) 의 word 단위 확인
+//------------------------------------------------------------------------------
+static void block_scan (struct mem_worker *w, const uint64_t *p, uint64_t expect)
+{
+	uint64_t v;
+	int i;
+
+	for (i = 0; i < BLOCK_WORDS; i++) {
+		if ((v = p[i]) != expect)
+			mem_error (w, &p[i], expect, v);
+	}
+}
+
+//------------------------------------------------------------------------------
+//
+// stream kernel (n : BLOCK_WORDS 의 배수, 16 byte 정렬)
+// NEON 은 non-temporal store intrinsic 이 없으나 A55 는 연속 store 를
+// write streaming 으로 처리 (cache allocate 없음).
+//
+//------------------------------------------------------------------------------
+static void k_fill (uint64_t *p, size_t n, uint64_t v)
+{
+	size_t i;
+#if defined(__ARM_NEON) && defined(__aarch64__)
+	uint64x2_t x = vdupq_n_u64 (v);
+
+	for (i = 0; i < n; i += BLOCK_WORDS) {
+		vst1q_u64 (p + i,     x);	vst1q_u64 (p + i + 2, x);
+		vst1q_u64 (p + i + 4, x);	vst1q_u64 (p + i + 6, x);
+	}
+#elif defined(__SSE2__)
+	__m128i x = _mm_set1_epi64x ((long long)v);
+
+	for (i = 0; i < n; i += BLOCK_WORDS) {
+		_mm_stream_si128 ((__m128i *)(p + i),     x);	_mm_stream_si128 ((__m128i *)(p + i + 2), x);
+		_mm_stream_si128 ((__m128i *)(p + i + 4), x);	_mm_stream_si128 ((__m128i *)(p + i + 6), x);
+	}
+	_mm_sfence ();
+#else
+	for (i = 0; i < n; i++)
+		p[i] = v;
+#endif
+}
+
+//------------------------------------------------------------------------------
+static uint64_t k_read (const uint64_t *p, size_t n)
+{
+	size_t i;
+#if defined(__ARM_NEON) && defined(__aarch64__)
+	uint64x2_t x0 = vdupq_n_u64 (0), x1 = vdupq_n_u64 (0);
+
+	for (i = 0; i < n; i += BLOCK_WORDS) {
+		x0 = veorq_u64 (x0, veorq_u64 (vld1q_u64 (p + i),     vld1q_u64 (p + i + 2)));
+		x1 = veorq_u64 (x1, veorq_u64 (vld1q_u64 (p + i + 4), vld1q_u64 (p + i + 6)));
+	}
+	x0 = veorq_u64 (x0, x1);
+	return	vgetq_lane_u64 (x0, 0) ^ vgetq_lane_u64 (x0, 1);
+#elif defined(__SSE2__)
+	__m128i x0 = _mm_setzero_si128 (), x1 = _mm_setzero_si128 ();
+	uint64_t v[2];
+
+	for (i = 0; i < n; i += BLOCK_WORDS) {
+		x0 = _mm_xor_si128 (x0, _mm_xor_si128 (_mm_load_si128 ((const __m128i *)(p + i)),
+												_mm_load_si128 ((const __m128i *)(p + i + 2))));
+		x1 = _mm_xor_si128 (x1, _mm_xor_si128 (_mm_load_si128 ((const __m128i *)(p + i + 4)),
+												_mm_load_si128 ((const __m128i *)(p + i + 6))));
+	}
+	_mm_storeu_si128 ((__m128i *)v, _mm_xor_si128 (x0, x1));
+	return	v[0] ^ v[1];
+#else
+	uint64_t x = 0;
+
+	for (i = 0; i < n; i++)
+		x ^= p[i];
+	return x;
+#endif
+}
+
+//------------------------------------------------------------------------------
+static void k_copy (uint64_t *d, const uint64_t *s, size_t n)
+{
+	size_t i;
+#if defined(__ARM_NEON) && defined(__aarch64__)
+	for (i = 0; i < n; i += BLOCK_WORDS) {
+		vst1q_u64 (d + i,     vld1q_u64 (s + i));		vst1q_u64 (d + i + 2, vld1q_u64 (s + i + 2));
+		vst1q_u64 (d + i + 4, vld1q_u64 (s + i + 4));	vst1q_u64 (d + i + 6, vld1q_u64 (s + i + 6));
+	}
+#elif defined(__SSE2__)
+	for (i = 0; i < n; i += BLOCK_WORDS) {
+		_mm_stream_si128 ((__m128i *)(d + i),     _mm_load_si128 ((const __m128i *)(s + i)));
+		_mm_stream_si128 ((__m128i *)(d + i + 2), _mm_load_si128 ((const __m128i *)(s + i + 2)));
+		_mm_stream_si128 ((__m128i *)(d + i + 4), _mm_load_si128 ((const __m128i *)(s + i + 4)));
+		_mm_stream_si128 ((__m128i *)(d + i + 6), _mm_load_si128 ((const __m128i *)(s + i + 6)));
+	}
+	_mm_sfence ();
+#else
+	memcpy (d, s, n * sizeof(uint64_t));
+#endif
+}
+
+//------------------------------------------------------------------------------
+static void k_triad (double *a, const double *b, const double *c, double s, size_t n)
+{
+	size_t i;
+#if defined(__ARM_NEON) && defined(__aarch64__)
+	float64x2_t x = vdupq_n_f64 (s);
+
+	for (i = 0; i < n; i += 4) {
+		vst1q_f64 (a + i,     vfmaq_f64 (vld1q_f64 (b + i),     vld1q_f64 (c + i),     x));
+		vst1q_f64 (a + i + 2, vfmaq_f64 (vld1q_f64 (b + i + 2), vld1q_f64 (c + i + 2), x));
+	}
+#elif defined(__SSE2__)
+	__m128d x = _mm_set1_pd (s);
+
+	for (i = 0; i < n; i += 4) {
+		_mm_stream_pd (a + i,     _mm_add_pd (_mm_load_pd (b + i),     _mm_mul_pd (_mm_load_pd (c + i),     x)));
+		_mm_stream_pd (a + i + 2, _mm_add_pd (_mm_load_pd (b + i + 2), _mm_mul_pd (_mm_load_pd (c + i + 2), x)));
+	}
+	_mm_sfence ();
+#else
+	for (i = 0; i < n; i++)
+		a[i] = b[i] + s * c[i];
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+// integrity kernel : block 단위 (expect xor) 의 OR 로 비교, 오류 block 만 word 단위 확인
+//
+//------------------------------------------------------------------------------
+static int block_diff (const uint64_t *p, uint64_t expect)
+{
+#if defined(__ARM_NEON) && defined(__aarch64__)
+	uint64x2_t e = vdupq_n_u64 (expect);
+	uint64x2_t x = vorrq_u64 (
+		vorrq_u64 (veorq_u64 (vld1q_u64 (p),     e), veorq_u64 (vld1q_u64 (p + 2), e)),
+		vorrq_u64 (veorq_u64 (vld1q_u64 (p + 4), e), veorq_u64 (vld1q_u64 (p + 6), e)));
+
+	return	(vgetq_lane_u64 (x, 0) | vgetq_lane_u64 (x, 1)) != 0;
+#elif defined(__SSE2__)
+	__m128i e = _mm_set1_epi64x ((long long)expect);
+	__m128i x = _mm_or_si128 (
+		_mm_or_si128 (_mm_xor_si128 (_mm_load_si128 ((const __m128i *)p),       e),
+					  _mm_xor_si128 (_mm_load_si128 ((const __m128i *)(p + 2)), e)),
+		_mm_or_si128 (_mm_xor_si128 (_mm_load_si128 ((const __m128i *)(p + 4)), e),
+					  _mm_xor_si128 (_mm_load_si128 ((const __m128i *)(p + 6)), e)));
+
+	return	_mm_movemask_epi8 (_mm_cmpeq_epi8 (x, _mm_setzero_si128 ())) != 0xFFFF;
+#else
+	return	((p[0] ^ expect) | (p[1] ^ expect) | (p[2] ^ expect) | (p[3] ^ expect) |
+			 (p[4] ^ expect) | (p[5] ^ expect) | (p[6] ^ expect) | (p[7] ^ expect)) != 0;
+#endif
+}
+
+//------------------------------------------------------------------------------
+static void block_store (uint64_t *p, uint64_t v)
+{
+#if defined(__ARM_NEON) && defined(__aarch64__)
+	uint64x2_t x = vdupq_n_u64 (v);
+
+	vst1q_u64 (p,     x);	vst1q_u64 (p + 2, x);	vst1q_u64 (p + 4, x);	vst1q_u64 (p + 6, x);
+#elif defined(__SSE2__)
+	__m128i x = _mm_set1_epi64x ((long long)v);
+
+	_mm_store_si128 ((__m128i *)p,       x);	_mm_store_si128 ((__m128i *)(p + 2), x);
+	_mm_store_si128 ((__m128i *)(p + 4), x);	_mm_store_si128 ((__m128i *)(p + 6), x);
+#else
+	int i;
+
+	for (i = 0; i < BLOCK_WORDS; i++)
+		p[i] = v;
+#endif
+}
+
+//------------------------------------------------------------------------------
+static void k_check (struct mem_worker *w, const uint64_t *p, size_t n, uint64_t expect)
+{
+	size_t i;
+
+	for (i = 0; i < n; i += BLOCK_WORDS) {
+		if (block_diff (p + i, expect))
+			block_scan (w, p + i, expect);
+	}
+}
+
+//------------------------------------------------------------------------------
+// March element (r expect, w next), down : 높은 주소 -> 낮은 주소 (block 단위)
+//------------------------------------------------------------------------------
+static void k_march (struct mem_worker *w, uint64_t *p, size_t n, uint64_t expect, uint64_t next, int down)
+{
+	size_t i;
+
+	for (i = 0; i < n; i += BLOCK_WORDS) {
+		uint64_t *b = down ? p + n - BLOCK_WORDS - i : p + i;
+
+		if (block_diff (b, expect))
+			block_scan (w, b, expect);
+		block_store (b, next);
+	}
+}
+
+//------------------------------------------------------------------------------
+static void k_addr_fill (uint64_t *p, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		p[i] = (uintptr_t)&p[i] ^ ADDR_SEED;
+}
+
+//------------------------------------------------------------------------------
+static void k_addr_check (struct mem_worker *w, const uint64_t *p, size_t n)
+{
+	uint64_t v, expect;
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		expect = (uintptr_t)&p[i] ^ ADDR_SEED;
+		if ((v = p[i]) != expect)
+			mem_error (w, &p[i], expect, v);
+	}
+}
+
+//------------------------------------------------------------------------------
+//
+// bandwidth thread
+//
+//------------------------------------------------------------------------------
+// 모든 thread 생성이 끝날 때까지 대기 (barrier 는 생성된 thread 수로 설정됨)
+//------------------------------------------------------------------------------
+static void thread_gate (struct mem_ctx *ctx)
+{
+	pthread_mutex_lock (&ctx->lock);
+	while (ctx->started < 0)
+		pthread_cond_wait (&ctx->start, &ctx->lock);
+	pthread_mutex_unlock (&ctx->lock);
+}
+
+//------------------------------------------------------------------------------
+static void *bw_worker (void *arg)
+{
+	struct mem_worker *w = (struct mem_worker *)arg;
+	size_t i, n = w->bw_words;
+	int k, r;
+	long t;
+
+	thread_gate (w->ctx);
+	w->a = map_words (n);	w->b = map_words (n);	w->c = map_words (n);
+	if (!w->a || !w->b || !w->c)
+		w->alloc_error = 1;
+	else {
+		for (i = 0; i < n; i++) {
+			w->b[i] = 1.0;	w->c[i] = 2.0;
+		}
+	}
+
+	/* 할당 실패 thread 도 barrier 는 같이 진행 */
+	for (k = 0; k < eMEM_BW_END; k++) {
+		for (r = 0; r < MEM_TEST_BW_REPEAT; r++) {
+			pthread_barrier_wait (&w->ctx->barrier);
+			t = now_us ();
+			if (!w->alloc_error) {
+				switch (k) {
+				case eMEM_BW_WRITE:	k_fill ((uint64_t *)w->a, n, r);					break;
+				case eMEM_BW_READ:	w->sink ^= k_read ((uint64_t *)w->b, n);			break;
+				case eMEM_BW_COPY:	k_copy ((uint64_t *)w->a, (uint64_t *)w->c, n);		break;
+				case eMEM_BW_TRIAD:	k_triad (w->a, w->b, w->c, 3.0, n);					break;
+				}
+			}
+			w->us[k][r] = now_us () - t;
+		}
+	}
+	unmap_words (w->a, n);	unmap_words (w->b, n);	unmap_words (w->c, n);
+	return arg;
+}
+
+//------------------------------------------------------------------------------
+//
+// integrity thread
+//
+//------------------------------------------------------------------------------
+enum { ePASS_FILL, ePASS_CHECK, ePASS_MARCH_UP, ePASS_MARCH_DN, ePASS_ADDR_FILL, ePASS_ADDR_CHECK };
+
+//------------------------------------------------------------------------------
+// 영역 전체 1 pass 를 chunk 단위로 실행, return 0 : deadline 초과 (pass 미완료)
+//------------------------------------------------------------------------------
+static int pass_run (struct mem_worker *w, int kind, size_t words, uint64_t expect, uint64_t next)
+{
+	size_t chunk = (size_t)MEM_TEST_CHUNK_MB * 1024 * 1024 / sizeof(uint64_t);
+	size_t off, n;
+
+	for (off = 0; off < words; off += n) {
+		uint64_t *p;
+
+		if (left_ms (&w->ctx->deadline) <= 0)
+			return 0;
+		n = (words - off) < chunk ? (words - off) : chunk;
+		/* down : 영역 끝 chunk 부터 */
+		p = (kind == ePASS_MARCH_DN) ? w->mem + words - off - n : w->mem + off;
+
+		switch (kind) {
+		case ePASS_FILL:		k_fill (p, n, next);						break;
+		case ePASS_CHECK:		k_check (w, p, n, expect);					break;
+		case ePASS_MARCH_UP:	k_march (w, p, n, expect, next, 0);			break;
+		case ePASS_MARCH_DN:	k_march (w, p, n, expect, next, 1);			break;
+		case ePASS_ADDR_FILL:	k_addr_fill (p, n);							break;
+		case ePASS_ADDR_CHECK:	k_addr_check (w, p, n);						break;
+		}
+	}
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+// March C- : (w0) up(r0,w1) up(r1,w0) down(r0,w1) down(r1,w0) (r0)
+//------------------------------------------------------------------------------
+static int march_c (struct mem_worker *w, uint64_t bg)
+{
+	return	pass_run (w, ePASS_FILL,     w->words, 0,   bg)  &&
+			pass_run (w, ePASS_MARCH_UP, w->words, bg,  ~bg) &&
+			pass_run (w, ePASS_MARCH_UP, w->words, ~bg, bg)  &&
+			pass_run (w, ePASS_MARCH_DN, w->words, bg,  ~bg) &&
+			pass_run (w, ePASS_MARCH_DN, w->words, ~bg, bg)  &&
+			pass_run (w, ePASS_CHECK,    w->words, bg,  0);
+}
+
+//------------------------------------------------------------------------------
+// walking 1/0 : 64 bit data line 별 stuck/short (MEM_TEST_WALK_KB, cache 보다 크게)
+//------------------------------------------------------------------------------
+static int walking_bits (struct mem_worker *w)
+{
+	size_t words = (size_t)MEM_TEST_WALK_KB * 1024 / sizeof(uint64_t);
+	uint64_t v;
+	int b;
+
+	if (words > w->words)
+		words = w->words;
+	for (b = 0; b < 64; b++) {
+		v = 1ULL << b;
+		if (!pass_run (w, ePASS_FILL, words, 0, v)  || !pass_run (w, ePASS_CHECK, words, v, 0) ||
+			!pass_run (w, ePASS_FILL, words, 0, ~v) || !pass_run (w, ePASS_CHECK, words, ~v, 0))
+			return 0;
+	}
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+static void *integrity_worker (void *arg)
+{
+	struct mem_worker *w = (struct mem_worker *)arg;
+	long t;
+
+	thread_gate (w->ctx);
+	/* 할당 실패시 절반씩 줄여서 재시도 */
+	for (w->words = w->ctx->region_words; w->words >= PAGE_WORDS; w->words /= 2) {
+		w->words &= ~(size_t)(PAGE_WORDS - 1);
+		if ((w->mem = map_words (w->words)) != NULL)
+			break;
+	}
+	if (!w->mem) {
+		w->words = 0;
+		w->alloc_error = 1;
+		return arg;
+	}
+
+	/* pattern 단위로 passes 증가 (address, walking 1/0, March C- 0/1, checkerboard) */
+	t = now_us ();
+	w->complete = pass_run (w, ePASS_ADDR_FILL, w->words, 0, 0) &&
+				  pass_run (w, ePASS_ADDR_CHECK, w->words, 0, 0) && ++w->passes;
+	t = now_us () - t;
+	w->complete = w->complete && walking_bits (w) && ++w->passes;
+
+	/* address 측정 시간으로 March C- 가 남은 시간에 끝나도록 영역 뒷부분 해제 */
+	if (w->complete) {
+		double need = (double)t * MARCH_ADDR_RATIO / 1000, left = left_ms (&w->ctx->deadline) * 0.9;
+		size_t words;
+
+		if ((need > left) && (left > 0)) {
+			words = (size_t)(w->words * (left / need)) & ~(size_t)(PAGE_WORDS - 1);
+			if (words < PAGE_WORDS)
+				words = PAGE_WORDS;
+			if (words < w->words) {
+				munmap (w->mem + words, (w->words - words) * sizeof(uint64_t));
+				w->words = words;
+			}
+		}
+		w->complete = march_c (w, 0) && ++w->passes;
+	}
+	/* 시간이 남는 경우 인접 bit coupling (checkerboard) */
+	if (w->complete && march_c (w, CHECKERBOARD))
+		w->passes++;
+
+	unmap_words (w->mem, w->words);
+	w->mem = NULL;
+	return arg;
+}
+
+//------------------------------------------------------------------------------
+// thread 생성 후 생성된 수로 barrier 를 설정하고 시작 (일부 생성 실패시에도 join 가능)
+//------------------------------------------------------------------------------
+static int threads_run (struct mem_ctx *ctx, struct mem_worker *w, int cnt, void *(*func)(void *))
+{
+	pthread_t th[MEM_TEST_THREAD_MAX];
+	pthread_attr_t attr;
+	cpu_set_t set;
+	int i, started = 0;
+
+	ctx->started = -1;
+	for (i = 0; i < cnt; i++) {
+		pthread_attr_init (&attr);
+		CPU_ZERO (&set);
+		CPU_SET (w[i].cpu, &set);
+		pthread_attr_setaffinity_np (&attr, sizeof(set), &set);
+		if (pthread_create (&th[i], &attr, func, &w[i])) {
+			pthread_attr_destroy (&attr);
+			break;
+		}
+		pthread_attr_destroy (&attr);
+		started++;
+	}
+	pthread_mutex_lock (&ctx->lock);
+	pthread_barrier_init (&ctx->barrier, NULL, started ? started : 1);
+	ctx->started = started;
+	pthread_cond_broadcast (&ctx->start);
+	pthread_mutex_unlock (&ctx->lock);
+
+	for (i = 0; i < started; i++)
+		pthread_join (th[i], NULL);
+	pthread_barrier_destroy (&ctx->barrier);
+	return	started;
+}
+
+//------------------------------------------------------------------------------
+// 회차 별 가장 늦은 thread 시간 중 최소값으로 전체 bandwidth 계산 (MB/s)
+//------------------------------------------------------------------------------
+static void bw_result (struct mem_worker *w, int cnt, struct mem_test_result *res)
+{
+	/* array 당 word 수 대비 kernel 별 이동 byte (read + write) */
+	static const int bytes[eMEM_BW_END] = { 8, 8, 16, 24 };
+	long best, us;
+	int i, k, r;
+
+	for (k = 0; k < eMEM_BW_END; k++) {
+		for (r = 0, best = 0; r < MEM_TEST_BW_REPEAT; r++) {
+			for (i = 0, us = 0; i < cnt; i++)
+				us = w[i].us[k][r] > us ? w[i].us[k][r] : us;
+			if (!r || (us < best))
+				best = us;
+		}
+		res->bw[k] = best ? (int)((double)w[0].bw_words * bytes[k] * cnt / best) : 0;
+	}
+}
+
+//------------------------------------------------------------------------------
+int mem_test_run (const struct mem_test_cfg *cfg, struct mem_test_result *res)
+{
+	struct mem_worker w[MEM_TEST_THREAD_MAX];
+	struct mem_ctx ctx;
+	long start = now_us (), avail_mb, size_mb, time_mb, left;
+	int i, k, cnt, ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+
+	memset (res, 0, sizeof(struct mem_test_result));
+	memset (w, 0, sizeof(w));
+	memset (&ctx, 0, sizeof(ctx));
+	ctx.cfg = cfg;
+	ctx.res = res;
+	pthread_mutex_init (&ctx.lock, NULL);
+	pthread_cond_init  (&ctx.start, NULL);
+	clock_gettime (CLOCK_MONOTONIC, &ctx.deadline);
+	ctx.deadline.tv_sec  += cfg->budget_ms / 1000;
+	ctx.deadline.tv_nsec += (cfg->budget_ms % 1000) * 1000000L;
+	if (ctx.deadline.tv_nsec >= 1000000000L) {
+		ctx.deadline.tv_sec++;
+		ctx.deadline.tv_nsec -= 1000000000L;
+	}
+	ctx.pagemap_fd = open ("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+
+	ncpu = ncpu > 0 ? ncpu : 1;
+	cnt  = cfg->threads > 0 ? cfg->threads : ncpu;
+	cnt  = cnt > MEM_TEST_THREAD_MAX ? MEM_TEST_THREAD_MAX : cnt;
+	for (i = 0; i < cnt; i++) {
+		w[i].ctx      = &ctx;
+		w[i].id       = i;
+		w[i].cpu      = i % ncpu;
+		w[i].bw_words = (size_t)MEM_TEST_BW_MB * 1024 * 1024 / sizeof(uint64_t);
+	}
+	res->threads = cnt;
+	res->verdict = eMEM_ERROR;
+
+	/* 1. bandwidth */
+	if (threads_run (&ctx, w, cnt, bw_worker) != cnt) {
+		printf ("%s : thread create error!\n", __func__);
+		goto out;
+	}
+	for (i = 0; i < cnt; i++)
+		if (w[i].alloc_error)
+			goto out;
+	bw_result (w, cnt, res);
+
+	/* 2. integrity : free memory 비율, 남은 시간에 March C- 가 끝나는 크기 중 작은 값 */
+	avail_mb = mem_available_mb () * cfg->percent / 100;
+	left     = left_ms (&ctx.deadline);
+	time_mb  = left > 0 ? (long)res->bw[eMEM_BW_COPY] * left / 1000 / MARCH_TRAFFIC : 0;
+	size_mb  = avail_mb < time_mb ? avail_mb : time_mb;
+	if (size_mb < cnt * 2)
+		size_mb = cnt * 2;
+	ctx.region_words = (size_t)size_mb * 1024 * 1024 / cnt / sizeof(uint64_t);
+
+	if (threads_run (&ctx, w, cnt, integrity_worker) != cnt) {
+		printf ("%s : thread create error!\n", __func__);
+		goto out;
+	}
+	res->complete = 1;
+	for (i = 0; i < cnt; i++) {
+		if (w[i].alloc_error)
+			goto out;
+		res->tested_mb += (long)(w[i].words * sizeof(uint64_t) / 1024 / 1024);
+		res->errors    += w[i].errors;
+		res->complete  &= w[i].complete;
+		if (!i || (w[i].passes < res->passes))
+			res->passes = w[i].passes;
+	}
+
+	if (res->errors)
+		res->verdict = eMEM_FAULT;
+	else {
+		res->verdict = eMEM_PASS;
+		for (k = 0; k < eMEM_BW_END; k++) {
+			if (res->bw[k] < cfg->bw_min[k]) {
+				res->verdict = eMEM_SLOW;
+				res->slow    = k;
+				break;
+			}
+		}
+	}
+out:
+	if (ctx.pagemap_fd >= 0)
+		close (ctx.pagemap_fd);
+	pthread_cond_destroy  (&ctx.start);
+	pthread_mutex_destroy (&ctx.lock);
+	res->elapsed_ms = (now_us () - start) / 1000;
+
+	printf ("%s : %s x %d, write %d, read %d, copy %d, triad %d MB/s\n", __func__,
+		mem_test_isa (), cnt, res->bw[eMEM_BW_WRITE], res->bw[eMEM_BW_READ],
+		res->bw[eMEM_BW_COPY], res->bw[eMEM_BW_TRIAD]);
+	printf ("%s : %ld MB, passes %d%s, errors %lu, %ld ms\n", __func__, res->tested_mb,
+		res->passes, res->complete ? "" : " (budget)", res->errors, res->elapsed_ms);
+	for (i = 0; i < res->err_cnt; i++)
+		printf ("%s : error va 0x%llx pa 0x%llx expect 0x%016llx actual 0x%016llx\n", __func__,
+			(unsigned long long)res->err[i].vaddr, (unsigned long long)res->err[i].paddr,
+			(unsigned long long)res->err[i].expect, (unsigned long long)res->err[i].actual);
+
+	return	res->verdict == eMEM_PASS;
+}
+
+//------------------------------------------------------------------------------
+void mem_test_summary (const struct mem_test_result *res, char *buf, int size)
+{
+	switch (res->verdict) {
+	case eMEM_PASS:
+		snprintf (buf, size, "%d.%02dGB/s %ldM", res->bw[eMEM_BW_COPY] / 1000,
+			res->bw[eMEM_BW_COPY] % 1000 / 10, res->tested_mb);
+		break;
+	case eMEM_FAULT:
+		/* 물리 주소를 모르는 경우 virtual 주소 (v) */
+		if (res->err_cnt && res->err[0].paddr)
+			snprintf (buf, size, "ERR %lu %llx", res->errors, (unsigned long long)res->err[0].paddr);
+		else
+			snprintf (buf, size, "ERR %lu v%llx", res->errors,
+				res->err_cnt ? (unsigned long long)res->err[0].vaddr : 0ULL);
+		break;
+	case eMEM_SLOW:
+		snprintf (buf, size, "SLOW %s %d.%02dGB/s", mem_test_bw_name (res->slow),
+			res->bw[res->slow] / 1000, res->bw[res->slow] % 1000 / 10);
+		break;
+	default:
+		snprintf (buf, size, "ERROR");
+		break;
+	}
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+/**
+ * @file mem_test.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief multi-thread memory bandwidth (NEON/SSE stream) and integrity test.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __MEM_TEST_H__
+#define __MEM_TEST_H__
+
+//------------------------------------------------------------------------------
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+/* bandwidth array 크기 (thread 당 3 개, L3 cache 512KB 보다 충분히 크게) */
+#define	MEM_TEST_BW_MB			8
+#define	MEM_TEST_BW_REPEAT		3
+/* integrity test : MemAvailable 중 test 비율 (%), 전체 시간 제한 (ms) */
+#define	MEM_TEST_PERCENT		25
+#define	MEM_TEST_BUDGET_MS		10000
+/* walking 1/0 (64 bit data line) 영역, thread 당 */
+#define	MEM_TEST_WALK_KB		2048
+/* budget 확인 단위 */
+#define	MEM_TEST_CHUNK_MB		16
+#define	MEM_TEST_THREAD_MAX		16
+#define	MEM_TEST_ERR_MAX		8
+
+enum {
+	eMEM_BW_WRITE = 0,
+	eMEM_BW_READ,
+	eMEM_BW_COPY,
+	eMEM_BW_TRIAD,
+	eMEM_BW_END
+};
+
+enum {
+	eMEM_PASS = 0,
+	/* buffer 할당, thread 생성 실패 */
+	eMEM_ERROR,
+	/* data 오류 */
+	eMEM_FAULT,
+	/* bandwidth 기준 미달 */
+	eMEM_SLOW,
+	eMEM_VERDICT_END
+};
+
+struct mem_test_cfg {
+	/* 0 : online cpu 수 */
+	int		threads;
+	int		percent;
+	int		budget_ms;
+	/* MB/s, 0 : 판정 안함 (m1-test.cfg 'M', SKU 별) */
+	int		bw_min[eMEM_BW_END];
+};
+
+struct mem_test_error {
+	uint64_t	vaddr;
+	/* /proc/self/pagemap (root), 0 : 확인 안됨 */
+	uint64_t	paddr;
+	uint64_t	expect, actual;
+};
+
+struct mem_test_result {
+	int		verdict;
+	int		threads;
+	/* MB/s (전체 thread 합) */
+	int		bw[eMEM_BW_END];
+	/* eMEM_SLOW : 기준 미달 bandwidth (eMEM_BW_xxx) */
+	int		slow;
+	/* integrity test 크기 (MB), 완료된 pattern 수 (thread 최소), 1 : March C- 까지 완료 */
+	long	tested_mb;
+	int		passes;
+	int		complete;
+	unsigned long	errors;
+	int		err_cnt;
+	struct mem_test_error	err[MEM_TEST_ERR_MAX];
+	long	elapsed_ms;
+};
+
+//------------------------------------------------------------------------------
+extern const char	*mem_test_isa		(void);
+extern const char	*mem_test_bw_name	(int kind);
+extern void		mem_test_cfg_default	(struct mem_test_cfg *cfg);
+/* return 1 : pass, 0 : fail (res->verdict) */
+extern int		mem_test_run		(const struct mem_test_cfg *cfg, struct mem_test_result *res);
+/* response_str 용 (예 "3.92GB/s 812M", "ERR 2 f3a01040") */
+extern void		mem_test_summary	(const struct mem_test_result *res, char *buf, int size);
+
+//------------------------------------------------------------------------------
+#endif	// #define __MEM_TEST_H__
+//------------------------------------------------------------------------------
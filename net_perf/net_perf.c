@@ -0,0 +1,530 @@
+//------------------------------------------------------------------------------
+/**
+ * @file net_perf.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief in-process network throughput engine (iperf3 대체, sender/receiver).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "net_perf.h"
+
+//------------------------------------------------------------------------------
+/*
+	udp : sender는 sendmmsg로 NET_PERF_BATCH packet 단위 송신, receiver는 recvmmsg로 수신 후
+		  interval 마다 수신 속도/loss를 sender 주소로 report.
+	tcp : 연결 후 net_perf_hdr 1회 송신, 이후 data stream. report는 같은 연결로 전달.
+	sender는 receiver report 기준으로 target 속도가 유지되면 바로 측정을 종료.
+*/
+//------------------------------------------------------------------------------
+struct net_perf_rx {
+	uint32_t	session;
+	uint32_t	index;
+	uint32_t	next_seq;
+	uint32_t	interval_ms;
+	uint64_t	bytes;
+	uint32_t	pkts;
+	uint32_t	lost;
+	long		start_us;
+	long		last_us;
+};
+
+struct net_perf_tx {
+	const struct net_perf_cfg	*cfg;
+	net_perf_report_t			report;
+	void						*arg;
+	uint32_t	session;
+	int			rpt_cnt;
+	int			stable;
+	int			window[NET_PERF_STABLE_CNT * 4];
+	int			best;
+	int			done;
+};
+
+//------------------------------------------------------------------------------
+static long now_us (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return	ts.tv_sec * 1000000L + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+static void set_sock_buf (int fd)
+{
+	int size = NET_PERF_SOCK_BUF;
+
+	/* rmem_max/wmem_max 보다 큰 경우 FORCE 시도 (root) */
+	if (setsockopt (fd, SOL_SOCKET, SO_SNDBUFFORCE, &size, sizeof(size)))
+		setsockopt (fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+	if (setsockopt (fd, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)))
+		setsockopt (fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+}
+
+//------------------------------------------------------------------------------
+void net_perf_cfg_default (struct net_perf_cfg *cfg, const char *ip, int proto)
+{
+	memset (cfg, 0, sizeof(struct net_perf_cfg));
+	cfg->ip				= ip;
+	cfg->port			= NET_PERF_PORT;
+	cfg->proto			= proto;
+	cfg->pkt_size		= NET_PERF_PKT_SIZE;
+	cfg->interval_ms	= NET_PERF_INTERVAL_MS;
+	cfg->duration_ms	= NET_PERF_DURATION_MS;
+	cfg->stable_cnt		= NET_PERF_STABLE_CNT;
+}
+
+//------------------------------------------------------------------------------
+//
+// sender
+//
+//------------------------------------------------------------------------------
+static void tx_report (struct net_perf_tx *tx, const struct net_perf_rpt *rpt)
+{
+	int mbps, i, cnt, sum, stable_cnt = tx->cfg->stable_cnt;
+
+	if ((ntohl (rpt->magic) != NET_PERF_MAGIC) || (ntohl (rpt->session) != tx->session))
+		return;
+
+	mbps = ntohl (rpt->kbps) / 1000;
+	if (tx->report)
+		tx->report (ntohl (rpt->index), mbps, ntohl (rpt->lost), tx->arg);
+
+	tx->window[tx->rpt_cnt % stable_cnt] = mbps;
+	tx->rpt_cnt++;
+
+	/* 최근 stable_cnt interval 평균 */
+	cnt = tx->rpt_cnt < stable_cnt ? tx->rpt_cnt : stable_cnt;
+	for (i = 0, sum = 0; i < cnt; i++)
+		sum += tx->window[i];
+	if ((cnt == stable_cnt) && (tx->best < sum / cnt))
+		tx->best = sum / cnt;
+
+	if (tx->cfg->target_mbps) {
+		tx->stable = (mbps >= tx->cfg->target_mbps) ? tx->stable + 1 : 0;
+		if (tx->stable >= stable_cnt)
+			tx->done = 1;
+	}
+	/* 측정 시간이 짧아 window를 채우지 못한 경우 */
+	if (!tx->best && (cnt < stable_cnt))
+		tx->best = sum / cnt;
+}
+
+//------------------------------------------------------------------------------
+static int tx_connect (const struct net_perf_cfg *cfg, int type)
+{
+	struct sockaddr_in addr;
+	int fd;
+
+	memset (&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port   = htons (cfg->port);
+	if (inet_pton (AF_INET, cfg->ip, &addr.sin_addr) != 1)
+		return -1;
+
+	if ((fd = socket (AF_INET, type, 0)) < 0)
+		return -1;
+
+	set_sock_buf (fd);
+	if (connect (fd, (struct sockaddr *)&addr, sizeof(addr))) {
+		close (fd);
+		return -1;
+	}
+	return fd;
+}
+
+//------------------------------------------------------------------------------
+static int tx_udp (struct net_perf_tx *tx)
+{
+	const struct net_perf_cfg *cfg = tx->cfg;
+	struct mmsghdr msgs[NET_PERF_BATCH];
+	struct iovec iovs[NET_PERF_BATCH];
+	struct net_perf_hdr *hdr;
+	struct net_perf_rpt rpt;
+	char *buf;
+	long start, now, last_rpt;
+	uint64_t sent = 0;
+	uint32_t seq = 0;
+	int fd, i, ret;
+
+	if ((fd = tx_connect (cfg, SOCK_DGRAM)) < 0)
+		return -1;
+
+	if ((buf = calloc (NET_PERF_BATCH, cfg->pkt_size)) == NULL) {
+		close (fd);
+		return -1;
+	}
+	memset (msgs, 0, sizeof(msgs));
+	for (i = 0; i < NET_PERF_BATCH; i++) {
+		hdr = (struct net_perf_hdr *)(buf + i * cfg->pkt_size);
+		hdr->magic			= htonl (NET_PERF_MAGIC);
+		hdr->session		= htonl (tx->session);
+		hdr->interval_ms	= htonl (cfg->interval_ms);
+		iovs[i].iov_base	= hdr;
+		iovs[i].iov_len		= cfg->pkt_size;
+		msgs[i].msg_hdr.msg_iov		= &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen	= 1;
+	}
+
+	start = last_rpt = now_us ();
+	while (!tx->done) {
+		now = now_us ();
+		if ((now - start) / 1000 > cfg->duration_ms)
+			break;
+		/* receiver 미실행 (report 없음) */
+		if (!tx->rpt_cnt && ((now - last_rpt) / 1000 > NET_PERF_NO_REPORT_MS))
+			break;
+
+		/* 송신 속도 제한 (bits/usec == Mbits/s) */
+		if (cfg->rate_mbps && (sent * 8 > (uint64_t)cfg->rate_mbps * (now - start))) {
+			usleep (100);
+		} else {
+			for (i = 0; i < NET_PERF_BATCH; i++)
+				((struct net_perf_hdr *)iovs[i].iov_base)->seq = htonl (seq + i);
+
+			if ((ret = sendmmsg (fd, msgs, NET_PERF_BATCH, 0)) > 0) {
+				seq  += ret;
+				sent += (uint64_t)ret * cfg->pkt_size;
+			} else if ((errno == ECONNREFUSED) && !tx->rpt_cnt) {
+				/* icmp port unreachable : receiver 미실행 */
+				break;
+			} else if ((errno == ENOBUFS) || (errno == EAGAIN)) {
+				usleep (100);
+			}
+		}
+
+		while (recv (fd, &rpt, sizeof(rpt), MSG_DONTWAIT) == sizeof(rpt)) {
+			tx_report (tx, &rpt);
+			last_rpt = now_us ();
+		}
+	}
+
+	/* receiver session 종료 (udp 유실 대비 여러번 전송) */
+	hdr = (struct net_perf_hdr *)buf;
+	hdr->seq   = htonl (seq);
+	hdr->flags = htonl (NET_PERF_FLAG_FIN);
+	for (i = 0; i < 3; i++)
+		send (fd, hdr, sizeof(struct net_perf_hdr), 0);
+
+	free  (buf);
+	close (fd);
+	return	tx->rpt_cnt ? tx->best : -1;
+}
+
+//------------------------------------------------------------------------------
+static int tx_tcp (struct net_perf_tx *tx)
+{
+	const struct net_perf_cfg *cfg = tx->cfg;
+	struct net_perf_hdr hdr;
+	struct net_perf_rpt rpt;
+	struct pollfd pfd;
+	char *buf;
+	long start, now;
+	int fd, ret;
+
+	if ((fd = tx_connect (cfg, SOCK_STREAM)) < 0)
+		return -1;
+
+	if ((buf = calloc (1, NET_PERF_TCP_CHUNK)) == NULL) {
+		close (fd);
+		return -1;
+	}
+	memset (&hdr, 0, sizeof(hdr));
+	hdr.magic		= htonl (NET_PERF_MAGIC);
+	hdr.session		= htonl (tx->session);
+	hdr.interval_ms	= htonl (cfg->interval_ms);
+	if (send (fd, &hdr, sizeof(hdr), 0) != sizeof(hdr))
+		goto out;
+
+	pfd.fd     = fd;
+	pfd.events = POLLIN | POLLOUT;
+	start = now_us ();
+	while (!tx->done) {
+		now = now_us ();
+		if ((now - start) / 1000 > cfg->duration_ms)
+			break;
+		if (!tx->rpt_cnt && ((now - start) / 1000 > NET_PERF_NO_REPORT_MS))
+			break;
+		if (poll (&pfd, 1, cfg->interval_ms) <= 0)
+			continue;
+		if (pfd.revents & (POLLERR | POLLHUP))
+			break;
+		if (pfd.revents & POLLIN) {
+			if ((ret = recv (fd, &rpt, sizeof(rpt), MSG_WAITALL)) != sizeof(rpt))
+				break;
+			tx_report (tx, &rpt);
+		}
+		if (pfd.revents & POLLOUT) {
+			if ((send (fd, buf, NET_PERF_TCP_CHUNK, MSG_DONTWAIT | MSG_NOSIGNAL) < 0) &&
+				(errno != EAGAIN))
+				break;
+		}
+	}
+out:
+	shutdown (fd, SHUT_WR);
+	free  (buf);
+	close (fd);
+	return	tx->rpt_cnt ? tx->best : -1;
+}
+
+//------------------------------------------------------------------------------
+int net_perf_client (const struct net_perf_cfg *cfg, net_perf_report_t report, void *arg)
+{
+	struct net_perf_tx tx;
+
+	if ((cfg->ip == NULL) || (cfg->pkt_size < (int)sizeof(struct net_perf_hdr)) ||
+		(cfg->interval_ms <= 0) || (cfg->stable_cnt <= 0) ||
+		(cfg->stable_cnt > (int)(sizeof(tx.window) / sizeof(tx.window[0]))))
+		return -1;
+
+	memset (&tx, 0, sizeof(tx));
+	tx.cfg     = cfg;
+	tx.report  = report;
+	tx.arg     = arg;
+	tx.session = (uint32_t)(now_us () ^ (getpid () << 16));
+
+	return	(cfg->proto == NET_PERF_TCP) ? tx_tcp (&tx) : tx_udp (&tx);
+}
+
+//------------------------------------------------------------------------------
+//
+// receiver
+//
+//------------------------------------------------------------------------------
+static void rx_reset (struct net_perf_rx *rx, uint32_t session, uint32_t interval_ms)
+{
+	memset (rx, 0, sizeof(struct net_perf_rx));
+	rx->session     = session;
+	rx->interval_ms = interval_ms ? interval_ms : NET_PERF_INTERVAL_MS;
+	rx->start_us    = rx->last_us = now_us ();
+}
+
+//------------------------------------------------------------------------------
+static void rx_make_report (struct net_perf_rx *rx, struct net_perf_rpt *rpt, long now)
+{
+	long usec = now - rx->start_us;
+
+	if (usec <= 0)
+		usec = 1;
+
+	rpt->magic		= htonl (NET_PERF_MAGIC);
+	rpt->session	= htonl (rx->session);
+	rpt->index		= htonl (rx->index);
+	/* bits/usec == Mbits/s, kbps 단위로 전달 */
+	rpt->kbps		= htonl ((uint32_t)(rx->bytes * 8 * 1000 / usec));
+	rpt->pkts		= htonl (rx->pkts);
+	rpt->lost		= htonl (rx->lost);
+	rpt->usec		= htonl ((uint32_t)usec);
+
+	rx->index++;
+	rx->bytes = 0;
+	rx->pkts  = 0;
+	rx->lost  = 0;
+	rx->start_us = now;
+}
+
+//------------------------------------------------------------------------------
+static void rx_udp (int fd, struct net_perf_rx *rx, struct sockaddr_in *peer, char *buf)
+{
+	struct mmsghdr msgs[NET_PERF_BATCH];
+	struct iovec iovs[NET_PERF_BATCH];
+	struct sockaddr_in addrs[NET_PERF_BATCH];
+	struct net_perf_hdr *hdr;
+	struct net_perf_rpt rpt;
+	uint32_t seq;
+	int i, cnt;
+
+	memset (msgs, 0, sizeof(msgs));
+	for (i = 0; i < NET_PERF_BATCH; i++) {
+		iovs[i].iov_base = buf + i * NET_PERF_PKT_SIZE;
+		iovs[i].iov_len  = NET_PERF_PKT_SIZE;
+		msgs[i].msg_hdr.msg_iov     = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen  = 1;
+		msgs[i].msg_hdr.msg_name    = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+	}
+	if ((cnt = recvmmsg (fd, msgs, NET_PERF_BATCH, MSG_DONTWAIT, NULL)) <= 0)
+		return;
+
+	for (i = 0; i < cnt; i++) {
+		hdr = (struct net_perf_hdr *)iovs[i].iov_base;
+		if ((msgs[i].msg_len < sizeof(struct net_perf_hdr)) ||
+			(ntohl (hdr->magic) != NET_PERF_MAGIC))
+			continue;
+
+		/* 새로운 sender session */
+		if (ntohl (hdr->session) != rx->session) {
+			rx_reset (rx, ntohl (hdr->session), ntohl (hdr->interval_ms));
+			memcpy (peer, &addrs[i], sizeof(struct sockaddr_in));
+		}
+		seq = ntohl (hdr->seq);
+		if (ntohl (hdr->flags) & NET_PERF_FLAG_FIN) {
+			if (rx->bytes) {
+				rx_make_report (rx, &rpt, now_us ());
+				sendto (fd, &rpt, sizeof(rpt), 0, (struct sockaddr *)peer, sizeof(*peer));
+			}
+			rx->session = 0;
+			continue;
+		}
+		if (seq > rx->next_seq)
+			rx->lost += seq - rx->next_seq;
+		if (seq >= rx->next_seq)
+			rx->next_seq = seq + 1;
+
+		rx->bytes += msgs[i].msg_len;
+		rx->pkts++;
+	}
+	rx->last_us = now_us ();
+}
+
+//------------------------------------------------------------------------------
+static int rx_tcp (int fd, struct net_perf_rx *rx, char *buf, int size)
+{
+	struct net_perf_hdr hdr;
+	int len;
+
+	/* 연결 후 첫 수신은 header */
+	if (!rx->session) {
+		if (recv (fd, &hdr, sizeof(hdr), MSG_WAITALL) != sizeof(hdr))
+			return -1;
+		if (ntohl (hdr.magic) != NET_PERF_MAGIC)
+			return -1;
+		rx_reset (rx, ntohl (hdr.session), ntohl (hdr.interval_ms));
+		return 0;
+	}
+	if ((len = recv (fd, buf, size, MSG_DONTWAIT)) <= 0)
+		return (len < 0 && errno == EAGAIN) ? 0 : -1;
+
+	rx->bytes += len;
+	rx->pkts++;
+	rx->last_us = now_us ();
+	return len;
+}
+
+//------------------------------------------------------------------------------
+static int rx_socket (int type, int port)
+{
+	struct sockaddr_in addr;
+	int fd, on = 1;
+
+	if ((fd = socket (AF_INET, type, 0)) < 0)
+		return -1;
+
+	setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	set_sock_buf (fd);
+
+	memset (&addr, 0, sizeof(addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_port        = htons (port);
+	addr.sin_addr.s_addr = htonl (INADDR_ANY);
+	if (bind (fd, (struct sockaddr *)&addr, sizeof(addr))) {
+		close (fd);
+		return -1;
+	}
+	if ((type == SOCK_STREAM) && listen (fd, 1)) {
+		close (fd);
+		return -1;
+	}
+	return fd;
+}
+
+//------------------------------------------------------------------------------
+int net_perf_server (int port, volatile char *stop)
+{
+	struct net_perf_rx urx, trx;
+	struct net_perf_rpt rpt;
+	struct sockaddr_in peer;
+	struct pollfd pfd[3];
+	int ufd, lfd, cfd = -1, nfd;
+	char *buf;
+	long now;
+
+	if ((buf = malloc (NET_PERF_BATCH * NET_PERF_PKT_SIZE)) == NULL)
+		return -1;
+
+	ufd = rx_socket (SOCK_DGRAM,  port);
+	lfd = rx_socket (SOCK_STREAM, port);
+	if ((ufd < 0) || (lfd < 0)) {
+		fprintf (stderr, "%s : port %d bind error (%s)\n", __func__, port, strerror (errno));
+		if (ufd >= 0)	close (ufd);
+		if (lfd >= 0)	close (lfd);
+		free (buf);
+		return -1;
+	}
+	memset (&urx, 0, sizeof(urx));
+	memset (&trx, 0, sizeof(trx));
+	memset (&peer, 0, sizeof(peer));
+	printf ("%s : udp/tcp receiver port = %d\n", __func__, port);
+
+	while ((stop == NULL) || !*stop) {
+		pfd[0].fd = ufd;	pfd[0].events = POLLIN;
+		pfd[1].fd = lfd;	pfd[1].events = POLLIN;
+		pfd[2].fd = cfd;	pfd[2].events = POLLIN;
+		nfd = (cfd < 0) ? 2 : 3;
+
+		if (poll (pfd, nfd, 50) > 0) {
+			if (pfd[0].revents & POLLIN)
+				rx_udp (ufd, &urx, &peer, buf);
+
+			if (pfd[1].revents & POLLIN) {
+				/* 동시 측정은 1 연결만 허용, 새로운 연결로 교체 */
+				if (cfd >= 0)
+					close (cfd);
+				if ((cfd = accept (lfd, NULL, NULL)) >= 0) {
+					int on = 1;
+					setsockopt (cfd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+				}
+				memset (&trx, 0, sizeof(trx));
+			}
+			if ((nfd == 3) && (pfd[2].revents & (POLLIN | POLLHUP | POLLERR))) {
+				if (rx_tcp (cfd, &trx, buf, NET_PERF_BATCH * NET_PERF_PKT_SIZE) < 0) {
+					close (cfd);
+					cfd = -1;
+					memset (&trx, 0, sizeof(trx));
+				}
+			}
+		}
+
+		now = now_us ();
+		if (urx.session) {
+			if ((now - urx.last_us) / 1000 > NET_PERF_IDLE_MS)
+				urx.session = 0;
+			else if ((now - urx.start_us) / 1000 >= urx.interval_ms) {
+				rx_make_report (&urx, &rpt, now);
+				sendto (ufd, &rpt, sizeof(rpt), 0, (struct sockaddr *)&peer, sizeof(peer));
+			}
+		}
+		if ((cfd >= 0) && trx.session && ((now - trx.start_us) / 1000 >= trx.interval_ms)) {
+			rx_make_report (&trx, &rpt, now);
+			send (cfd, &rpt, sizeof(rpt), MSG_NOSIGNAL);
+		}
+	}
+
+	if (cfd >= 0)
+		close (cfd);
+	close (ufd);
+	close (lfd);
+	free  (buf);
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
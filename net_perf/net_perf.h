@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+/**
+ * @file net_perf.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief in-process network throughput engine (iperf3 대체, sender/receiver).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __NET_PERF_H__
+#define __NET_PERF_H__
+
+//------------------------------------------------------------------------------
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+#define	NET_PERF_PORT			5202
+#define	NET_PERF_MAGIC			0x4E504552	/* "NPER" */
+
+#define	NET_PERF_UDP			0
+#define	NET_PERF_TCP			1
+
+/* udp payload (1500 mtu - ip/udp header 28 bytes, fragment 방지) */
+#define	NET_PERF_PKT_SIZE		1472
+/* sendmmsg/recvmmsg 1회 처리 packet 수 */
+#define	NET_PERF_BATCH			64
+#define	NET_PERF_SOCK_BUF		(4 * 1024 * 1024)
+#define	NET_PERF_TCP_CHUNK		(128 * 1024)
+
+/* receiver 측정 주기, 최대 측정 시간 */
+#define	NET_PERF_INTERVAL_MS	250
+#define	NET_PERF_DURATION_MS	10000
+/* target 이상 속도가 연속 STABLE_CNT interval 유지되면 측정 종료 */
+#define	NET_PERF_STABLE_CNT		4
+/* receiver 응답이 없는 경우 (receiver 미실행) 측정 실패 처리 */
+#define	NET_PERF_NO_REPORT_MS	1500
+/* receiver session 유지 시간 (sender 중단 시 session 초기화) */
+#define	NET_PERF_IDLE_MS		2000
+
+#define	NET_PERF_FLAG_FIN		0x01
+
+/* sender -> receiver (udp 모든 packet의 앞부분, tcp 연결 후 1회), network byte order */
+struct net_perf_hdr {
+	uint32_t	magic;
+	uint32_t	session;
+	uint32_t	seq;
+	uint32_t	flags;
+	uint32_t	interval_ms;
+};
+
+/* receiver -> sender (interval 마다), network byte order */
+struct net_perf_rpt {
+	uint32_t	magic;
+	uint32_t	session;
+	uint32_t	index;
+	uint32_t	kbps;
+	uint32_t	pkts;
+	uint32_t	lost;
+	uint32_t	usec;
+};
+
+struct net_perf_cfg {
+	const char	*ip;
+	int			port;
+	/* NET_PERF_UDP, NET_PERF_TCP */
+	int			proto;
+	int			pkt_size;
+	int			interval_ms;
+	int			duration_ms;
+	/* 0 : 조기 종료 없이 duration 동안 측정 */
+	int			target_mbps;
+	int			stable_cnt;
+	/* udp 송신 속도 제한, 0 : 제한 없음 */
+	int			rate_mbps;
+};
+
+/* interval 결과 전달 (receiver 측정 기준) */
+typedef void (*net_perf_report_t)(int index, int mbps, int lost, void *arg);
+
+//------------------------------------------------------------------------------
+extern void	net_perf_cfg_default	(struct net_perf_cfg *cfg, const char *ip, int proto);
+/* return : 연속 STABLE_CNT interval 평균의 최대값 (Mbits/s), -1 : receiver 응답 없음 */
+extern int	net_perf_client			(const struct net_perf_cfg *cfg,
+									net_perf_report_t report, void *arg);
+/* udp/tcp 동시 receiver, *stop 이 set 될 때까지 실행 */
+extern int	net_perf_server			(int port, volatile char *stop);
+
+//------------------------------------------------------------------------------
+#endif	// #define __NET_PERF_H__
+//------------------------------------------------------------------------------
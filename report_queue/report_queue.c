@@ -0,0 +1,574 @@
+//------------------------------------------------------------------------------
+/**
+ * @file report_queue.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief async batched result reporting to the nlp server (retry, spool file).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "../event_notify/event_notify.h"
+#include "../trace/trace.h"
+#include "report_queue.h"
+
+//------------------------------------------------------------------------------
+/*
+	test thread 는 enqueue 만 하고 (block 없음), 전송은 report_queue_thread 1개가 처리.
+	eREPORT_NLP    : nlp_send callback 으로 바로 전송 (label print).
+	eREPORT_RECORD : eREPORT_FLUSH 가 올 때까지 batch buffer 에 모은 후 1 frame 으로 전송.
+	                 (server port 0 인 경우 record/frame 은 버림)
+	전송 실패시 backoff 재시도, 계속 실패하면 frame/nlp 메시지를 spool file 에 저장 후
+	다음 전송 성공시 (또는 REPORT_SPOOL_RETRY_MS 주기로) 저장된 순서대로 재전송.
+*/
+//------------------------------------------------------------------------------
+/* server 응답이 없는 동안 spool file 재전송 시도 주기 */
+#define	REPORT_SPOOL_RETRY_MS	10000
+
+struct report_entry {
+	int		type;
+	int		mtype;
+	char	msg[REPORT_MSG_SIZE];
+};
+
+static struct report_entry	Queue[REPORT_QUEUE_MAX];
+static int					QHead = 0, QCount = 0, QBusy = 0;
+static pthread_mutex_t		QLock = PTHREAD_MUTEX_INITIALIZER;
+static struct event_notify	QNotify;
+
+static char					ServerIP[20] = {0,};
+static int					ServerPort = REPORT_PORT;
+static char					SpoolFile[256] = REPORT_SPOOL_FILE;
+static report_nlp_send_t	NlpSend = NULL;
+static void					*NlpArg = NULL;
+
+/* 전송 실패 상태, 다음 성공까지 재시도 없이 1회만 시도 (queue 적체 방지) */
+static int					Offline = 0;
+
+static char					Batch[REPORT_BATCH_SIZE];
+static int					BatchLen = 0;
+
+//------------------------------------------------------------------------------
+static long now_ms (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return	ts.tv_sec * 1000L + ts.tv_nsec / 1000000;
+}
+
+//------------------------------------------------------------------------------
+int report_queue_init (const char *spool_file, report_nlp_send_t nlp_send, void *arg)
+{
+	pthread_mutex_lock (&QLock);
+	QHead = QCount = QBusy = 0;
+	BatchLen = 0;
+	Offline  = 0;
+	NlpSend  = nlp_send;
+	NlpArg   = arg;
+	snprintf (SpoolFile, sizeof(SpoolFile), "%s", spool_file ? spool_file : REPORT_SPOOL_FILE);
+	pthread_mutex_unlock (&QLock);
+
+	event_notify_init (&QNotify);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+void report_queue_server (const char *ip, int port)
+{
+	pthread_mutex_lock (&QLock);
+	snprintf (ServerIP, sizeof(ServerIP), "%s", ip ? ip : "");
+	ServerPort = port;
+	Offline    = 0;
+	pthread_mutex_unlock (&QLock);
+
+	event_notify_post (&QNotify);
+}
+
+//------------------------------------------------------------------------------
+static int enqueue (int type, int mtype, const char *msg)
+{
+	struct report_entry *e;
+
+	pthread_mutex_lock (&QLock);
+	if (QCount >= REPORT_QUEUE_MAX) {
+		pthread_mutex_unlock (&QLock);
+		fprintf (stderr, "%s : queue full, drop (%s)\n", __func__, msg);
+		return -1;
+	}
+	e = &Queue[(QHead + QCount) % REPORT_QUEUE_MAX];
+	e->type  = type;
+	e->mtype = mtype;
+	snprintf (e->msg, sizeof(e->msg), "%s", msg);
+	QCount++;
+	pthread_mutex_unlock (&QLock);
+
+	event_notify_post (&QNotify);
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+int report_queue_nlp (int mtype, const char *msg)
+{
+	return	enqueue (eREPORT_NLP, mtype, msg);
+}
+
+//------------------------------------------------------------------------------
+int report_queue_record (const char *fmt, ...)
+{
+	char msg[REPORT_MSG_SIZE];
+	va_list va;
+
+	va_start (va, fmt);
+	vsnprintf (msg, sizeof(msg), fmt, va);
+	va_end (va);
+
+	return	enqueue (eREPORT_RECORD, 0, msg);
+}
+
+//------------------------------------------------------------------------------
+int report_queue_flush (void)
+{
+	return	enqueue (eREPORT_FLUSH, 0, "");
+}
+
+//------------------------------------------------------------------------------
+int report_queue_pending (void)
+{
+	int cnt;
+
+	pthread_mutex_lock (&QLock);
+	cnt = QCount + QBusy;
+	pthread_mutex_unlock (&QLock);
+	return cnt;
+}
+
+//------------------------------------------------------------------------------
+int report_queue_drain (int timeout_ms)
+{
+	long start = now_ms ();
+
+	while (report_queue_pending ()) {
+		if ((now_ms () - start) > timeout_ms)
+			return 0;
+		usleep (10000);
+	}
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+static int dequeue (struct report_entry *e)
+{
+	pthread_mutex_lock (&QLock);
+	if (!QCount) {
+		QBusy = 0;
+		pthread_mutex_unlock (&QLock);
+		return 0;
+	}
+	memcpy (e, &Queue[QHead], sizeof(struct report_entry));
+	QHead = (QHead + 1) % REPORT_QUEUE_MAX;
+	QCount--;
+	/* 처리 완료 전까지 pending 으로 표시 (drain) */
+	QBusy = 1;
+	pthread_mutex_unlock (&QLock);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+//
+// frame 전송
+//
+//------------------------------------------------------------------------------
+static int io_wait (int fd, short events, int timeout_ms)
+{
+	struct pollfd pfd;
+
+	pfd.fd      = fd;
+	pfd.events  = events;
+	pfd.revents = 0;
+	return	(poll (&pfd, 1, timeout_ms) > 0) ? pfd.revents : 0;
+}
+
+//------------------------------------------------------------------------------
+static int server_connect (void)
+{
+	struct sockaddr_in addr;
+	int fd, err = 0;
+	socklen_t len = sizeof(err);
+
+	memset (&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port   = htons (ServerPort);
+	if (inet_pton (AF_INET, ServerIP, &addr.sin_addr) != 1)
+		return -1;
+
+	if ((fd = socket (AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0)
+		return -1;
+
+	/* 연결 timeout 을 위해 non-blocking connect */
+	if (connect (fd, (struct sockaddr *)&addr, sizeof(addr)) && (errno != EINPROGRESS))
+		goto err_out;
+	if (!(io_wait (fd, POLLOUT, REPORT_IO_TIMEOUT_MS) & POLLOUT))
+		goto err_out;
+	if (getsockopt (fd, SOL_SOCKET, SO_ERROR, &err, &len) || err)
+		goto err_out;
+	return fd;
+err_out:
+	close (fd);
+	return -1;
+}
+
+//------------------------------------------------------------------------------
+static int frame_send (const char *payload, int len)
+{
+	char hdr[32], ack[8];
+	int fd, hlen, pos, ret, ok = 0;
+	long t = trace_now_us ();
+
+	if ((fd = server_connect ()) < 0) {
+		trace_end ("call", "report_frame", t, -1);
+		return -1;
+	}
+
+	hlen = snprintf (hdr, sizeof(hdr), "%s %d\n", REPORT_FRAME_MAGIC, len);
+	for (pos = 0; pos < hlen + len; pos += ret) {
+		if (!(io_wait (fd, POLLOUT, REPORT_IO_TIMEOUT_MS) & POLLOUT))
+			goto out;
+		if (pos < hlen)
+			ret = send (fd, hdr + pos, hlen - pos, MSG_NOSIGNAL);
+		else
+			ret = send (fd, payload + pos - hlen, hlen + len - pos, MSG_NOSIGNAL);
+		if (ret <= 0)
+			goto out;
+	}
+	/* server 가 frame 을 받았다는 응답을 확인해야 전송 완료 */
+	if (io_wait (fd, POLLIN, REPORT_IO_TIMEOUT_MS) & POLLIN) {
+		memset (ack, 0, sizeof(ack));
+		if ((recv (fd, ack, sizeof(ack) - 1, 0) >= 2) && !strncmp (ack, "OK", 2))
+			ok = 1;
+	}
+out:
+	close (fd);
+	trace_end ("call", "report_frame", t, ok ? len : -1);
+	return ok ? 0 : -1;
+}
+
+//------------------------------------------------------------------------------
+static int backoff_sleep (int retry, volatile char *stop)
+{
+	int ms = REPORT_BACKOFF_MS << retry;
+
+	while ((ms > 0) && !*stop) {
+		usleep (50000);
+		ms -= 50;
+	}
+	return *stop ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+static int send_retry (int (*send_fn)(const void *, int), const void *data, int len,
+						volatile char *stop)
+{
+	int retry;
+
+	for (retry = 0; retry < REPORT_RETRY_MAX; retry++) {
+		if (!send_fn (data, len)) {
+			Offline = 0;
+			return 0;
+		}
+		/* server 응답이 없는 상태에서는 재시도 없이 바로 실패 처리 */
+		if (Offline || !backoff_sleep (retry, stop))
+			break;
+	}
+	Offline = 1;
+	return -1;
+}
+
+//------------------------------------------------------------------------------
+static int frame_send_fn (const void *data, int len)
+{
+	return	frame_send ((const char *)data, len);
+}
+
+//------------------------------------------------------------------------------
+static int nlp_send_fn (const void *data, int mtype)
+{
+	if (!NlpSend)
+		return 0;
+	return	NlpSend (mtype, (const char *)data, NlpArg);
+}
+
+//------------------------------------------------------------------------------
+//
+// spool file : 전송하지 못한 frame (M1RPT) 과 nlp 메시지 (M1NLP) 를 header 포함 그대로 저장
+//
+//------------------------------------------------------------------------------
+static void spool_append (int mtype, const char *payload, int len)
+{
+	FILE *fp;
+
+	if ((fp = fopen (SpoolFile, "a")) == NULL) {
+		fprintf (stderr, "%s : %s open error (%s)\n", __func__, SpoolFile, strerror (errno));
+		return;
+	}
+	if (mtype < 0)
+		fprintf (fp, "%s %d\n", REPORT_FRAME_MAGIC, len);
+	else
+		fprintf (fp, "%s %d %d\n", REPORT_NLP_MAGIC, mtype, len);
+	fwrite  (payload, 1, len, fp);
+	fclose  (fp);
+	fprintf (stderr, "%s : server unreachable, %d bytes saved to %s\n", __func__, len, SpoolFile);
+}
+
+//------------------------------------------------------------------------------
+// 전송하지 못한 나머지 (offset 이후) 만 spool file 에 남김 (이미 전송된 항목 중복 방지)
+//------------------------------------------------------------------------------
+static void spool_keep (FILE *fp, long offset)
+{
+	char tmp[sizeof(SpoolFile) + 8], buf[1024];
+	FILE *out;
+	size_t n;
+
+	snprintf (tmp, sizeof(tmp), "%s.tmp", SpoolFile);
+	if (fseek (fp, offset, SEEK_SET) || ((out = fopen (tmp, "w")) == NULL))
+		return;
+	while ((n = fread (buf, 1, sizeof(buf), fp)) > 0)
+		fwrite (buf, 1, n, out);
+	if (fclose (out) || rename (tmp, SpoolFile))
+		unlink (tmp);
+}
+
+//------------------------------------------------------------------------------
+static int spool_exist (void)
+{
+	return	access (SpoolFile, F_OK) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+static void spool_replay (void)
+{
+	FILE *fp;
+	char magic[8], *buf;
+	int mtype, len, sent = 0, fail = 0;
+	long offset;
+
+	if ((fp = fopen (SpoolFile, "r")) == NULL)
+		return;
+	if ((buf = malloc (REPORT_BATCH_SIZE + 1)) == NULL) {
+		fclose (fp);
+		return;
+	}
+	for (offset = 0; fscanf (fp, "%7s", magic) == 1; offset = ftell (fp)) {
+		mtype = -1;
+		if (!strcmp (magic, REPORT_NLP_MAGIC)) {
+			if (fscanf (fp, "%d", &mtype) != 1)
+				break;
+		} else if (strcmp (magic, REPORT_FRAME_MAGIC))
+			break;
+		if ((fscanf (fp, "%d", &len) != 1) || (len < 0) || (len > REPORT_BATCH_SIZE)
+			|| (fgetc (fp) != '\n') || (fread (buf, 1, len, fp) != (size_t)len))
+			break;
+		buf[len] = 0;
+
+		/* frame 전송을 사용하지 않는 경우 (port 0) 저장된 frame 은 버림 */
+		if ((mtype < 0) ? (ServerPort && frame_send (buf, len)) : nlp_send_fn (buf, mtype)) {
+			fail = 1;
+			break;
+		}
+		sent++;
+	}
+
+	/* 전송된 항목까지 제거 (실패한 항목부터 다음 replay 에서 재전송) */
+	if (fail)
+		spool_keep (fp, offset);
+	fclose (fp);
+	free (buf);
+
+	if (!fail) {
+		unlink (SpoolFile);
+		printf ("%s : %d entries sent from %s\n", __func__, sent, SpoolFile);
+	}
+	Offline = fail;
+}
+
+//------------------------------------------------------------------------------
+// 새 항목 전송 전에 spool 에 남은 항목을 먼저 전송 (server 출력 순서 유지).
+// return 1 : spool 이 남아있음 (새 항목도 spool 뒤에 저장)
+//------------------------------------------------------------------------------
+static int spool_pending (void)
+{
+	if (!spool_exist ())
+		return 0;
+	spool_replay ();
+	return	spool_exist ();
+}
+
+//------------------------------------------------------------------------------
+static void process (struct report_entry *e, volatile char *stop)
+{
+	int len;
+
+	switch (e->type) {
+		case	eREPORT_NLP:
+			if (spool_pending () || send_retry (nlp_send_fn, e->msg, e->mtype, stop))
+				spool_append (e->mtype, e->msg, strlen (e->msg));
+			break;
+
+		case	eREPORT_RECORD:
+			if (!ServerPort)
+				break;
+			len = strlen (e->msg);
+			/* batch 가 가득 찬 경우 현재까지 frame 을 먼저 전송 */
+			if (BatchLen + len + 1 > REPORT_BATCH_SIZE) {
+				struct report_entry flush = { eREPORT_FLUSH, 0, "" };
+				process (&flush, stop);
+			}
+			memcpy (&Batch[BatchLen], e->msg, len);
+			BatchLen += len;
+			Batch[BatchLen++] = '\n';
+			break;
+
+		case	eREPORT_FLUSH:
+			if (!BatchLen)
+				break;
+			if (spool_pending () || send_retry (frame_send_fn, Batch, BatchLen, stop))
+				spool_append (-1, Batch, BatchLen);
+			BatchLen = 0;
+			break;
+
+		default:
+			break;
+	}
+}
+
+//------------------------------------------------------------------------------
+void *report_queue_thread (void *stop_flag)
+{
+	volatile char *stop = (volatile char *)stop_flag;
+	struct report_entry e;
+	unsigned int seq = event_notify_seq (&QNotify);
+	long spool_retry = now_ms ();
+
+	while (!*stop) {
+		/* server ip 확인 전에는 queue 유지 */
+		if (!ServerIP[0]) {
+			event_notify_wait (&QNotify, &seq, 500);
+			continue;
+		}
+		while (!*stop && dequeue (&e))
+			process (&e, stop);
+
+		if ((now_ms () - spool_retry) > REPORT_SPOOL_RETRY_MS) {
+			if (spool_exist ())
+				spool_replay ();
+			spool_retry = now_ms ();
+		}
+		event_notify_wait (&QNotify, &seq, 500);
+	}
+	/* 종료시 전송하지 못한 batch 는 spool file 에 저장 */
+	if (BatchLen)
+		spool_append (-1, Batch, BatchLen);
+	BatchLen = 0;
+	return NULL;
+}
+
+//------------------------------------------------------------------------------
+//
+// 수신 test server
+//
+//------------------------------------------------------------------------------
+static int recv_frame (int fd, char *buf, int size)
+{
+	char hdr[32], magic[8];
+	int pos = 0, len, ret;
+
+	/* header line */
+	while (pos < (int)sizeof(hdr) - 1) {
+		if (!(io_wait (fd, POLLIN, REPORT_IO_TIMEOUT_MS) & (POLLIN | POLLHUP)))
+			return -1;
+		if (recv (fd, &hdr[pos], 1, 0) != 1)
+			return -1;
+		if (hdr[pos++] == '\n')
+			break;
+	}
+	hdr[pos] = 0;
+	if ((sscanf (hdr, "%7s %d", magic, &len) != 2) || strcmp (magic, REPORT_FRAME_MAGIC)
+		|| (len < 0) || (len >= size))
+		return -1;
+
+	for (pos = 0; pos < len; pos += ret) {
+		if (!(io_wait (fd, POLLIN, REPORT_IO_TIMEOUT_MS) & (POLLIN | POLLHUP)))
+			return -1;
+		if ((ret = recv (fd, buf + pos, len - pos, 0)) <= 0)
+			return -1;
+	}
+	buf[len] = 0;
+	return len;
+}
+
+//------------------------------------------------------------------------------
+int report_server (int port, volatile char *stop)
+{
+	struct sockaddr_in addr, peer;
+	socklen_t plen;
+	int lfd, cfd, len, on = 1;
+	char *buf, ip[INET_ADDRSTRLEN];
+
+	if ((buf = malloc (REPORT_BATCH_SIZE + 1)) == NULL)
+		return -1;
+
+	memset (&addr, 0, sizeof(addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_port        = htons (port ? port : REPORT_PORT);
+	addr.sin_addr.s_addr = htonl (INADDR_ANY);
+
+	if (((lfd = socket (AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0)) < 0)
+		|| setsockopt (lfd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on))
+		|| bind (lfd, (struct sockaddr *)&addr, sizeof(addr)) || listen (lfd, 4)) {
+		fprintf (stderr, "%s : port %d bind error (%s)\n", __func__, port, strerror (errno));
+		if (lfd >= 0)
+			close (lfd);
+		free (buf);
+		return -1;
+	}
+	printf ("%s : report receiver port = %d\n", __func__, ntohs (addr.sin_port));
+
+	while ((stop == NULL) || !*stop) {
+		if (!(io_wait (lfd, POLLIN, 50) & POLLIN))
+			continue;
+
+		plen = sizeof(peer);
+		if ((cfd = accept (lfd, (struct sockaddr *)&peer, &plen)) < 0)
+			continue;
+
+		if ((len = recv_frame (cfd, buf, REPORT_BATCH_SIZE + 1)) >= 0) {
+			inet_ntop (AF_INET, &peer.sin_addr, ip, sizeof(ip));
+			printf ("%s : %s, %d bytes\n%s", __func__, ip, len, buf);
+			fflush (stdout);
+			send (cfd, "OK\n", 3, MSG_NOSIGNAL);
+		}
+		close (cfd);
+	}
+	close (lfd);
+	free (buf);
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------
+/**
+ * @file report_queue.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief async batched result reporting to the nlp server (retry, spool file).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __REPORT_QUEUE_H__
+#define __REPORT_QUEUE_H__
+
+//------------------------------------------------------------------------------
+#define	REPORT_PORT				5203
+#define	REPORT_QUEUE_MAX		128
+#define	REPORT_MSG_SIZE			192
+#define	REPORT_BATCH_SIZE		8192
+/* 전송 실패시 재시도 (REPORT_BACKOFF_MS 부터 2배씩 증가) 후 spool file 에 저장 */
+#define	REPORT_RETRY_MAX		5
+#define	REPORT_BACKOFF_MS		200
+#define	REPORT_IO_TIMEOUT_MS	1000
+/* working directory 와 관계없이 result log 와 같은 persistent partition 사용 */
+#define	REPORT_SPOOL_FILE		"/media/boot/m1-report.spool"
+
+/* frame : "M1RPT {payload length}\n{payload}", 수신측 응답 "OK\n" */
+#define	REPORT_FRAME_MAGIC		"M1RPT"
+/* spool file 의 nlp 메시지 : "M1NLP {mtype} {msg length}\n{msg}" */
+#define	REPORT_NLP_MAGIC		"M1NLP"
+
+enum {
+	/* nlp_server_write (label print) 메시지 */
+	eREPORT_NLP = 0,
+	/* 결과 record (1 line), FLUSH 까지 모아서 1 frame 으로 전송 */
+	eREPORT_RECORD,
+	eREPORT_FLUSH,
+};
+
+/* return 0 : 전송 성공 */
+typedef int (*report_nlp_send_t)(int mtype, const char *msg, void *arg);
+
+//------------------------------------------------------------------------------
+extern int	report_queue_init	(const char *spool_file, report_nlp_send_t nlp_send, void *arg);
+/*
+	전송 대상 server 설정 (server ip 확인 전에 queue 된 메시지는 설정 후 전송)
+	port 0 : 결과 frame 전송 안함 (nlp 메시지만 전송, record 는 버림)
+*/
+extern void	report_queue_server	(const char *ip, int port);
+/* enqueue 는 block 되지 않음, return -1 : queue full */
+extern int	report_queue_nlp	(int mtype, const char *msg);
+extern int	report_queue_record	(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+extern int	report_queue_flush	(void);
+extern int	report_queue_pending(void);
+/* queue 가 비워질 때까지 대기, return 1 : 완료, 0 : timeout */
+extern int	report_queue_drain	(int timeout_ms);
+extern void	*report_queue_thread(void *stop_flag);
+
+/* 수신 test server (frame 출력 후 "OK" 응답), *stop 이 set 될 때까지 실행 */
+extern int	report_server		(int port, volatile char *stop);
+
+//------------------------------------------------------------------------------
+#endif	// #define __REPORT_QUEUE_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,483 @@
+//------------------------------------------------------------------------------
+/**
+ * @file result_log.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief append-only binary board result log and fleet statistics query.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <libgen.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "result_log.h"
+
+//------------------------------------------------------------------------------
+#define	REC_SIZE	((int)sizeof(struct result_log_rec))
+#define	HDR_SIZE	((int)sizeof(struct result_log_hdr))
+/* crc 계산 범위 : time ~ record 끝 */
+#define	CRC_OFFSET	8
+
+//------------------------------------------------------------------------------
+uint32_t result_log_crc32 (const void *data, int size)
+{
+	static uint32_t table[256];
+	const uint8_t *p = (const uint8_t *)data;
+	uint32_t crc = 0xFFFFFFFF;
+	int i, j;
+
+	if (!table[1]) {
+		for (i = 0; i < 256; i++) {
+			uint32_t c = i;
+			for (j = 0; j < 8; j++)
+				c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+			table[i] = c;
+		}
+	}
+	while (size--)
+		crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+
+	return	crc ^ 0xFFFFFFFF;
+}
+
+//------------------------------------------------------------------------------
+static int rec_valid (const struct result_log_rec *rec)
+{
+	if (rec->magic != RESULT_LOG_REC_MAGIC)
+		return 0;
+	if (rec->item_cnt > RESULT_LOG_ITEM_MAX)
+		return 0;
+	return	(rec->crc == result_log_crc32 ((const uint8_t *)rec + CRC_OFFSET, REC_SIZE - CRC_OFFSET));
+}
+
+//------------------------------------------------------------------------------
+void result_log_set_mac (struct result_log_rec *rec, const char *mac_str)
+{
+	unsigned int v;
+	char hex[3] = {0,};
+	int i;
+
+	memset (rec->mac, 0, sizeof(rec->mac));
+	if (strlen (mac_str) < 12)
+		return;
+	for (i = 0; i < 6; i++) {
+		hex[0] = mac_str[i * 2];	hex[1] = mac_str[i * 2 + 1];
+		if (sscanf (hex, "%02x", &v) != 1)
+			return;
+		rec->mac[i] = v;
+	}
+}
+
+//------------------------------------------------------------------------------
+// 새로 만든 file 은 directory entry 도 sync (전원 off 시 file 유실 방지)
+//------------------------------------------------------------------------------
+static void dir_sync (const char *fname)
+{
+	char path[256];
+	int fd;
+
+	snprintf (path, sizeof(path), "%s", fname);
+	if ((fd = open (dirname (path), O_RDONLY | O_DIRECTORY | O_CLOEXEC)) >= 0) {
+		fsync (fd);
+		close (fd);
+	}
+}
+
+//------------------------------------------------------------------------------
+int result_log_append (const char *fname, struct result_log_rec *rec)
+{
+	struct result_log_hdr hdr;
+	struct stat st;
+	int fd, ret = -1;
+
+	if ((fd = open (fname, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644)) < 0) {
+		fprintf (stderr, "%s : %s open error (%s)\n", __func__, fname, strerror (errno));
+		return -1;
+	}
+	if (fstat (fd, &st))
+		goto out;
+
+	if (st.st_size < HDR_SIZE) {
+		/* 새 file (또는 header 기록 중 중단된 file) */
+		memset (&hdr, 0, sizeof(hdr));
+		hdr.magic    = RESULT_LOG_MAGIC;
+		hdr.version  = RESULT_LOG_VERSION;
+		hdr.rec_size = REC_SIZE;
+		if (ftruncate (fd, 0) || (write (fd, &hdr, HDR_SIZE) != HDR_SIZE))
+			goto out;
+		fdatasync (fd);
+		dir_sync (fname);
+	} else {
+		if ((pread (fd, &hdr, HDR_SIZE, 0) != HDR_SIZE) || (hdr.magic != RESULT_LOG_MAGIC)) {
+			fprintf (stderr, "%s : %s is not a result log (v%d)\n", __func__, fname, RESULT_LOG_VERSION);
+			goto out;
+		}
+		/* 이전 version file 은 보관 후 새 file 에 기록 */
+		if ((hdr.version != RESULT_LOG_VERSION) || (hdr.rec_size != REC_SIZE)) {
+			char old_fname[256];
+
+			close (fd);
+			snprintf (old_fname, sizeof(old_fname), "%s.v%d", fname, hdr.version);
+			if (rename (fname, old_fname)) {
+				fprintf (stderr, "%s : %s rename error (%s)\n", __func__, fname, strerror (errno));
+				return -1;
+			}
+			printf ("%s : v%d log moved to %s\n", __func__, hdr.version, old_fname);
+			return	result_log_append (fname, rec);
+		}
+		/* 기록 중 중단된 마지막 record 제거 (record 위치를 REC_SIZE 단위로 유지) */
+		if ((st.st_size - HDR_SIZE) % REC_SIZE) {
+			if (ftruncate (fd, st.st_size - (st.st_size - HDR_SIZE) % REC_SIZE))
+				goto out;
+		}
+	}
+
+	rec->magic = RESULT_LOG_REC_MAGIC;
+	rec->crc   = result_log_crc32 ((const uint8_t *)rec + CRC_OFFSET, REC_SIZE - CRC_OFFSET);
+
+	if (write (fd, rec, REC_SIZE) == REC_SIZE)
+		ret = fdatasync (fd) ? -1 : 0;
+out:
+	if (ret)
+		fprintf (stderr, "%s : %s write error (%s)\n", __func__, fname, strerror (errno));
+	close (fd);
+	return ret;
+}
+
+//------------------------------------------------------------------------------
+int result_log_foreach (const char *fname,
+						int (*cb)(const struct result_log_rec *rec, void *arg), void *arg)
+{
+	const struct result_log_hdr *hdr;
+	const struct result_log_rec *rec;
+	struct stat st;
+	uint8_t *map;
+	long cnt, i;
+	int fd, valid = 0;
+
+	if ((fd = open (fname, O_RDONLY | O_CLOEXEC)) < 0) {
+		fprintf (stderr, "%s : %s open error (%s)\n", __func__, fname, strerror (errno));
+		return -1;
+	}
+	if (fstat (fd, &st) || (st.st_size < HDR_SIZE)) {
+		close (fd);
+		return 0;
+	}
+	map = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close (fd);
+	if (map == MAP_FAILED)
+		return -1;
+
+	hdr = (const struct result_log_hdr *)map;
+	if ((hdr->magic != RESULT_LOG_MAGIC) || (hdr->rec_size != REC_SIZE)) {
+		fprintf (stderr, "%s : %s is not a result log (v%d)\n", __func__, fname, RESULT_LOG_VERSION);
+		munmap (map, st.st_size);
+		return -1;
+	}
+	madvise (map, st.st_size, MADV_SEQUENTIAL);
+
+	cnt = (st.st_size - HDR_SIZE) / REC_SIZE;
+	for (i = 0; i < cnt; i++) {
+		rec = (const struct result_log_rec *)(map + HDR_SIZE + i * REC_SIZE);
+		if (!rec_valid (rec))
+			continue;
+		valid++;
+		if (cb && cb (rec, arg))
+			break;
+	}
+	munmap (map, st.st_size);
+	return valid;
+}
+
+//------------------------------------------------------------------------------
+//
+// query : item 별 측정값 분포 (record 순서 = 측정 순서)
+//
+//------------------------------------------------------------------------------
+#define	LINK_KIND_MAX	4
+
+struct item_stat {
+	char		name[RESULT_LOG_NAME_SIZE + 1];
+	int			*values;
+	int			*elapsed;
+	int			cnt, ecnt, size, pass, tries;
+	int			link[LINK_KIND_MAX], link_cnt[LINK_KIND_MAX];
+};
+
+struct query {
+	const char			*item;
+	struct item_stat	stats[RESULT_LOG_ITEM_MAX * 2];
+	int					stat_cnt;
+	int					boards, pass_boards;
+	int64_t				first, last;
+	int					error;
+};
+
+//------------------------------------------------------------------------------
+static struct item_stat *stat_get (struct query *q, const char *name)
+{
+	struct item_stat *s;
+	int i;
+
+	for (i = 0; i < q->stat_cnt; i++)
+		if (!strncmp (q->stats[i].name, name, RESULT_LOG_NAME_SIZE))
+			return &q->stats[i];
+
+	if (q->stat_cnt >= (int)(sizeof(q->stats) / sizeof(q->stats[0])))
+		return NULL;
+	s = &q->stats[q->stat_cnt++];
+	memset (s, 0, sizeof(struct item_stat));
+	memcpy (s->name, name, RESULT_LOG_NAME_SIZE);
+	return s;
+}
+
+//------------------------------------------------------------------------------
+static int stat_add (struct item_stat *s, const struct result_log_item *it)
+{
+	int i;
+
+	if (s->ecnt >= s->size) {
+		int size = s->size ? s->size * 2 : 1024;
+		int *v = realloc (s->values,  size * sizeof(int));
+		int *e = v ? realloc (s->elapsed, size * sizeof(int)) : NULL;
+		if (v)	s->values  = v;
+		if (e)	s->elapsed = e;
+		if (!v || !e)
+			return -1;
+		s->size = size;
+	}
+	if (it->flags & RESULT_LOG_F_VALUE)
+		s->values[s->cnt++] = it->value;
+	s->elapsed[s->ecnt++] = it->elapsed_ms;
+	s->pass  += it->result ? 1 : 0;
+	s->tries += it->tries;
+
+	if (it->flags & RESULT_LOG_F_LINK) {
+		for (i = 0; i < LINK_KIND_MAX; i++) {
+			if (!s->link_cnt[i] || (s->link[i] == it->link)) {
+				s->link[i] = it->link;
+				s->link_cnt[i]++;
+				break;
+			}
+		}
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+// record 의 item 외 측정값 (memory test, HDMI) 을 item 으로 집계
+//------------------------------------------------------------------------------
+static int query_value (struct query *q, const char *name, int value, int result)
+{
+	struct result_log_item it;
+	struct item_stat *s;
+
+	if (q->item && strncmp (q->item, name, RESULT_LOG_NAME_SIZE))
+		return 0;
+	memset (&it, 0, sizeof(it));
+	strncpy (it.name, name, RESULT_LOG_NAME_SIZE);
+	it.value  = value;
+	it.result = result;
+	it.tries  = 1;
+	it.flags  = RESULT_LOG_F_VALUE;
+	if ((s = stat_get (q, it.name)) == NULL)
+		return 0;
+	if (stat_add (s, &it)) {
+		q->error = 1;
+		return 1;
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+// MEM_WR, MEM_RD, MEM_CP, MEM_TR (MB/s), MEM_ERR, HDMI_WR, HDMI_RD (MB/s), HDMI_HZ (0.01 Hz), HDMI_JIT (us)
+// CPU_C0 ~ CPU_C3 (core Mops/s), CPU_MHZ (최소 clock MHz), CPU_TMP (최대 온도 0.1 C)
+// {storage}_W (EMMC_W, SATA_W, NVME_W : 가장 느린 window MB/s)
+//------------------------------------------------------------------------------
+static int query_extra (struct query *q, const struct result_log_rec *rec)
+{
+	static const char *mem_names[] = { "MEM_WR", "MEM_RD", "MEM_CP", "MEM_TR" };
+	static const char *cpu_names[] = { "CPU_C0", "CPU_C1", "CPU_C2", "CPU_C3" };
+	const struct result_log_mem *mem = &rec->mem;
+	const struct result_log_fb  *fb  = &rec->fb;
+	const struct result_log_cpu *cpu = &rec->cpu;
+	int i, ok;
+
+	if (mem->tested_mb) {
+		ok = mem->errors ? 0 : 1;
+		for (i = 0; i < 4; i++)
+			if (query_value (q, mem_names[i], mem->bw[i], ok))
+				return 1;
+		if (query_value (q, "MEM_ERR", mem->errors, ok))
+			return 1;
+	}
+	if (fb->write_mbps) {
+		ok = fb->bad_patterns ? 0 : 1;
+		if (query_value (q, "HDMI_WR", fb->write_mbps, ok) ||
+			query_value (q, "HDMI_RD", fb->read_mbps, ok))
+			return 1;
+		if (fb->refresh_chz &&
+			(query_value (q, "HDMI_HZ", fb->refresh_chz, ok) ||
+			 query_value (q, "HDMI_JIT", fb->jitter_us, ok)))
+			return 1;
+	}
+	if (cpu->mops[0]) {
+		ok = cpu->verdict ? 0 : 1;
+		for (i = 0; (i < RESULT_LOG_CPU_CORES) && cpu->mops[i]; i++)
+			if (query_value (q, cpu_names[i], cpu->mops[i], ok))
+				return 1;
+		if (cpu->mhz_max && query_value (q, "CPU_MHZ", cpu->mhz_min, ok))
+			return 1;
+		if (cpu->temp_max_dc && query_value (q, "CPU_TMP", cpu->temp_max_dc, ok))
+			return 1;
+	}
+	for (i = 0; i < RESULT_LOG_STORAGE; i++) {
+		const struct result_log_storage *st = &rec->storage[i];
+		char name[RESULT_LOG_NAME_SIZE + 3];
+		int w, min;
+
+		if (!st->name[0] || !st->wins)
+			continue;
+		for (w = 0, min = 0; (w < st->wins) && (w < RESULT_LOG_STORAGE_WIN); w++)
+			min = (!w || (st->win_mbps[w] < min)) ? st->win_mbps[w] : min;
+		snprintf (name, sizeof(name), "%.*s_W", RESULT_LOG_NAME_SIZE - 3, st->name);
+		ok = ((st->verdict == 2) || st->errors) ? 0 : 1;
+		if (query_value (q, name, min, ok))
+			return 1;
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+static int query_rec (const struct result_log_rec *rec, void *arg)
+{
+	struct query *q = (struct query *)arg;
+	struct item_stat *s;
+	int i;
+
+	if (!q->boards)
+		q->first = rec->time;
+	q->last = rec->time;
+	q->boards++;
+	q->pass_boards += rec->error_cnt ? 0 : 1;
+
+	for (i = 0; i < rec->item_cnt; i++) {
+		const struct result_log_item *it = &rec->items[i];
+
+		if (q->item && strncmp (q->item, it->name, RESULT_LOG_NAME_SIZE))
+			continue;
+		if ((s = stat_get (q, it->name)) == NULL)
+			continue;
+		if (stat_add (s, it)) {
+			q->error = 1;
+			return 1;
+		}
+	}
+	return	query_extra (q, rec);
+}
+
+//------------------------------------------------------------------------------
+static int cmp_int (const void *a, const void *b)
+{
+	int x = *(const int *)a, y = *(const int *)b;
+	return	(x > y) - (x < y);
+}
+
+//------------------------------------------------------------------------------
+static int percentile (const int *sorted, int cnt, int pct)
+{
+	return	sorted[(int)((long)(cnt - 1) * pct / 100)];
+}
+
+//------------------------------------------------------------------------------
+static double mean (const int *v, int cnt)
+{
+	double sum = 0;
+	int i;
+
+	for (i = 0; i < cnt; i++)
+		sum += v[i];
+	return	cnt ? sum / cnt : 0;
+}
+
+//------------------------------------------------------------------------------
+static void stat_print (struct item_stat *s)
+{
+	double avg, sd = 0, drift;
+	int i, part;
+
+	printf ("[%s] boards = %d, pass = %.1f %%, tries avg = %.2f\n", s->name, s->ecnt,
+		s->ecnt ? s->pass * 100.0 / s->ecnt : 0, s->ecnt ? (double)s->tries / s->ecnt : 0);
+
+	if (s->cnt) {
+		/* drift : 최근 10% 평균 - 처음 10% 평균 (정렬 전 측정 순서 기준) */
+		part  = s->cnt / 10 ? s->cnt / 10 : 1;
+		drift = mean (&s->values[s->cnt - part], part) - mean (s->values, part);
+
+		avg = mean (s->values, s->cnt);
+		for (i = 0; i < s->cnt; i++)
+			sd += (s->values[i] - avg) * (s->values[i] - avg);
+		sd = s->cnt > 1 ? sqrt (sd / (s->cnt - 1)) : 0;
+
+		qsort (s->values, s->cnt, sizeof(int), cmp_int);
+		printf ("  value   : n = %d, min = %d, p1 = %d, p5 = %d, p50 = %d, p95 = %d, max = %d\n",
+			s->cnt, s->values[0], percentile (s->values, s->cnt, 1),
+			percentile (s->values, s->cnt, 5), percentile (s->values, s->cnt, 50),
+			percentile (s->values, s->cnt, 95), s->values[s->cnt - 1]);
+		printf ("            mean = %.1f, stddev = %.1f, drift = %+.1f (%+.1f %%)\n",
+			avg, sd, drift, avg ? drift * 100 / avg : 0);
+	}
+	if (s->ecnt)
+		qsort (s->elapsed, s->ecnt, sizeof(int), cmp_int);
+	/* elapsed 가 없는 item (MEM_xx, HDMI_xx, CPU_xx) 은 출력 안함 */
+	if (s->ecnt && s->elapsed[s->ecnt - 1]) {
+		printf ("  elapsed : p50 = %d ms, p95 = %d ms, max = %d ms\n",
+			percentile (s->elapsed, s->ecnt, 50), percentile (s->elapsed, s->ecnt, 95),
+			s->elapsed[s->ecnt - 1]);
+	}
+	if (s->link_cnt[0]) {
+		printf ("  link    :");
+		for (i = 0; (i < LINK_KIND_MAX) && s->link_cnt[i]; i++)
+			printf (" %dM x %d", s->link[i], s->link_cnt[i]);
+		printf ("\n");
+	}
+}
+
+//------------------------------------------------------------------------------
+int result_log_query (const char *fname, const char *item)
+{
+	struct query *q;
+	int i, ret;
+
+	if ((q = calloc (1, sizeof(struct query))) == NULL)
+		return -1;
+	q->item = item;
+
+	if ((ret = result_log_foreach (fname, query_rec, q)) >= 0 && !q->error) {
+		printf ("%s : records = %d, pass = %d, time = %lld ~ %lld\n", fname,
+			q->boards, q->pass_boards, (long long)q->first, (long long)q->last);
+		for (i = 0; i < q->stat_cnt; i++)
+			stat_print (&q->stats[i]);
+	}
+	for (i = 0; i < q->stat_cnt; i++) {
+		free (q->stats[i].values);
+		free (q->stats[i].elapsed);
+	}
+	ret = q->error ? -1 : ret;
+	free (q);
+	return ret;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
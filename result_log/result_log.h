@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+/**
+ * @file result_log.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief append-only binary board result log and fleet statistics query.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __RESULT_LOG_H__
+#define __RESULT_LOG_H__
+
+//------------------------------------------------------------------------------
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+/* overlayroot 사용시 재부팅 후에도 유지되는 boot partition 에 기록 (-L 로 변경) */
+#define	RESULT_LOG_FILE			"/media/boot/m1-result.log"
+
+#define	RESULT_LOG_MAGIC		0x4C52314D	/* "M1RL" */
+#define	RESULT_LOG_REC_MAGIC	0x4352314D	/* "M1RC" */
+#define	RESULT_LOG_VERSION		4
+#define	RESULT_LOG_ITEM_MAX		23
+#define	RESULT_LOG_NAME_SIZE	8
+#define	RESULT_LOG_MEM_ERR		2
+#define	RESULT_LOG_CPU_CORES	4
+#define	RESULT_LOG_CPU_SAMPLES	8
+#define	RESULT_LOG_STORAGE		3
+#define	RESULT_LOG_STORAGE_WIN	16
+
+/* result_log_item.flags */
+#define	RESULT_LOG_F_VALUE		0x01	/* value 측정됨 */
+#define	RESULT_LOG_F_LINK		0x02	/* link (usb/eth link speed Mbps) 확인됨 */
+
+/*
+	file : header 1개 + 고정 크기 record (848 bytes) 반복, little endian.
+	record 단위로 한번에 write (O_APPEND) 후 fdatasync.
+	중간에 전원이 꺼져 record 가 잘린 경우 다음 open 시 잘린 부분을 제거하고,
+	읽을 때는 magic/crc 가 맞지 않는 record 를 건너뜀.
+	version (record 크기) 이 다른 file 은 {file}.v{version} 으로 이름을 바꾸고 새로 기록.
+*/
+struct result_log_hdr {
+	uint32_t	magic;
+	uint16_t	version;
+	uint16_t	rec_size;
+	uint32_t	rsvd[2];
+};
+
+struct result_log_item {
+	char		name[RESULT_LOG_NAME_SIZE];
+	/* MB/s, Mbits/s, GB ... (item 별 기준값과 같은 단위) */
+	int32_t		value;
+	uint32_t	elapsed_ms;
+	uint16_t	link;
+	uint8_t		status;
+	uint8_t		result;
+	uint8_t		tries;
+	uint8_t		flags;
+	uint16_t	rsvd;
+};
+
+/* memory test (mem_test) 결과, tested_mb 0 : 측정 안됨 */
+struct result_log_mem {
+	/* MB/s : write, read, copy, triad */
+	uint32_t	bw[4];
+	uint32_t	tested_mb;
+	uint32_t	errors;
+	/* 오류 물리 주소 (확인 안된 경우 virtual 주소) */
+	uint64_t	err_addr[RESULT_LOG_MEM_ERR];
+};
+
+/* HDMI (fb_test) 결과, write_mbps 0 : 측정 안됨 */
+struct result_log_fb {
+	uint32_t	write_mbps;
+	uint32_t	read_mbps;
+	/* vsync refresh (0.01 Hz), 0 : vsync 없음 */
+	uint32_t	refresh_chz;
+	/* vsync interval 표준편차, 최대 편차 (us) */
+	uint16_t	jitter_us;
+	uint16_t	max_dev_us;
+	/* read-back checksum 불일치 pattern 수 */
+	uint16_t	bad_patterns;
+	uint16_t	rsvd;
+};
+
+/* cpu load (cpu_test) 결과, mops[0] 0 : 측정 안됨 */
+struct result_log_cpu {
+	/* core 별 Mops/s */
+	uint32_t	mops[RESULT_LOG_CPU_CORES];
+	/* warmup 이후 core clock 최소/최대 (MHz, 0 : cpufreq 없음) */
+	uint16_t	mhz_min;
+	uint16_t	mhz_max;
+	/* thermal zone 최대값 (0.1 C), 시작/최대, 0 : thermal zone 없음 */
+	int16_t		temp_start_dc;
+	int16_t		temp_max_dc;
+	/* throttling 시작 (ms, 0xffff : 없음), cpu_test verdict */
+	uint16_t	throttle_ms;
+	uint8_t		verdict;
+	uint8_t		samples;
+	/* 측정 구간을 RESULT_LOG_CPU_SAMPLES 등분한 구간 별 최소 clock (MHz), 최대 온도 (0.1 C) */
+	uint16_t	mhz[RESULT_LOG_CPU_SAMPLES];
+	int16_t		temp_dc[RESULT_LOG_CPU_SAMPLES];
+	uint32_t	rsvd;
+};
+
+/* storage (storage_bench adaptive mode) window 별 속도, name[0] 0 : 측정 안됨 */
+struct result_log_storage {
+	char		name[RESULT_LOG_NAME_SIZE];
+	/* window 별 MB/s (warmup 제외), RESULT_LOG_STORAGE_WIN 초과분은 저장 안함 */
+	uint16_t	win_mbps[RESULT_LOG_STORAGE_WIN];
+	/* 전체 window 수, storage_bench eVERDICT_xxx (0 : none, 1 : pass, 2 : fail) */
+	uint8_t		wins;
+	uint8_t		verdict;
+	/* read/submit error 수 */
+	uint16_t	errors;
+	uint32_t	lat_p99_us;
+};
+
+struct result_log_rec {
+	uint32_t	magic;
+	/* crc32 (time ~ 끝) */
+	uint32_t	crc;
+	int64_t		time;
+	uint8_t		mac[6];
+	uint8_t		item_cnt;
+	uint8_t		error_cnt;
+	uint32_t	cycle_ms;
+	struct result_log_item	items[RESULT_LOG_ITEM_MAX];
+	struct result_log_fb	fb;
+	struct result_log_mem	mem;
+	struct result_log_cpu	cpu;
+	/* eMMC, SATA, NVMe */
+	struct result_log_storage	storage[RESULT_LOG_STORAGE];
+};
+
+//------------------------------------------------------------------------------
+extern uint32_t	result_log_crc32	(const void *data, int size);
+/* mac_str "001e06xxxxxx" -> rec->mac */
+extern void		result_log_set_mac	(struct result_log_rec *rec, const char *mac_str);
+/* rec->magic/crc 설정 후 file 에 추가, return 0 : success */
+extern int		result_log_append	(const char *fname, struct result_log_rec *rec);
+/* record 별 callback (magic/crc 오류 record 는 skip), return : 정상 record 수, -1 : file error */
+extern int		result_log_foreach	(const char *fname,
+									int (*cb)(const struct result_log_rec *rec, void *arg), void *arg);
+/* item 별 분포/percentile/drift 출력, item NULL : 전체 */
+extern int		result_log_query	(const char *fname, const char *item);
+
+//------------------------------------------------------------------------------
+#endif	// #define __RESULT_LOG_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,403 @@
+//------------------------------------------------------------------------------
+/**
+ * @file storage_bench.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief O_DIRECT + linux aio (queue depth) storage read benchmark.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/fs.h>
+#include <linux/aio_abi.h>
+
+#include "storage_bench.h"
+
+//------------------------------------------------------------------------------
+/*
+	io_uring 은 5.1 이후 kernel 에서만 지원하므로 (M1 BSP 4.19) linux native aio
+	(io_submit/io_getevents) 로 queue depth 를 유지한다. O_DIRECT 로 page cache 를 거치지 않음.
+*/
+//------------------------------------------------------------------------------
+struct storage_profile {
+	const char	*type;
+	int			block_kb;
+	int			qd;
+	int			size_mb;
+};
+
+/* nvme/sata 는 qd 1 로는 최대 속도가 나오지 않음 */
+static const struct storage_profile Profiles[] = {
+	{ "emmc",  512,  4, 256 },
+	{ "sata", 1024,  8, 512 },
+	{ "nvme", 1024, 16, 1024 },
+	{ "usb" , 1024,  4, 128 },
+	{ NULL  , 1024,  4, 256 },
+};
+
+//------------------------------------------------------------------------------
+static long now_us (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return	ts.tv_sec * 1000000L + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+static int cmp_int (const void *a, const void *b)
+{
+	return	*(const int *)a - *(const int *)b;
+}
+
+//------------------------------------------------------------------------------
+void storage_bench_cfg_default (struct storage_bench_cfg *cfg, const char *type, const char *path)
+{
+	const struct storage_profile *p = Profiles;
+
+	while (p->type && (!type || strcmp (p->type, type)))
+		p++;
+
+	memset (cfg, 0, sizeof(struct storage_bench_cfg));
+	cfg->path			= path;
+	cfg->block_size		= p->block_kb * 1024;
+	cfg->qd				= p->qd;
+	cfg->pattern		= eSTORAGE_SEQ;
+	cfg->size_mb		= p->size_mb;
+	cfg->duration_ms	= 3000;
+	cfg->window_ms		= 100;
+	cfg->warmup			= 2;
+}
+
+//------------------------------------------------------------------------------
+static int read_str (const char *fname, char *buf, int size)
+{
+	int fd, len;
+
+	if ((fd = open (fname, O_RDONLY)) < 0)
+		return 0;
+	len = read (fd, buf, size - 1);
+	close (fd);
+	if (len <= 0)
+		return 0;
+	while ((len > 0) && (buf[len - 1] == '\n'))
+		len--;
+	buf[len] = 0;
+	return len;
+}
+
+//------------------------------------------------------------------------------
+// /sys/block/{name} link 로 device 종류 확인
+// nvme : ".../nvme/nvme0/nvme0n1", sata : ".../ata1/host0/...", usb : ".../usb8/8-1/..."
+//------------------------------------------------------------------------------
+int storage_bench_find (const char *type, char *path, int size)
+{
+	DIR *dir;
+	struct dirent *ent;
+	char fname[512], link[512], buf[32];
+	int found = 0, len;
+
+	if ((dir = opendir ("/sys/block")) == NULL)
+		return 0;
+
+	while (!found && ((ent = readdir (dir)) != NULL)) {
+		if (ent->d_name[0] == '.')
+			continue;
+
+		snprintf (fname, sizeof(fname), "/sys/block/%s", ent->d_name);
+		if ((len = readlink (fname, link, sizeof(link) - 1)) <= 0)
+			continue;
+		link[len] = 0;
+
+		if (!strcmp (type, "nvme"))
+			found = !strncmp (ent->d_name, "nvme", 4);
+		else if (!strcmp (type, "sata"))
+			found = !strncmp (ent->d_name, "sd", 2) && (strstr (link, "/ata") != NULL);
+		else if (!strcmp (type, "usb"))
+			found = !strncmp (ent->d_name, "sd", 2) && (strstr (link, "/usb") != NULL);
+		else if (!strcmp (type, "emmc") && !strncmp (ent->d_name, "mmcblk", 6)) {
+			/* sd card 와 구분 (device/type = MMC | SD) */
+			snprintf (fname, sizeof(fname), "/sys/block/%s/device/type", ent->d_name);
+			found = read_str (fname, buf, sizeof(buf)) && !strcmp (buf, "MMC");
+		}
+		if (found && ((int)strlen (ent->d_name) + 6 < size))
+			sprintf (path, "/dev/%s", ent->d_name);
+		else
+			found = 0;
+	}
+	closedir (dir);
+	return found;
+}
+
+//------------------------------------------------------------------------------
+static long long dev_size (int fd)
+{
+	unsigned long long size = 0;
+	struct stat st;
+
+	if (fstat (fd, &st))
+		return 0;
+
+	if (S_ISBLK (st.st_mode))
+		return	ioctl (fd, BLKGETSIZE64, &size) ? 0 : (long long)size;
+
+	return	st.st_size;
+}
+
+//------------------------------------------------------------------------------
+// student t (95%, 양측) : dof 1 ~ 10, 이후 2.0 사용
+//------------------------------------------------------------------------------
+static const double TValue[] = {
+	12.71, 4.30, 3.18, 2.78, 2.57, 2.45, 2.36, 2.31, 2.26, 2.23,
+};
+
+//------------------------------------------------------------------------------
+// mean ± t * s / sqrt(n) 과 target 비교 (sqrt 없이 제곱으로 비교)
+//------------------------------------------------------------------------------
+static int adaptive_verdict (const int *samples, int n, int target, int *mean_out)
+{
+	double mean = 0, var = 0, t, d;
+	int i;
+
+	for (i = 0; i < n; i++)
+		mean += samples[i];
+	mean /= n;
+	*mean_out = (int)mean;
+
+	if (n < STORAGE_BENCH_WIN_MIN)
+		return eVERDICT_NONE;
+
+	for (i = 0; i < n; i++)
+		var += (samples[i] - mean) * (samples[i] - mean);
+	var /= (n - 1);
+
+	t = (n - 1 <= (int)(sizeof(TValue) / sizeof(TValue[0]))) ? TValue[n - 2] : 2.0;
+	d = mean - target;
+
+	/* |mean - target| > t * s / sqrt(n) */
+	if (d * d > t * t * var / n)
+		return	(d > 0) ? eVERDICT_PASS : eVERDICT_FAIL;
+
+	return eVERDICT_NONE;
+}
+
+//------------------------------------------------------------------------------
+static unsigned int xorshift (unsigned int *s)
+{
+	*s ^= *s << 13;	*s ^= *s >> 17;	*s ^= *s << 5;
+	return *s;
+}
+
+//------------------------------------------------------------------------------
+int storage_bench_run (const struct storage_bench_cfg *cfg, struct storage_bench_result *res)
+{
+	struct iocb iocbs[STORAGE_BENCH_QD_MAX], *piocb;
+	struct io_event events[STORAGE_BENCH_QD_MAX];
+	long submit_us[STORAGE_BENCH_QD_MAX];
+	aio_context_t ctx = 0;
+	char *buf = NULL;
+	int *lat = NULL, lat_cnt = 0, fd, i, n, qd, inflight = 0, ret = -1;
+	long long size, blocks, total, submitted = 0, next = 0, win_bytes = 0;
+	long start, now, stop_us, win_us;
+	int win_cnt = 0, adaptive = (cfg->target_mbps > 0) && (cfg->window_ms > 0);
+	unsigned int seed = (unsigned int)now_us () | 1;
+
+	memset (res, 0, sizeof(struct storage_bench_result));
+	if ((cfg->block_size <= 0) || (cfg->block_size % STORAGE_BENCH_ALIGN))
+		return -1;
+	qd = (cfg->qd < 1) ? 1 : (cfg->qd > STORAGE_BENCH_QD_MAX ? STORAGE_BENCH_QD_MAX : cfg->qd);
+
+	res->direct = 1;
+	if ((fd = open (cfg->path, O_RDONLY | O_DIRECT | O_CLOEXEC)) < 0) {
+		/* tmpfs 등 O_DIRECT 미지원 : page cache drop 후 측정 */
+		if ((errno != EINVAL) || ((fd = open (cfg->path, O_RDONLY | O_CLOEXEC)) < 0)) {
+			printf ("%s : %s open error! (%s)\n", __func__, cfg->path, strerror(errno));
+			return -1;
+		}
+		posix_fadvise (fd, 0, 0, POSIX_FADV_DONTNEED);
+		res->direct = 0;
+	}
+	if ((size = dev_size (fd)) < cfg->block_size) {
+		printf ("%s : %s size error!\n", __func__, cfg->path);
+		goto out;
+	}
+	blocks = size / cfg->block_size;
+	total  = (long long)cfg->size_mb * 1024 * 1024 / cfg->block_size;
+	if (total > blocks)
+		total = blocks;
+	/* adaptive mode 는 판정 또는 duration 까지 측정 */
+	if (adaptive)
+		total = 0x7fffffffffffffffLL;
+
+	if (posix_memalign ((void **)&buf, STORAGE_BENCH_ALIGN, (size_t)cfg->block_size * qd))
+		goto out;
+	if ((lat = malloc (sizeof(int) * STORAGE_BENCH_LAT_SAMPLES)) == NULL)
+		goto out;
+	if (syscall (SYS_io_setup, qd, &ctx)) {
+		printf ("%s : io_setup error! (%s)\n", __func__, strerror(errno));
+		ctx = 0;
+		goto out;
+	}
+
+	start   = win_us = now_us ();
+	stop_us = start + cfg->duration_ms * 1000L;
+
+	/* slot 별 iocb 를 재사용, 완료된 slot 은 바로 다음 block 으로 다시 submit */
+	memset (iocbs, 0, sizeof(iocbs));
+	for (i = 0; i < qd; i++) {
+		iocbs[i].aio_data		= i;
+		iocbs[i].aio_fildes		= fd;
+		iocbs[i].aio_lio_opcode	= IOCB_CMD_PREAD;
+		iocbs[i].aio_buf		= (unsigned long)(buf + (size_t)i * cfg->block_size);
+		iocbs[i].aio_nbytes		= cfg->block_size;
+	}
+	for (i = 0; i < qd; i++) {
+		if (submitted >= total)
+			break;
+		iocbs[i].aio_offset = (cfg->pattern == eSTORAGE_RAND) ?
+			(long long)(xorshift (&seed) % blocks) * cfg->block_size :
+			(next++ % blocks) * cfg->block_size;
+		piocb = &iocbs[i];
+		submit_us[i] = now_us ();
+		if (syscall (SYS_io_submit, ctx, 1, &piocb) != 1)
+			goto out;
+		submitted++;	inflight++;
+	}
+
+	while (inflight) {
+		if ((n = syscall (SYS_io_getevents, ctx, 1, qd, events, NULL)) <= 0) {
+			if (errno == EINTR)
+				continue;
+			goto out;
+		}
+		now = now_us ();
+		for (i = 0; i < n; i++) {
+			int slot = (int)events[i].data;
+
+			inflight--;
+			if ((long)events[i].res != cfg->block_size) {
+				/* 같은 block 을 다시 요청 (slot 유지), error 가 계속되면 중지 */
+				printf ("%s : read error! (%ld)\n", __func__, (long)events[i].res);
+				if (++res->errors >= STORAGE_BENCH_ERR_MAX)
+					stop_us = now;
+				if (now >= stop_us)
+					continue;
+				piocb = &iocbs[slot];
+				submit_us[slot] = now_us ();
+				if (syscall (SYS_io_submit, ctx, 1, &piocb) == 1)
+					inflight++;
+				continue;
+			}
+			res->bytes += cfg->block_size;
+			win_bytes  += cfg->block_size;
+			if (lat_cnt < STORAGE_BENCH_LAT_SAMPLES)
+				lat[lat_cnt++] = (int)(now - submit_us[slot]);
+
+			if (adaptive && (now - win_us >= cfg->window_ms * 1000L)) {
+				/* bytes/usec * 1000000 / (1024 * 1024) = MB/s */
+				int mbps = (int)(win_bytes * 1000000 / (now - win_us) / (1024 * 1024));
+
+				if ((win_cnt++ >= cfg->warmup) && (res->sample_cnt < STORAGE_BENCH_WIN_MAX)) {
+					res->samples[res->sample_cnt++] = mbps;
+					res->verdict = adaptive_verdict (res->samples, res->sample_cnt,
+											cfg->target_mbps, &res->mbps);
+					/* 판정 완료 : 남은 in-flight 만 완료 후 종료 */
+					if (res->verdict != eVERDICT_NONE)
+						stop_us = now;
+				}
+				win_bytes = 0;
+				win_us    = now;
+			}
+
+			if ((submitted >= total) || (now >= stop_us))
+				continue;
+
+			iocbs[slot].aio_offset = (cfg->pattern == eSTORAGE_RAND) ?
+				(long long)(xorshift (&seed) % blocks) * cfg->block_size :
+				(next++ % blocks) * cfg->block_size;
+			piocb = &iocbs[slot];
+			submit_us[slot] = now_us ();
+			if (syscall (SYS_io_submit, ctx, 1, &piocb) == 1) {
+				submitted++;	inflight++;
+			} else
+				res->errors++;
+		}
+	}
+
+	res->elapsed_ms = (int)((now_us () - start) / 1000);
+	if (res->elapsed_ms <= 0)
+		res->elapsed_ms = 1;
+	if (lat_cnt) {
+		long long ios = res->bytes / cfg->block_size;
+
+		qsort (lat, lat_cnt, sizeof(int), cmp_int);
+		res->lat_p50_us = lat[lat_cnt / 2];
+		res->lat_p99_us = lat[(lat_cnt * 99) / 100];
+		res->lat_max_us = lat[lat_cnt - 1];
+		res->iops = (int)(ios * 1000 / res->elapsed_ms);
+		/* adaptive mode 는 warmup 제외한 window 평균 */
+		if (!res->sample_cnt)
+			res->mbps = (int)(res->bytes * 1000 / res->elapsed_ms / (1024 * 1024));
+		else if (res->verdict == eVERDICT_NONE)
+			res->verdict = (res->mbps >= cfg->target_mbps) ? eVERDICT_PASS : eVERDICT_FAIL;
+		if (adaptive && res->errors)
+			res->verdict = eVERDICT_FAIL;
+		ret = 0;
+	}
+out:
+	if (ctx)
+		syscall (SYS_io_destroy, ctx);
+	free  (lat);
+	free  (buf);
+	close (fd);
+	return ret;
+}
+
+//------------------------------------------------------------------------------
+int storage_bench_summary (const struct storage_bench_result *res, char *str, int size)
+{
+	if (res->errors)
+		return	snprintf (str, size, "%d MB/s ERR %d", res->mbps, res->errors);
+	return	snprintf (str, size, "%d MB/s %dIOPS p99 %dus",
+		res->mbps, res->iops, res->lat_p99_us);
+}
+
+//------------------------------------------------------------------------------
+int storage_bench_json (const struct storage_bench_cfg *cfg,
+						const struct storage_bench_result *res, char *str, int size)
+{
+	const char *verdict[] = { "none", "pass", "fail" };
+	int len, i;
+
+	len = snprintf (str, size,
+		"{\"path\":\"%s\",\"bs\":%d,\"qd\":%d,\"pattern\":\"%s\",\"direct\":%d,"
+		"\"mbps\":%d,\"iops\":%d,\"lat_p50_us\":%d,\"lat_p99_us\":%d,\"lat_max_us\":%d,"
+		"\"bytes\":%lld,\"ms\":%d,\"errors\":%d,\"target\":%d,\"verdict\":\"%s\",\"samples\":[",
+		cfg->path, cfg->block_size, cfg->qd,
+		cfg->pattern == eSTORAGE_RAND ? "rand" : "seq", res->direct,
+		res->mbps, res->iops, res->lat_p50_us, res->lat_p99_us, res->lat_max_us,
+		res->bytes, res->elapsed_ms, res->errors, cfg->target_mbps, verdict[res->verdict]);
+
+	for (i = 0; (i < res->sample_cnt) && (len < size); i++)
+		len += snprintf (str + len, size - len, "%s%d", i ? "," : "", res->samples[i]);
+	if (len < size)
+		len += snprintf (str + len, size - len, "]}");
+	return len;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+/**
+ * @file storage_bench.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief O_DIRECT + linux aio (queue depth) storage read benchmark.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __STORAGE_BENCH_H__
+#define __STORAGE_BENCH_H__
+
+//------------------------------------------------------------------------------
+#define	STORAGE_BENCH_QD_MAX		32
+/* latency percentile 계산용 sample 수 (초과 시 앞부분 sample만 사용) */
+#define	STORAGE_BENCH_LAT_SAMPLES	16384
+#define	STORAGE_BENCH_ALIGN			4096
+/* adaptive mode window sample 최대 수 */
+#define	STORAGE_BENCH_WIN_MAX		128
+#define	STORAGE_BENCH_WIN_MIN		3
+/* read error 난 block 은 다시 요청, error 수가 이 값 이상이면 측정 중지 */
+#define	STORAGE_BENCH_ERR_MAX		16
+
+enum {
+	eVERDICT_NONE = 0,
+	eVERDICT_PASS,
+	eVERDICT_FAIL,
+};
+
+enum {
+	eSTORAGE_SEQ = 0,
+	eSTORAGE_RAND,
+};
+
+struct storage_bench_cfg {
+	const char	*path;
+	int			block_size;
+	int			qd;
+	/* eSTORAGE_SEQ, eSTORAGE_RAND */
+	int			pattern;
+	/* 최대 읽기 크기(MB), 최대 측정 시간(ms) 중 먼저 도달하는 조건으로 종료 */
+	int			size_mb;
+	int			duration_ms;
+	/*
+		adaptive mode (target_mbps != 0) : window_ms 마다 속도 sample, warmup window 제외.
+		95% 신뢰구간이 target 보다 위(PASS) 또는 아래(FAIL)로 결정되면 바로 종료.
+		size_mb 제한 없이 duration_ms 까지 측정 (seq 는 처음부터 다시 읽음).
+	*/
+	int			target_mbps;
+	int			window_ms;
+	int			warmup;
+};
+
+struct storage_bench_result {
+	int			mbps;
+	int			iops;
+	int			lat_p50_us;
+	int			lat_p99_us;
+	int			lat_max_us;
+	int			elapsed_ms;
+	long long	bytes;
+	/* 1 : O_DIRECT 로 측정, 0 : O_DIRECT 미지원 (page cache drop 후 측정) */
+	int			direct;
+	/* adaptive mode : eVERDICT_xxx, window 별 MB/s (warmup 제외), mbps = sample 평균 */
+	int			verdict;
+	int			sample_cnt;
+	int			samples[STORAGE_BENCH_WIN_MAX];
+	/* read/submit error 수 (adaptive mode 는 eVERDICT_FAIL) */
+	int			errors;
+};
+
+//------------------------------------------------------------------------------
+/* type : "emmc", "sata", "nvme", "usb", NULL(기본값) 별 block size/queue depth */
+extern void	storage_bench_cfg_default	(struct storage_bench_cfg *cfg, const char *type, const char *path);
+/* type 에 해당하는 block device 검색 (/sys/block), return 1 : found */
+extern int	storage_bench_find			(const char *type, char *path, int size);
+/* return 0 : success, -1 : error */
+extern int	storage_bench_run			(const struct storage_bench_cfg *cfg,
+										struct storage_bench_result *res);
+/* response_str (UI) 용 요약 */
+extern int	storage_bench_summary		(const struct storage_bench_result *res, char *str, int size);
+/* 1 line json */
+extern int	storage_bench_json			(const struct storage_bench_cfg *cfg,
+										const struct storage_bench_result *res, char *str, int size);
+
+//------------------------------------------------------------------------------
+#endif	// #define __STORAGE_BENCH_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+/**
+ * @file sysfs_attr.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief persistent fd sysfs attribute reader (pread, POLLPRI notify).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+
+#include "sysfs_attr.h"
+
+//------------------------------------------------------------------------------
+static char	SysfsRoot[SYSFS_ATTR_PATH_SIZE / 2] = "/sys";
+
+//------------------------------------------------------------------------------
+void sysfs_attr_set_root (const char *root)
+{
+	snprintf (SysfsRoot, sizeof(SysfsRoot), "%s", root ? root : "/sys");
+}
+
+//------------------------------------------------------------------------------
+void sysfs_attr_clear (struct sysfs_attr *attr)
+{
+	memset (attr, 0, sizeof(struct sysfs_attr));
+	attr->fd = -1;
+}
+
+//------------------------------------------------------------------------------
+int sysfs_attr_open (struct sysfs_attr *attr, const char *path)
+{
+	sysfs_attr_clear (attr);
+
+	if (!strncmp (path, "/sys/", strlen ("/sys/")))
+		snprintf (attr->path, sizeof(attr->path), "%s/%s", SysfsRoot, path + strlen ("/sys/"));
+	else
+		snprintf (attr->path, sizeof(attr->path), "%s", path);
+
+	if ((attr->fd = open (attr->path, O_RDONLY | O_CLOEXEC)) < 0)
+		return 0;
+
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+void sysfs_attr_close (struct sysfs_attr *attr)
+{
+	if (attr->fd >= 0)
+		close (attr->fd);
+	attr->fd = -1;
+}
+
+//------------------------------------------------------------------------------
+int sysfs_attr_read (struct sysfs_attr *attr, char *buf, int size)
+{
+	int len;
+
+	if ((buf == NULL) || (size < 1))
+		return -1;
+	/* 처음 open 시 file 이 없었던 경우 다시 open */
+	if ((attr->fd < 0) && attr->path[0])
+		attr->fd = open (attr->path, O_RDONLY | O_CLOEXEC);
+	if (attr->fd < 0)
+		return -1;
+
+	if ((len = pread (attr->fd, buf, size - 1, 0)) < 0) {
+		/* device 제거 (ENODEV) 등, 다음 read 시 다시 open */
+		sysfs_attr_close (attr);
+		return -1;
+	}
+	while ((len > 0) && (buf[len - 1] == '\n'))
+		len--;
+	buf[len] = 0;
+	return len;
+}
+
+//------------------------------------------------------------------------------
+// 10진 정수 parse (sscanf/atoi 미사용), "1.5" 와 같은 소수는 정수 부분만 사용
+//------------------------------------------------------------------------------
+static int parse_int (const char *str, int *value)
+{
+	int v = 0, neg = 0, digits = 0;
+
+	while ((*str == ' ') || (*str == '\t'))
+		str++;
+	if ((*str == '-') || (*str == '+'))
+		neg = (*str++ == '-');
+
+	while ((*str >= '0') && (*str <= '9')) {
+		v = v * 10 + (*str++ - '0');
+		digits++;
+	}
+	*value = neg ? -v : v;
+	return digits ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+int sysfs_attr_read_int (struct sysfs_attr *attr, int *value)
+{
+	char buf[SYSFS_ATTR_BUF_SIZE];
+
+	*value = 0;
+	if (sysfs_attr_read (attr, buf, sizeof(buf)) <= 0)
+		return 0;
+
+	return	parse_int (buf, value);
+}
+
+//------------------------------------------------------------------------------
+int sysfs_attr_read_ints (struct sysfs_attr *attrs, int cnt, int *values)
+{
+	int i, ok;
+
+	for (i = 0, ok = 0; i < cnt; i++)
+		ok += sysfs_attr_read_int (&attrs[i], &values[i]);
+
+	return ok;
+}
+
+//------------------------------------------------------------------------------
+int sysfs_attr_wait (struct sysfs_attr *attr, int timeout_ms)
+{
+	struct pollfd pfd;
+	char buf[SYSFS_ATTR_BUF_SIZE];
+	int ret;
+
+	if (attr->fd < 0) {
+		usleep (timeout_ms * 1000);
+		return 0;
+	}
+	pfd.fd      = attr->fd;
+	pfd.events  = POLLPRI | POLLERR;
+	pfd.revents = 0;
+
+	/* sysfs 는 poll 전에 한번 읽어야 이후 sysfs_notify 를 받을 수 있음 */
+	if (pread (attr->fd, buf, sizeof(buf), 0) < 0)
+		return 0;
+
+	if ((ret = poll (&pfd, 1, timeout_ms)) > 0) {
+		if (pfd.revents & POLLPRI)
+			return 1;
+		/* POLLPRI 를 지원하지 않는 file (regular file 등) 은 바로 return 되므로 timeout 동안 대기 */
+		usleep (timeout_ms * 1000);
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------
+/**
+ * @file sysfs_attr.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief persistent fd sysfs attribute reader (pread, POLLPRI notify).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __SYSFS_ATTR_H__
+#define __SYSFS_ATTR_H__
+
+//------------------------------------------------------------------------------
+#define	SYSFS_ATTR_PATH_SIZE	256
+#define	SYSFS_ATTR_BUF_SIZE		128
+
+/*
+	open 시 fd를 유지하고 read 시 pread (offset 0) 로 다시 읽음.
+	"/sys/" 로 시작하는 path는 sysfs_attr_set_root() 로 지정한 root로 변경 (simulation : {sim_root}/sys).
+	read error 시 fd를 close 후 다시 open 하므로 attribute 하나를 여러 thread에서 사용하는 경우 호출하는 쪽에서 lock.
+*/
+struct sysfs_attr {
+	int		fd;
+	char	path[SYSFS_ATTR_PATH_SIZE];
+};
+
+//------------------------------------------------------------------------------
+extern void	sysfs_attr_set_root	(const char *root);
+extern void	sysfs_attr_clear	(struct sysfs_attr *attr);
+extern int	sysfs_attr_open		(struct sysfs_attr *attr, const char *path);
+extern void	sysfs_attr_close	(struct sysfs_attr *attr);
+/* return : 읽은 길이 (끝의 '\n' 제거), -1 : error (size < 1 포함) */
+extern int	sysfs_attr_read		(struct sysfs_attr *attr, char *buf, int size);
+extern int	sysfs_attr_read_int	(struct sysfs_attr *attr, int *value);
+/* 여러 attribute를 한번에 읽음, return : 읽기 성공한 attribute 수 (실패시 value = 0) */
+extern int	sysfs_attr_read_ints(struct sysfs_attr *attrs, int cnt, int *values);
+/* sysfs_notify (POLLPRI) 대기, 지원하지 않는 attribute는 timeout 후 return. 1 : 변경 */
+extern int	sysfs_attr_wait		(struct sysfs_attr *attr, int timeout_ms);
+
+//------------------------------------------------------------------------------
+#endif	// #define __SYSFS_ATTR_H__
+//------------------------------------------------------------------------------
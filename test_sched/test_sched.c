@@ -0,0 +1,277 @@
+//------------------------------------------------------------------------------
+/**
+ * @file test_sched.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief resource aware test scheduler (resource lock, cpu affinity).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "test_sched.h"
+
+//------------------------------------------------------------------------------
+/*
+	측정 구간(benchmark) 전후로 test_sched_acquire/release 호출.
+	- resource 별 동시 사용 수 제한 (limit 0 : 제한 없음)
+	- 먼저 요청한 test와 resource가 겹치는 경우 순서대로 실행 (starvation 방지)
+	- 겹치지 않는 test는 동시 실행
+*/
+//------------------------------------------------------------------------------
+struct sched_wait {
+	unsigned long	ticket;
+	int				mask;
+};
+
+static pthread_mutex_t	SchedLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t	SchedCond = PTHREAD_COND_INITIALIZER;
+static int				ResUsed [SCHED_RES_MAX];
+static int				ResLimit[SCHED_RES_MAX];
+static struct sched_wait	Waits[SCHED_WAIT_MAX];
+static int				WaitCnt = 0;
+static unsigned long	TicketNext = 0;
+
+//------------------------------------------------------------------------------
+void test_sched_init (void)
+{
+	int i;
+
+	pthread_mutex_lock (&SchedLock);
+	for (i = 0; i < SCHED_RES_MAX; i++) {
+		ResUsed [i] = 0;
+		ResLimit[i] = 1;
+	}
+	ResLimit[__builtin_ctz (RES_CPU)]   = SCHED_CPU_SLOTS;
+	ResLimit[__builtin_ctz (RES_INPUT)] = 0;
+	WaitCnt = 0;
+	pthread_mutex_unlock (&SchedLock);
+}
+
+//------------------------------------------------------------------------------
+void test_sched_set_limit (int res, int limit)
+{
+	if (!res)
+		return;
+
+	pthread_mutex_lock (&SchedLock);
+	ResLimit[__builtin_ctz (res)] = limit;
+	pthread_mutex_unlock (&SchedLock);
+	pthread_cond_broadcast (&SchedCond);
+}
+
+//------------------------------------------------------------------------------
+// excl = 1 : resource 의 limit 전체 사용 (사용 중인 test 가 없는 경우만 가능)
+//------------------------------------------------------------------------------
+static int res_available (int mask, int excl)
+{
+	int i;
+
+	for (i = 0; i < SCHED_RES_MAX; i++) {
+		if (!(mask & (1 << i)) || !ResLimit[i])
+			continue;
+		if (excl ? ResUsed[i] : (ResUsed[i] >= ResLimit[i]))
+			return 0;
+	}
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+static void res_take (int mask, int take, int excl)
+{
+	int i;
+
+	for (i = 0; i < SCHED_RES_MAX; i++) {
+		if ((mask & (1 << i)) && ResLimit[i])
+			ResUsed[i] += (take ? 1 : -1) * (excl ? ResLimit[i] : 1);
+	}
+}
+
+//------------------------------------------------------------------------------
+/* 먼저 대기중인 요청 중 resource가 겹치는 요청이 있는 경우 양보 */
+static int res_earlier_conflict (unsigned long ticket, int mask)
+{
+	int i;
+
+	for (i = 0; i < WaitCnt; i++) {
+		if ((Waits[i].ticket < ticket) && (Waits[i].mask & mask))
+			return 1;
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+static void wait_remove (unsigned long ticket)
+{
+	int i;
+
+	for (i = 0; i < WaitCnt; i++) {
+		if (Waits[i].ticket == ticket) {
+			Waits[i] = Waits[--WaitCnt];
+			break;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// return : 대기 시간 (ms)
+//------------------------------------------------------------------------------
+static long sched_acquire (int mask, int excl)
+{
+	struct timespec start, end;
+	unsigned long ticket;
+	int queued = 0;
+
+	mask &= ~RES_INPUT;
+	if (!mask)
+		return 0;
+
+	clock_gettime (CLOCK_MONOTONIC, &start);
+
+	pthread_mutex_lock (&SchedLock);
+	ticket = TicketNext++;
+	if (WaitCnt < SCHED_WAIT_MAX) {
+		Waits[WaitCnt].ticket = ticket;
+		Waits[WaitCnt].mask   = mask;
+		WaitCnt++;	queued = 1;
+	}
+	while (!res_available (mask, excl) || res_earlier_conflict (ticket, mask))
+		pthread_cond_wait (&SchedCond, &SchedLock);
+
+	if (queued)
+		wait_remove (ticket);
+	res_take (mask, 1, excl);
+	pthread_mutex_unlock (&SchedLock);
+
+	/* 대기열 변경으로 다른 요청이 진행 가능할 수 있음 */
+	pthread_cond_broadcast (&SchedCond);
+
+	clock_gettime (CLOCK_MONOTONIC, &end);
+	return	(end.tv_sec - start.tv_sec) * 1000L +
+			(end.tv_nsec - start.tv_nsec) / 1000000L;
+}
+
+//------------------------------------------------------------------------------
+long test_sched_acquire (int mask)
+{
+	return	sched_acquire (mask, 0);
+}
+
+//------------------------------------------------------------------------------
+// 전체 core 를 사용하는 측정 (memory bandwidth) : RES_CPU 의 slot 을 모두 사용
+//------------------------------------------------------------------------------
+long test_sched_acquire_excl (int mask)
+{
+	return	sched_acquire (mask, 1);
+}
+
+//------------------------------------------------------------------------------
+int test_sched_try_acquire (int mask)
+{
+	int ok = 0;
+
+	mask &= ~RES_INPUT;
+
+	pthread_mutex_lock (&SchedLock);
+	if (res_available (mask, 0) && !res_earlier_conflict (TicketNext, mask)) {
+		res_take (mask, 1, 0);
+		ok = 1;
+	}
+	pthread_mutex_unlock (&SchedLock);
+	return ok;
+}
+
+//------------------------------------------------------------------------------
+static void sched_release (int mask, int excl)
+{
+	mask &= ~RES_INPUT;
+	if (!mask)
+		return;
+
+	pthread_mutex_lock (&SchedLock);
+	res_take (mask, 0, excl);
+	pthread_mutex_unlock (&SchedLock);
+	pthread_cond_broadcast (&SchedCond);
+}
+
+//------------------------------------------------------------------------------
+void test_sched_release (int mask)
+{
+	sched_release (mask, 0);
+}
+
+//------------------------------------------------------------------------------
+void test_sched_release_excl (int mask)
+{
+	sched_release (mask, 1);
+}
+
+//------------------------------------------------------------------------------
+/* resource 사용 중 또는 대기중인 요청이 있는 경우 1 */
+int test_sched_busy (int mask)
+{
+	int i, busy = 0;
+
+	pthread_mutex_lock (&SchedLock);
+	for (i = 0; i < SCHED_RES_MAX; i++) {
+		if ((mask & (1 << i)) && ResUsed[i])
+			busy = 1;
+	}
+	for (i = 0; i < WaitCnt; i++) {
+		if (Waits[i].mask & mask)
+			busy = 1;
+	}
+	pthread_mutex_unlock (&SchedLock);
+	return busy;
+}
+
+//------------------------------------------------------------------------------
+// bench = 1 : SCHED_UI_CPU를 제외한 core, bench = 0 : SCHED_UI_CPU
+// (single core system 에서는 설정하지 않음)
+//------------------------------------------------------------------------------
+static int sched_cpuset (cpu_set_t *set, int bench)
+{
+	int i, ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+
+	if (ncpu < 2)
+		return 0;
+
+	CPU_ZERO (set);
+	for (i = 0; i < ncpu; i++) {
+		if ((i == SCHED_UI_CPU) ^ bench)
+			CPU_SET (i, set);
+	}
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+int test_sched_attr (pthread_attr_t *attr, int bench)
+{
+	cpu_set_t set;
+
+	if (!sched_cpuset (&set, bench))
+		return 0;
+	return pthread_attr_setaffinity_np (attr, sizeof(set), &set) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+int test_sched_pin_self (int bench)
+{
+	cpu_set_t set;
+
+	if (!sched_cpuset (&set, bench))
+		return 0;
+	return pthread_setaffinity_np (pthread_self (), sizeof(set), &set) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
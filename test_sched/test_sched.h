@@ -0,0 +1,52 @@
+//------------------------------------------------------------------------------
+/**
+ * @file test_sched.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief resource aware test scheduler (resource lock, cpu affinity).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __TEST_SCHED_H__
+#define __TEST_SCHED_H__
+
+//------------------------------------------------------------------------------
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+/* test가 사용하는 resource (bit mask) */
+#define	RES_NONE	0x00
+#define	RES_CPU		0x01	/* cpu/memory bandwidth benchmark */
+#define	RES_PCIE	0x02	/* pcie lane (sata/nvme) */
+#define	RES_EMMC	0x04
+#define	RES_USB		0x08
+#define	RES_ETH		0x10	/* eth link (iperf, link speed change) */
+#define	RES_EFUSE	0x20
+#define	RES_INPUT	0x40	/* 작업자 입력 대기 (동시 실행 제한 없음) */
+
+#define	SCHED_RES_MAX		8
+/* 동시에 실행 가능한 cpu benchmark 수 (4 core 중 UI/input core 제외) */
+#define	SCHED_CPU_SLOTS		2
+/* UI/input thread core, 나머지 core는 benchmark thread 용 */
+#define	SCHED_UI_CPU		0
+#define	SCHED_WAIT_MAX		32
+
+//------------------------------------------------------------------------------
+extern void	test_sched_init		(void);
+extern void	test_sched_set_limit(int res, int limit);
+extern long	test_sched_acquire	(int mask);
+extern int	test_sched_try_acquire	(int mask);
+extern void	test_sched_release	(int mask);
+/* resource limit 전체 사용 (다른 test 와 동시 실행 안함) */
+extern long	test_sched_acquire_excl	(int mask);
+extern void	test_sched_release_excl	(int mask);
+extern int	test_sched_busy		(int mask);
+extern int	test_sched_attr		(pthread_attr_t *attr, int bench);
+extern int	test_sched_pin_self	(int bench);
+
+//------------------------------------------------------------------------------
+#endif	// #define __TEST_SCHED_H__
+//------------------------------------------------------------------------------
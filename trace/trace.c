@@ -0,0 +1,247 @@
+//------------------------------------------------------------------------------
+/**
+ * @file trace.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief test timing trace (chrome trace json, prometheus text export).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+
+#include "trace.h"
+
+//------------------------------------------------------------------------------
+struct trace_event {
+	const char	*cat;
+	const char	*name;
+	long		ts_us;
+	/* -1 : instant event, -2 : counter */
+	long		dur_us;
+	long		arg;
+	int			tid;
+	/* 기록 완료 (export 시 기록 중인 event 제외) */
+	volatile int	valid;
+};
+
+struct trace_hist {
+	const char		*cat;
+	const char		*name;
+	unsigned long	bucket[TRACE_BUCKET_CNT];
+	unsigned long	count;
+	unsigned long	sum_us;
+	long			max_us;
+};
+
+static struct trace_event	Events[TRACE_EVENT_MAX];
+static int					EventCnt = 0;
+
+static struct trace_hist	Hists[TRACE_HIST_MAX];
+static int					HistCnt = 0;
+static pthread_mutex_t		HistLock = PTHREAD_MUTEX_INITIALIZER;
+
+static const long			BucketMs[TRACE_BUCKET_CNT] = TRACE_BUCKETS;
+static long					BaseUs = 0;
+static __thread int			Tid = 0;
+
+//------------------------------------------------------------------------------
+long trace_now_us (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return	ts.tv_sec * 1000000L + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+void trace_init (void)
+{
+	memset (Events, 0, sizeof(Events));
+	memset (Hists,  0, sizeof(Hists));
+	EventCnt = HistCnt = 0;
+	BaseUs   = trace_now_us ();
+}
+
+//------------------------------------------------------------------------------
+int trace_event_cnt (void)
+{
+	return	EventCnt < TRACE_EVENT_MAX ? EventCnt : TRACE_EVENT_MAX;
+}
+
+//------------------------------------------------------------------------------
+static int thread_id (void)
+{
+	if (!Tid)
+		Tid = syscall (SYS_gettid);
+	return Tid;
+}
+
+//------------------------------------------------------------------------------
+static void event_add (const char *cat, const char *name, long ts_us, long dur_us, long arg)
+{
+	struct trace_event *ev;
+	int idx = __sync_fetch_and_add (&EventCnt, 1);
+
+	if (idx >= TRACE_EVENT_MAX)
+		return;
+
+	ev = &Events[idx];
+	ev->cat    = cat;
+	ev->name   = name;
+	ev->ts_us  = ts_us;
+	ev->dur_us = dur_us;
+	ev->arg    = arg;
+	ev->tid    = thread_id ();
+	__sync_synchronize ();
+	ev->valid  = 1;
+}
+
+//------------------------------------------------------------------------------
+static struct trace_hist *hist_get (const char *cat, const char *name)
+{
+	struct trace_hist *h = NULL;
+	int i, cnt = HistCnt;
+
+	/* 등록된 histogram 은 변경되지 않으므로 lock 없이 검색 */
+	for (i = 0; i < cnt; i++)
+		if ((Hists[i].name == name) && (Hists[i].cat == cat))
+			return &Hists[i];
+
+	pthread_mutex_lock (&HistLock);
+	for (i = 0; i < HistCnt; i++) {
+		if (!strcmp (Hists[i].name, name) && !strcmp (Hists[i].cat, cat)) {
+			h = &Hists[i];
+			break;
+		}
+	}
+	if ((h == NULL) && (HistCnt < TRACE_HIST_MAX)) {
+		h = &Hists[HistCnt];
+		h->cat  = cat;
+		h->name = name;
+		__sync_synchronize ();
+		HistCnt++;
+	}
+	pthread_mutex_unlock (&HistLock);
+	return h;
+}
+
+//------------------------------------------------------------------------------
+void trace_end (const char *cat, const char *name, long start_us, long arg)
+{
+	struct trace_hist *h;
+	long dur = trace_now_us () - start_us, max;
+	int i;
+
+	event_add (cat, name, start_us, dur, arg);
+
+	if ((h = hist_get (cat, name)) == NULL)
+		return;
+	for (i = 0; i < TRACE_BUCKET_CNT; i++) {
+		if (dur <= BucketMs[i] * 1000) {
+			__sync_fetch_and_add (&h->bucket[i], 1);
+			break;
+		}
+	}
+	__sync_fetch_and_add (&h->count, 1);
+	__sync_fetch_and_add (&h->sum_us, dur);
+	while ((max = h->max_us) < dur)
+		if (__sync_bool_compare_and_swap (&h->max_us, max, dur))
+			break;
+}
+
+//------------------------------------------------------------------------------
+void trace_instant (const char *cat, const char *name, long arg)
+{
+	event_add (cat, name, trace_now_us (), -1, arg);
+}
+
+//------------------------------------------------------------------------------
+void trace_counter (const char *cat, const char *name, long ts_us, long value)
+{
+	event_add (cat, name, ts_us, -2, value);
+}
+
+//------------------------------------------------------------------------------
+int trace_export_chrome (const char *fname)
+{
+	FILE *fp;
+	int i, cnt = trace_event_cnt (), first = 1;
+
+	if ((fp = fopen (fname, "w")) == NULL) {
+		fprintf (stderr, "%s : %s open error\n", __func__, fname);
+		return -1;
+	}
+	fprintf (fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	for (i = 0; i < cnt; i++) {
+		const struct trace_event *ev = &Events[i];
+
+		if (!ev->valid)
+			continue;
+		fprintf (fp, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%ld,",
+			first ? "" : ",\n", ev->name, ev->cat, ev->tid, ev->ts_us - BaseUs);
+		if (ev->dur_us == -2)
+			fprintf (fp, "\"ph\":\"C\",");
+		else if (ev->dur_us < 0)
+			fprintf (fp, "\"ph\":\"i\",\"s\":\"t\",");
+		else
+			fprintf (fp, "\"ph\":\"X\",\"dur\":%ld,", ev->dur_us);
+		fprintf (fp, "\"args\":{\"value\":%ld}}", ev->arg);
+		first = 0;
+	}
+	fprintf (fp, "\n]}\n");
+	fclose (fp);
+
+	if (EventCnt > TRACE_EVENT_MAX)
+		fprintf (stderr, "%s : %d events dropped\n", __func__, EventCnt - TRACE_EVENT_MAX);
+	return cnt;
+}
+
+//------------------------------------------------------------------------------
+int trace_export_prom (const char *fname)
+{
+	FILE *fp;
+	unsigned long cum;
+	int i, j, cnt = HistCnt;
+
+	if ((fp = fopen (fname, "w")) == NULL) {
+		fprintf (stderr, "%s : %s open error\n", __func__, fname);
+		return -1;
+	}
+	fprintf (fp, "# HELP m1_duration_ms test/external call duration\n");
+	fprintf (fp, "# TYPE m1_duration_ms histogram\n");
+	for (i = 0; i < cnt; i++) {
+		const struct trace_hist *h = &Hists[i];
+
+		for (j = 0, cum = 0; j < TRACE_BUCKET_CNT; j++) {
+			cum += h->bucket[j];
+			fprintf (fp, "m1_duration_ms_bucket{cat=\"%s\",name=\"%s\",le=\"%ld\"} %lu\n",
+				h->cat, h->name, BucketMs[j], cum);
+		}
+		fprintf (fp, "m1_duration_ms_bucket{cat=\"%s\",name=\"%s\",le=\"+Inf\"} %lu\n",
+			h->cat, h->name, h->count);
+		fprintf (fp, "m1_duration_ms_sum{cat=\"%s\",name=\"%s\"} %.3f\n",
+			h->cat, h->name, h->sum_us / 1000.0);
+		fprintf (fp, "m1_duration_ms_count{cat=\"%s\",name=\"%s\"} %lu\n",
+			h->cat, h->name, h->count);
+	}
+	fprintf (fp, "# HELP m1_duration_max_ms longest duration\n");
+	fprintf (fp, "# TYPE m1_duration_max_ms gauge\n");
+	for (i = 0; i < cnt; i++)
+		fprintf (fp, "m1_duration_max_ms{cat=\"%s\",name=\"%s\"} %.3f\n",
+			Hists[i].cat, Hists[i].name, Hists[i].max_us / 1000.0);
+	fclose (fp);
+	return cnt;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,47 @@
+//------------------------------------------------------------------------------
+/**
+ * @file trace.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief test timing trace (chrome trace json, prometheus text export).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+//------------------------------------------------------------------------------
+/* 1회 실행 event 최대 수 (초과 event 는 histogram 만 갱신) */
+#define	TRACE_EVENT_MAX		8192
+/* histogram 종류 (cat + name) 최대 수 */
+#define	TRACE_HIST_MAX		64
+/* histogram bucket (ms) */
+#define	TRACE_BUCKETS		{ 1, 5, 10, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 30000, 60000 }
+#define	TRACE_BUCKET_CNT	13
+
+//------------------------------------------------------------------------------
+/*
+	cat, name 은 문자열 pointer 를 그대로 저장하므로 실행 중 유지되는 문자열 사용.
+	(문자열 상수, M1_Items[].error_str 등)
+	event 기록은 lock 없이 index 증가 후 기록, histogram 은 처음 등록시에만 lock.
+*/
+extern void	trace_init			(void);
+/* monotonic us */
+extern long	trace_now_us		(void);
+/* start_us (trace_now_us) ~ 현재 구간 기록, arg : 결과값 (speed, result 등) */
+extern void	trace_end			(const char *cat, const char *name, long start_us, long arg);
+extern void	trace_instant		(const char *cat, const char *name, long arg);
+/* 시간에 따른 측정값 (chrome trace counter), ts_us : 측정 시간 (trace_now_us 기준) */
+extern void	trace_counter		(const char *cat, const char *name, long ts_us, long value);
+extern int	trace_event_cnt		(void);
+/* chrome://tracing, ui.perfetto.dev 에서 열 수 있는 json */
+extern int	trace_export_chrome	(const char *fname);
+/* prometheus text format (histogram) */
+extern int	trace_export_prom	(const char *fname);
+
+//------------------------------------------------------------------------------
+#endif	// #define __TRACE_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,290 @@
+//------------------------------------------------------------------------------
+/**
+ * @file ui_cache.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief rendered box/string image cache (framebuffer native pixel format).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ui_cache.h"
+#include "../fb_kernel/fb_kernel.h"
+
+//------------------------------------------------------------------------------
+struct ui_cache_entry {
+	struct ui_cache_key		key;
+	unsigned int			hash;
+	/* image 의 box 색상, 배경 native pixel (bg_valid 인 경우 recolor 가능) */
+	int						rc;
+	uint32_t				bg;
+	char					bg_valid;
+	char					*data;
+	int						size;
+	/* LRU */
+	unsigned long			tick;
+	struct ui_cache_entry	*next;
+};
+
+struct ui_cache_color {
+	int			rc;
+	uint32_t	pixel;
+};
+
+static struct ui_cache_entry	*Hash[UI_CACHE_HASH_SIZE];
+static struct ui_cache_color	Colors[UI_CACHE_COLOR_MAX];
+static int						ColorCnt = 0;
+static struct ui_cache_stat		Stat;
+static long						MaxBytes = UI_CACHE_MAX_BYTES;
+static unsigned long			Tick = 0;
+
+//------------------------------------------------------------------------------
+static unsigned int key_hash (const struct ui_cache_key *key)
+{
+	const unsigned char *p = (const unsigned char *)key;
+	unsigned int h = 2166136261u;
+	unsigned int i;
+
+	/* FNV-1a */
+	for (i = 0; i < sizeof(struct ui_cache_key); i++)
+		h = (h ^ p[i]) * 16777619u;
+	return h;
+}
+
+//------------------------------------------------------------------------------
+static struct ui_cache_entry *lookup (const struct ui_cache_key *key, unsigned int hash)
+{
+	struct ui_cache_entry *e;
+
+	for (e = Hash[hash % UI_CACHE_HASH_SIZE]; e != NULL; e = e->next)
+		if ((e->hash == hash) && !memcmp (&e->key, key, sizeof(struct ui_cache_key)))
+			return e;
+	return NULL;
+}
+
+//------------------------------------------------------------------------------
+static void entry_free (struct ui_cache_entry *victim)
+{
+	struct ui_cache_entry **pp = &Hash[victim->hash % UI_CACHE_HASH_SIZE];
+
+	while (*pp != victim)
+		pp = &(*pp)->next;
+	*pp = victim->next;
+
+	Stat.bytes -= victim->size;
+	Stat.entries--;
+	free (victim->data);
+	free (victim);
+}
+
+//------------------------------------------------------------------------------
+static void evict_lru (void)
+{
+	struct ui_cache_entry *e, *victim = NULL;
+	int i;
+
+	for (i = 0; i < UI_CACHE_HASH_SIZE; i++)
+		for (e = Hash[i]; e != NULL; e = e->next)
+			if ((victim == NULL) || (e->tick < victim->tick))
+				victim = e;
+	if (victim != NULL) {
+		entry_free (victim);
+		Stat.evict++;
+	}
+}
+
+//------------------------------------------------------------------------------
+static int color_get (int rc, uint32_t *pixel)
+{
+	int i;
+
+	for (i = 0; i < ColorCnt; i++) {
+		if (Colors[i].rc == rc) {
+			*pixel = Colors[i].pixel;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+static void color_set (int rc, uint32_t pixel)
+{
+	uint32_t old;
+
+	if (color_get (rc, &old) || (ColorCnt >= UI_CACHE_COLOR_MAX))
+		return;
+	Colors[ColorCnt].rc    = rc;
+	Colors[ColorCnt].pixel = pixel;
+	ColorCnt++;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t pixel_get (const char *p, int bytes)
+{
+	uint16_t p16;
+	uint32_t p32;
+
+	if (bytes == 2) {
+		memcpy (&p16, p, 2);
+		return p16;
+	}
+	memcpy (&p32, p, 4);
+	return p32;
+}
+
+//------------------------------------------------------------------------------
+int ui_cache_init (long max_bytes)
+{
+	ui_cache_close ();
+	MaxBytes = max_bytes;
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+void ui_cache_close (void)
+{
+	int i;
+
+	for (i = 0; i < UI_CACHE_HASH_SIZE; i++)
+		while (Hash[i] != NULL)
+			entry_free (Hash[i]);
+
+	memset (&Stat, 0, sizeof(Stat));
+	ColorCnt = 0;
+	Tick     = 0;
+}
+
+//------------------------------------------------------------------------------
+static int rect_valid (fb_info_t *pfb, const struct ui_cache_key *key, int x, int y)
+{
+	return	(x >= 0) && (y >= 0) && (key->w > 0) && (key->h > 0) &&
+			(x + key->w <= pfb->w) && (y + key->h <= pfb->h);
+}
+
+//------------------------------------------------------------------------------
+// 배경 pixel 만 bg -> pixel 로 바꾸어 copy (16/32 bpp)
+//------------------------------------------------------------------------------
+static void blit_recolor (char *dst, const char *src, int w, int h, int stride, int bytes,
+						uint32_t bg, uint32_t pixel)
+{
+	int i, j;
+
+	for (j = 0; j < h; j++, dst += stride, src += w * bytes) {
+		if (bytes == 4)
+			fb_kernel_recolor32 ((uint32_t *)dst, (const uint32_t *)src, w, bg, pixel);
+		else {
+			const uint16_t *s = (const uint16_t *)src;
+			uint16_t *d = (uint16_t *)dst;
+
+			for (i = 0; i < w; i++)
+				d[i] = (s[i] == (uint16_t)bg) ? (uint16_t)pixel : s[i];
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+int ui_cache_draw (fb_info_t *pfb, const struct ui_cache_key *key, int rc, int x, int y)
+{
+	struct ui_cache_entry *e;
+	int bytes = pfb->bpp / 8, row = key->w * bytes;
+	char *dst;
+	uint32_t pixel;
+
+	if (!rect_valid (pfb, key, x, y) || ((e = lookup (key, key_hash (key))) == NULL)) {
+		Stat.miss++;
+		return 0;
+	}
+	dst = pfb->data + y * pfb->stride + x * bytes;
+	if (e->rc == rc) {
+		fb_kernel_copy (dst, pfb->stride, e->data, row, row, key->h, 0);
+		Stat.hit++;
+	} else if (e->bg_valid && ((bytes == 2) || (bytes == 4)) && color_get (rc, &pixel)) {
+		blit_recolor (dst, e->data, key->w, key->h, pfb->stride, bytes, e->bg, pixel);
+		Stat.recolor++;
+	} else {
+		Stat.miss++;
+		return 0;
+	}
+	e->tick = ++Tick;
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+// 배경 pixel : 외곽선 안쪽 3 모서리가 같은 값인 경우만 recolor 에 사용
+//------------------------------------------------------------------------------
+static void bg_detect (struct ui_cache_entry *e, int bytes)
+{
+	const struct ui_cache_key *k = &e->key;
+	int m = k->lw + 1, row = k->w * bytes;
+	uint32_t p0, p1, p2;
+
+	e->bg_valid = 0;
+	if (((bytes != 2) && (bytes != 4)) || (k->w <= m * 2) || (k->h <= m * 2))
+		return;
+
+	p0 = pixel_get (e->data + m * row + m * bytes, bytes);
+	p1 = pixel_get (e->data + m * row + (k->w - m - 1) * bytes, bytes);
+	p2 = pixel_get (e->data + (k->h - m - 1) * row + m * bytes, bytes);
+	if ((p0 != p1) || (p0 != p2))
+		return;
+
+	e->bg       = p0;
+	e->bg_valid = 1;
+	color_set (e->rc, p0);
+}
+
+//------------------------------------------------------------------------------
+void ui_cache_store (fb_info_t *pfb, const struct ui_cache_key *key, int rc, int x, int y)
+{
+	struct ui_cache_entry *e;
+	unsigned int hash = key_hash (key);
+	int bytes = pfb->bpp / 8, row = key->w * bytes, size = row * key->h;
+
+	if (!rect_valid (pfb, key, x, y) || (size > MaxBytes))
+		return;
+
+	if ((e = lookup (key, hash)) == NULL) {
+		while (Stat.entries && (Stat.bytes + size > MaxBytes))
+			evict_lru ();
+		if ((e = calloc (1, sizeof(struct ui_cache_entry))) == NULL)
+			return;
+		if ((e->data = malloc (size)) == NULL) {
+			free (e);
+			return;
+		}
+		memcpy (&e->key, key, sizeof(struct ui_cache_key));
+		e->hash = hash;
+		e->size = size;
+		e->next = Hash[hash % UI_CACHE_HASH_SIZE];
+		Hash[hash % UI_CACHE_HASH_SIZE] = e;
+		Stat.bytes += size;
+		Stat.entries++;
+	}
+	fb_kernel_copy (e->data, row, pfb->data + y * pfb->stride + x * bytes, pfb->stride, row, key->h, 0);
+	e->rc   = rc;
+	e->tick = ++Tick;
+	bg_detect (e, bytes);
+}
+
+//------------------------------------------------------------------------------
+void ui_cache_set_color (int rc, uint32_t pixel)
+{
+	color_set (rc, pixel);
+}
+
+//------------------------------------------------------------------------------
+void ui_cache_get_stat (struct ui_cache_stat *stat)
+{
+	memcpy (stat, &Stat, sizeof(struct ui_cache_stat));
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
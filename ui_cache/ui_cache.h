@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------
+/**
+ * @file ui_cache.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief rendered box/string image cache (framebuffer native pixel format).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __UI_CACHE_H__
+#define __UI_CACHE_H__
+
+//------------------------------------------------------------------------------
+#include <stdint.h>
+#include "../lib_fbui/lib_fb.h"
+
+//------------------------------------------------------------------------------
+/* cache 최대 memory (box image 합계), 초과시 가장 오래 사용하지 않은 image 제거 */
+#define	UI_CACHE_MAX_BYTES		(4 * 1024 * 1024)
+#define	UI_CACHE_STR_SIZE		64
+#define	UI_CACHE_HASH_SIZE		64
+/* box 색상(rc) -> native pixel 변환 기록 수 */
+#define	UI_CACHE_COLOR_MAX		32
+
+//------------------------------------------------------------------------------
+/*
+	lib_fbui 가 그린 box (배경 + 외곽선 + 문자열) 를 key 별로 저장.
+	key 가 같고 box 색상(rc)만 다른 경우 배경 pixel 만 바꾸어 그림 (bitmap font 이므로 정확히 일치).
+	UI thread (ui_dirty_flush) 에서만 사용하므로 lock 없음.
+	key 는 memset 후 설정 (hash/비교에 struct 전체 사용).
+*/
+struct ui_cache_key {
+	int		w, h;					/* box pixel size */
+	int		lw, scale, align;		/* fbui.cfg 'B' 외곽두께, 폰트크기, 문자정렬 */
+	int		font, fc;				/* fbui.cfg 'C' 한글폰트, 기본문자색상 */
+	char	str[UI_CACHE_STR_SIZE];
+};
+
+struct ui_cache_stat {
+	unsigned long	hit;			/* 같은 색상 image blit */
+	unsigned long	recolor;		/* 배경 색상 변경 blit */
+	unsigned long	miss;			/* lib_fbui rendering */
+	unsigned long	evict;
+	long			bytes;
+	int				entries;
+};
+
+//------------------------------------------------------------------------------
+extern int	ui_cache_init	(long max_bytes);
+/* return 1 : cache image 를 (x, y) 에 그림, 0 : miss (lib_fbui 로 그린 후 ui_cache_store) */
+extern int	ui_cache_draw	(fb_info_t *pfb, const struct ui_cache_key *key, int rc, int x, int y);
+/* lib_fbui 가 (x, y) 에 그린 box 를 저장 */
+extern void	ui_cache_store	(fb_info_t *pfb, const struct ui_cache_key *key, int rc, int x, int y);
+/* box 색상(rc) 의 native pixel 을 미리 등록 (처음 사용하는 색상도 recolor 가능) */
+extern void	ui_cache_set_color	(int rc, uint32_t pixel);
+extern void	ui_cache_get_stat	(struct ui_cache_stat *stat);
+extern void	ui_cache_close	(void);
+
+//------------------------------------------------------------------------------
+#endif	// #define __UI_CACHE_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,291 @@
+//------------------------------------------------------------------------------
+/**
+ * @file ui_dirty.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief lib_fbui dirty box tracking (changed box only redraw).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "ui_dirty.h"
+#include "../ui_cache/ui_cache.h"
+#include "../ui_layout/ui_layout.h"
+
+//------------------------------------------------------------------------------
+/* Layout.items[] 와 같은 index (geometry 는 Layout 에서 읽음) */
+struct ui_dirty_box {
+	/* bit0 : rc changed, bit1 : str changed */
+	char	dirty;
+	int		rc;
+	/* 1 : ui_dirty_sitem 으로 설정된 문자열 (cfg 기본 문자열은 cache 하지 않음) */
+	char	str_set;
+	char	str[UI_DIRTY_STR_SIZE];
+};
+
+#define	DIRTY_RC	0x01
+#define	DIRTY_STR	0x02
+
+static struct ui_layout		Layout;
+static struct ui_dirty_box	Boxes[UI_LAYOUT_ITEM_MAX];
+static pthread_mutex_t		DirtyLock = PTHREAD_MUTEX_INITIALIZER;
+static struct event_notify	*DirtyNotify = NULL;
+static int					DirtyCnt = 0;
+static ui_dirty_damage_t	DamageFunc = NULL;
+static void					*DamageArg = NULL;
+
+/* cache 에서 그린 box 는 lib_fbui 의 rc/str 이 이전 값 (UI thread 에서만 사용) */
+static char					LibStale[UI_LAYOUT_ITEM_MAX];
+
+/* pixel write counter */
+static unsigned long	PixelTotal = 0, PixelSec = 0, PixelRate = 0;
+static time_t			PixelSecBase = 0;
+static long				LastFlushMs = 0;
+
+//------------------------------------------------------------------------------
+static long now_ms (void)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+//------------------------------------------------------------------------------
+static void pixel_count (unsigned long pixels)
+{
+	time_t sec = now_ms () / 1000;
+
+	if (sec != PixelSecBase) {
+		/* 이전 1초 동안 갱신이 없었던 경우 rate = 0 */
+		PixelRate    = (sec == PixelSecBase + 1) ? PixelSec : 0;
+		PixelSec     = 0;
+		PixelSecBase = sec;
+	}
+	PixelSec   += pixels;
+	PixelTotal += pixels;
+}
+
+//------------------------------------------------------------------------------
+// fbui.cfg 를 framebuffer 크기로 compile 한 box table (ui_layout) 사용.
+// ui_init 이 그린 화면으로 native pixel 변환을 확인한 경우 ui_cache 에 색상을 미리 등록.
+//------------------------------------------------------------------------------
+int ui_dirty_init (fb_info_t *pfb, const char *cfg_fname, struct event_notify *notify)
+{
+	int i;
+
+	memset (Boxes, 0, sizeof(Boxes));
+	memset (LibStale, 0, sizeof(LibStale));
+	ui_cache_init (UI_CACHE_MAX_BYTES);
+	DirtyNotify = notify;
+	DirtyCnt    = 0;
+
+	if (!ui_layout_load (&Layout, pfb, cfg_fname)) {
+		memset (&Layout, 0, sizeof(Layout));
+		memset (Layout.index, 0xFF, sizeof(Layout.index));
+		Layout.fb_w = pfb->w;
+		Layout.fb_h = pfb->h;
+		return 0;
+	}
+	ui_layout_verify (&Layout, pfb);
+	printf ("%s : %d box (%s), native pixel %s\n", __func__, Layout.count,
+		Layout.cached ? "layout cache" : "fbui.cfg compiled",
+		Layout.px_valid ? "ok" : "unverified");
+
+	/* 초기 상태는 cfg 의 기본 색상/문자열 (ui_init 에서 이미 그려짐) */
+	for (i = 0; i < Layout.count; i++)
+		Boxes[i].rc = -1;
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+void ui_dirty_set_damage (ui_dirty_damage_t damage, void *arg)
+{
+	DamageFunc = damage;
+	DamageArg  = arg;
+}
+
+//------------------------------------------------------------------------------
+static void ui_dirty_mark (struct ui_dirty_box *box, char flag)
+{
+	if (!box->dirty)
+		DirtyCnt++;
+	box->dirty |= flag;
+}
+
+//------------------------------------------------------------------------------
+void ui_dirty_ritem (int id, int rc)
+{
+	struct ui_dirty_box *box;
+	int changed = 0;
+
+	if ((id < 0) || (id >= UI_LAYOUT_ID_MAX) || (Layout.index[id] < 0))
+		return;
+
+	box = &Boxes[Layout.index[id]];
+	pthread_mutex_lock (&DirtyLock);
+	if (box->rc != rc) {
+		box->rc = rc;
+		ui_dirty_mark (box, DIRTY_RC);
+		changed = 1;
+	}
+	pthread_mutex_unlock (&DirtyLock);
+
+	if (changed && (DirtyNotify != NULL))
+		event_notify_post (DirtyNotify);
+}
+
+//------------------------------------------------------------------------------
+void ui_dirty_sitem (int id, const char *str)
+{
+	struct ui_dirty_box *box;
+	int changed = 0;
+
+	if ((id < 0) || (id >= UI_LAYOUT_ID_MAX) || (Layout.index[id] < 0))
+		return;
+
+	box = &Boxes[Layout.index[id]];
+	pthread_mutex_lock (&DirtyLock);
+	if (!box->str_set || strncmp (box->str, str, UI_DIRTY_STR_SIZE - 1)) {
+		snprintf (box->str, UI_DIRTY_STR_SIZE, "%s", str);
+		box->str_set = 1;
+		ui_dirty_mark (box, DIRTY_STR);
+		changed = 1;
+	}
+	pthread_mutex_unlock (&DirtyLock);
+
+	if (changed && (DirtyNotify != NULL))
+		event_notify_post (DirtyNotify);
+}
+
+//------------------------------------------------------------------------------
+int ui_dirty_pending (void)
+{
+	return DirtyCnt;
+}
+
+//------------------------------------------------------------------------------
+static void cache_key (struct ui_cache_key *key, const struct ui_layout_item *item, const char *str)
+{
+	memset (key, 0, sizeof(struct ui_cache_key));
+	key->w     = item->w;
+	key->h     = item->h;
+	key->lw    = item->lw;
+	key->scale = item->scale;
+	key->align = item->align;
+	key->font  = Layout.font;
+	key->fc    = Layout.fc;
+	snprintf (key->str, sizeof(key->str), "%s", str);
+}
+
+//------------------------------------------------------------------------------
+// 변경된 box만 lib_fbui로 전달하여 해당 box 영역만 갱신.
+// 같은 문자열/색상으로 그린 적이 있는 box 는 ui_cache 의 image 를 copy (font rendering 없음).
+// UI_DIRTY_FRAME_MS 이내에 다시 호출되는 경우 다음 frame으로 미룸 (return 0).
+//------------------------------------------------------------------------------
+int ui_dirty_flush (fb_info_t *pfb, ui_grp_t *pui)
+{
+	const struct ui_layout_item *item;
+	struct ui_dirty_box box;
+	struct ui_cache_key key;
+	unsigned long pixels = 0;
+	long now = now_ms ();
+	int i, drawn = 0, sync, cached;
+
+	if (!DirtyCnt || ((now - LastFlushMs) < UI_DIRTY_FRAME_MS))
+		return 0;
+
+	LastFlushMs = now;
+	for (i = 0; i < Layout.count; i++) {
+		pthread_mutex_lock (&DirtyLock);
+		memcpy (&box, &Boxes[i], sizeof(box));
+		if (Boxes[i].dirty) {
+			Boxes[i].dirty = 0;
+			DirtyCnt--;
+		}
+		pthread_mutex_unlock (&DirtyLock);
+
+		if (!box.dirty)
+			continue;
+
+		item   = &Layout.items[i];
+		cached = 0;
+		if (box.str_set) {
+			cache_key (&key, item, box.str);
+			if (Layout.px_valid && (box.rc != -1))
+				ui_cache_set_color (box.rc, ui_layout_pixel (&Layout, box.rc));
+			cached = ui_cache_draw (pfb, &key, box.rc, item->x, item->y);
+		}
+		if (cached)
+			LibStale[i] = 1;
+		else {
+			/* 이전에 cache 로 그린 box 는 rc/str 모두 lib_fbui 에 전달 */
+			sync = box.dirty | (LibStale[i] ? (DIRTY_RC | DIRTY_STR) : 0);
+			if (sync & DIRTY_RC)
+				ui_set_ritem (pfb, pui, item->id, box.rc, -1);
+			if ((sync & DIRTY_STR) && box.str_set)
+				ui_set_sitem (pfb, pui, item->id, -1, -1, box.str);
+			ui_update (pfb, pui, item->id);
+			LibStale[i] = 0;
+
+			if (box.str_set)
+				ui_cache_store (pfb, &key, box.rc, item->x, item->y);
+		}
+
+		if (DamageFunc != NULL)
+			DamageFunc (item->x, item->y, item->w, item->h, DamageArg);
+
+		pixels += item->w * item->h;
+		drawn++;
+	}
+	pixel_count (pixels);
+	return drawn;
+}
+
+//------------------------------------------------------------------------------
+void ui_dirty_full (fb_info_t *pfb, ui_grp_t *pui)
+{
+	int i, id;
+
+	/* cache 로 그린 box 의 현재 rc/str 을 lib_fbui 에 반영 후 전체 갱신 */
+	for (i = 0; i < Layout.count; i++) {
+		if (!LibStale[i])
+			continue;
+		id = Layout.items[i].id;
+		pthread_mutex_lock (&DirtyLock);
+		ui_set_ritem (pfb, pui, id, Boxes[i].rc, -1);
+		if (Boxes[i].str_set)
+			ui_set_sitem (pfb, pui, id, -1, -1, Boxes[i].str);
+		pthread_mutex_unlock (&DirtyLock);
+		LibStale[i] = 0;
+	}
+	ui_update (pfb, pui, -1);
+	if (DamageFunc != NULL)
+		DamageFunc (0, 0, Layout.fb_w, Layout.fb_h, DamageArg);
+	pixel_count (Layout.fb_w * Layout.fb_h);
+}
+
+//------------------------------------------------------------------------------
+/* 최근 1초 동안 기록된 pixel 수 */
+unsigned long ui_dirty_pixel_rate (void)
+{
+	pixel_count (0);
+	return PixelRate;
+}
+
+//------------------------------------------------------------------------------
+unsigned long ui_dirty_pixel_total (void)
+{
+	return PixelTotal;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
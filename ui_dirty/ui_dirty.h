@@ -0,0 +1,44 @@
+//------------------------------------------------------------------------------
+/**
+ * @file ui_dirty.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief lib_fbui dirty box tracking (changed box only redraw).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __UI_DIRTY_H__
+#define __UI_DIRTY_H__
+
+//------------------------------------------------------------------------------
+#include "../lib_fbui/lib_fb.h"
+#include "../lib_fbui/lib_ui.h"
+#include "../event_notify/event_notify.h"
+
+//------------------------------------------------------------------------------
+#define	UI_DIRTY_STR_SIZE	64
+/* 화면 갱신 최대 frame rate (ms) */
+#define	UI_DIRTY_FRAME_MS	50
+
+//------------------------------------------------------------------------------
+/* 갱신된 box 영역 전달 (fb_compose damage 등록용) */
+typedef void (*ui_dirty_damage_t) (int x, int y, int w, int h, void *arg);
+
+//------------------------------------------------------------------------------
+extern int				ui_dirty_init		(fb_info_t *pfb, const char *cfg_fname,
+											struct event_notify *notify);
+extern void				ui_dirty_set_damage	(ui_dirty_damage_t damage, void *arg);
+extern void				ui_dirty_ritem		(int id, int rc);
+extern void				ui_dirty_sitem		(int id, const char *str);
+extern int				ui_dirty_pending	(void);
+extern int				ui_dirty_flush		(fb_info_t *pfb, ui_grp_t *pui);
+extern void				ui_dirty_full		(fb_info_t *pfb, ui_grp_t *pui);
+extern unsigned long	ui_dirty_pixel_rate	(void);
+extern unsigned long	ui_dirty_pixel_total(void);
+
+//------------------------------------------------------------------------------
+#endif	// #define __UI_DIRTY_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,248 @@
+//------------------------------------------------------------------------------
+/**
+ * @file ui_layout.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief fbui.cfg compiled layout (pixel geometry table + binary cache).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "ui_layout.h"
+
+//------------------------------------------------------------------------------
+/* binary cache : header + struct ui_layout (같은 binary 에서만 사용하므로 host byte order) */
+struct ui_layout_hdr {
+	uint32_t	magic;
+	uint16_t	version;
+	uint16_t	rsvd;
+	uint32_t	size;
+	/* fbui.cfg 변경 확인 (stat, file 을 읽지 않음) */
+	int64_t		cfg_mtime_sec;
+	int64_t		cfg_mtime_nsec;
+	int64_t		cfg_size;
+};
+
+//------------------------------------------------------------------------------
+uint32_t ui_layout_pixel (const struct ui_layout *lo, uint32_t rgb)
+{
+	uint32_t r = (rgb >> 16) & 0xFF, g = (rgb >> 8) & 0xFF, b = rgb & 0xFF, t;
+
+	if (lo->lcd_bgr) {
+		t = r;	r = b;	b = t;
+	}
+	if (lo->bpp == 16)
+		return	((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+	return	lo->alpha | (r << 16) | (g << 8) | b;
+}
+
+//------------------------------------------------------------------------------
+static void layout_colors (struct ui_layout *lo)
+{
+	lo->fc_px = ui_layout_pixel (lo, lo->fc);
+	lo->rc_px = ui_layout_pixel (lo, lo->rc);
+	lo->lc_px = ui_layout_pixel (lo, lo->lc);
+}
+
+//------------------------------------------------------------------------------
+// fbui.cfg 'B' command (x%, y%, w%, h%)에서 box pixel 영역 계산.
+// B(cmd), ID(id), 시작x좌표(x%), 시작y좌표(y%), 넓이(w%), 높이(h%), 외곽두께(lw), 폰트크기(scale), 문자정렬(align), ...
+//------------------------------------------------------------------------------
+static int layout_compile (struct ui_layout *lo, fb_info_t *pfb, const char *cfg_fname)
+{
+	struct ui_layout_item *item;
+	FILE *fp;
+	char line[256];
+	int id, x, y, w, h, lw, scale, align, lcd_bgr, font;
+	unsigned int fc, rc, lc;
+
+	memset (lo, 0, sizeof(struct ui_layout));
+	memset (lo->index, 0xFF, sizeof(lo->index));
+	lo->fb_w = pfb->w;
+	lo->fb_h = pfb->h;
+	lo->bpp  = pfb->bpp;
+
+	if ((fp = fopen (cfg_fname, "r")) == NULL) {
+		printf ("%s : %s open error!\n", __func__, cfg_fname);
+		return 0;
+	}
+	while (fgets (line, sizeof(line), fp) != NULL) {
+		/* C(cmd), LCD RGB배열, 기본문자색상(fc), 기본박스색상(rc), 기본외곽색상(lc), 한글폰트(fn) */
+		if (line[0] == 'C') {
+			if (sscanf (line, "C, %d, %x, %x, %x, %d", &lcd_bgr, &fc, &rc, &lc, &font) == 5) {
+				lo->lcd_bgr = lcd_bgr;
+				lo->font    = font;
+				lo->fc = fc;	lo->rc = rc;	lo->lc = lc;
+			}
+			continue;
+		}
+		if (line[0] != 'B')
+			continue;
+		lw = scale = align = -1;
+		if (sscanf (line, "B, %d, %d, %d, %d, %d, %d, %d, %d",
+			&id, &x, &y, &w, &h, &lw, &scale, &align) < 5)
+			continue;
+		if ((id < 0) || (id >= UI_LAYOUT_ID_MAX) || (lo->index[id] >= 0))
+			continue;
+		if (lo->count >= UI_LAYOUT_ITEM_MAX) {
+			printf ("%s : too many box (max %d), ID %03d ignored\n", __func__, UI_LAYOUT_ITEM_MAX, id);
+			continue;
+		}
+
+		item = &lo->items[lo->count];
+		item->id    = id;
+		item->x     = (pfb->w * x) / 100;
+		item->y     = (pfb->h * y) / 100;
+		item->w     = (pfb->w * w) / 100;
+		item->h     = (pfb->h * h) / 100;
+		item->lw    = lw;
+		item->scale = scale;
+		item->align = align;
+
+		lo->index[id] = lo->count++;
+	}
+	fclose (fp);
+	layout_colors (lo);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+static int layout_cache_read (struct ui_layout *lo, fb_info_t *pfb, const char *bin_fname,
+								const struct stat *cfg_st)
+{
+	struct ui_layout_hdr hdr;
+	FILE *fp;
+	int ok, i;
+
+	if ((fp = fopen (bin_fname, "rb")) == NULL)
+		return 0;
+	ok =	(fread (&hdr, sizeof(hdr), 1, fp) == 1) &&
+			(hdr.magic   == UI_LAYOUT_MAGIC) &&
+			(hdr.version == UI_LAYOUT_VERSION) &&
+			(hdr.size    == sizeof(struct ui_layout)) &&
+			(hdr.cfg_mtime_sec  == (int64_t)cfg_st->st_mtim.tv_sec) &&
+			(hdr.cfg_mtime_nsec == (int64_t)cfg_st->st_mtim.tv_nsec) &&
+			(hdr.cfg_size       == (int64_t)cfg_st->st_size) &&
+			(fread (lo, sizeof(struct ui_layout), 1, fp) == 1);
+	fclose (fp);
+
+	/* framebuffer 크기가 다르면 다시 compile */
+	ok =	ok &&
+			(lo->fb_w == pfb->w) && (lo->fb_h == pfb->h) && (lo->bpp == pfb->bpp) &&
+			(lo->count >= 0) && (lo->count <= UI_LAYOUT_ITEM_MAX);
+	/* 손상된 cache 의 index 로 items[] 밖을 읽지 않도록 확인 */
+	for (i = 0; ok && (i < UI_LAYOUT_ID_MAX); i++)
+		ok = (lo->index[i] < lo->count);
+	return	ok;
+}
+
+//------------------------------------------------------------------------------
+// 임시 file 에 기록 후 rename (기록 중 전원이 꺼져도 이전 cache 또는 cache 없음)
+//------------------------------------------------------------------------------
+static void layout_cache_write (const struct ui_layout *lo, const char *bin_fname,
+								const struct stat *cfg_st)
+{
+	struct ui_layout_hdr hdr;
+	char tmp_fname[512];
+	FILE *fp;
+	int ok;
+
+	memset (&hdr, 0, sizeof(hdr));
+	hdr.magic          = UI_LAYOUT_MAGIC;
+	hdr.version        = UI_LAYOUT_VERSION;
+	hdr.size           = sizeof(struct ui_layout);
+	hdr.cfg_mtime_sec  = cfg_st->st_mtim.tv_sec;
+	hdr.cfg_mtime_nsec = cfg_st->st_mtim.tv_nsec;
+	hdr.cfg_size       = cfg_st->st_size;
+
+	snprintf (tmp_fname, sizeof(tmp_fname), "%s.tmp", bin_fname);
+	if ((fp = fopen (tmp_fname, "wb")) == NULL) {
+		printf ("%s : %s open error (%s)\n", __func__, tmp_fname, strerror (errno));
+		return;
+	}
+	ok = (fwrite (&hdr, sizeof(hdr), 1, fp) == 1) && (fwrite (lo, sizeof(struct ui_layout), 1, fp) == 1);
+	if (fclose (fp) || !ok || rename (tmp_fname, bin_fname)) {
+		printf ("%s : %s write error\n", __func__, bin_fname);
+		remove (tmp_fname);
+	}
+}
+
+//------------------------------------------------------------------------------
+// {cfg}.bin 이 유효하면 그대로 사용, 아니면 cfg 를 compile 하여 {cfg}.bin 갱신.
+//------------------------------------------------------------------------------
+int ui_layout_load (struct ui_layout *lo, fb_info_t *pfb, const char *cfg_fname)
+{
+	struct stat st;
+	char bin_fname[256];
+
+	if (stat (cfg_fname, &st)) {
+		printf ("%s : %s open error!\n", __func__, cfg_fname);
+		return 0;
+	}
+	snprintf (bin_fname, sizeof(bin_fname), "%s.bin", cfg_fname);
+
+	if (layout_cache_read (lo, pfb, bin_fname, &st)) {
+		lo->cached    = 1;
+		lo->px_valid  = 0;
+		return 1;
+	}
+	if (!layout_compile (lo, pfb, cfg_fname))
+		return 0;
+	layout_cache_write (lo, bin_fname, &st);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+// 외곽선 안쪽 모서리 pixel (ui_init 직후 'C' 기본 박스색상) 과 rc_px 비교.
+// 32bpp 의 alpha bit 는 framebuffer 에서 읽은 값을 사용.
+//------------------------------------------------------------------------------
+int ui_layout_verify (struct ui_layout *lo, fb_info_t *pfb)
+{
+	const struct ui_layout_item *item;
+	uint32_t px, p32;
+	uint16_t p16;
+	char *p;
+	int i, m, checked = 0;
+
+	lo->px_valid = 0;
+	if (((pfb->bpp != 16) && (pfb->bpp != 32)) || (pfb->bpp != lo->bpp))
+		return 0;
+
+	for (i = 0; i < lo->count; i++) {
+		item = &lo->items[i];
+		m    = (item->lw > 0 ? item->lw : 0) + 1;
+		if ((item->w <= m * 2) || (item->h <= m * 2))
+			continue;
+
+		p = pfb->data + (item->y + m) * pfb->stride + (item->x + m) * (pfb->bpp / 8);
+		if (pfb->bpp == 16) {
+			memcpy (&p16, p, 2);
+			px = p16;
+		} else {
+			memcpy (&p32, p, 4);
+			px = p32;
+			if (!checked) {
+				lo->alpha = px & 0xFF000000;
+				layout_colors (lo);
+			}
+		}
+		if (px != lo->rc_px) {
+			printf ("%s : ID %03d pixel 0x%08x, expected 0x%08x\n", __func__, item->id, px, lo->rc_px);
+			return 0;
+		}
+		checked++;
+	}
+	lo->px_valid = checked ? 1 : 0;
+	return lo->px_valid;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
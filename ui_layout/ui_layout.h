@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------
+/**
+ * @file ui_layout.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief fbui.cfg compiled layout (pixel geometry table + binary cache).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __UI_LAYOUT_H__
+#define __UI_LAYOUT_H__
+
+//------------------------------------------------------------------------------
+#include <stdint.h>
+#include "../lib_fbui/lib_fb.h"
+
+//------------------------------------------------------------------------------
+/* fbui.cfg 'B' command ID 범위 (000 ~ 255), 최대 box 수 */
+#define	UI_LAYOUT_ID_MAX		256
+#define	UI_LAYOUT_ITEM_MAX		128
+
+#define	UI_LAYOUT_MAGIC			0x4C55314D	/* "M1UL" */
+#define	UI_LAYOUT_VERSION		2
+
+//------------------------------------------------------------------------------
+/*
+	fbui.cfg 를 framebuffer 크기로 한번 계산한 box table.
+	{cfg}.bin 에 저장하고 다음 실행시 cfg mtime/size, framebuffer w/h/bpp 가 같으면
+	cfg 를 읽지 않고 그대로 사용 (lib_fbui ui_init 은 별도로 cfg 를 parsing).
+*/
+struct ui_layout_item {
+	int16_t		id;
+	/* pixel rect */
+	int16_t		x, y, w, h;
+	/* 외곽두께, 폰트크기, 문자정렬 */
+	int16_t		lw, scale, align;
+};
+
+struct ui_layout {
+	/* ID -> items[] index, -1 : cfg 에 없는 ID */
+	int16_t		index[UI_LAYOUT_ID_MAX];
+	int16_t		count;
+	int16_t		fb_w, fb_h, bpp;
+	/* fbui.cfg 'C' : LCD RGB배열 (1 = BGR), 한글폰트, 기본 문자/박스/외곽 색상 (RGB) */
+	int16_t		lcd_bgr, font;
+	uint32_t	fc, rc, lc;
+	/* 'C' 기본 색상의 framebuffer native pixel */
+	uint32_t	fc_px, rc_px, lc_px;
+	/* 32bpp native pixel 의 alpha bit (ui_layout_verify 에서 확인) */
+	uint32_t	alpha;
+	/* 1 : ui_layout_pixel 결과가 lib_fbui 가 그린 pixel 과 일치 */
+	char		px_valid;
+	/* 1 : binary cache 에서 읽음 */
+	char		cached;
+	struct ui_layout_item	items[UI_LAYOUT_ITEM_MAX];
+};
+
+//------------------------------------------------------------------------------
+extern int		ui_layout_load		(struct ui_layout *lo, fb_info_t *pfb, const char *cfg_fname);
+/* RGB (0xRRGGBB) -> framebuffer native pixel */
+extern uint32_t	ui_layout_pixel		(const struct ui_layout *lo, uint32_t rgb);
+/* ui_init 이 'C' 기본 박스색상으로 그린 화면과 ui_layout_pixel 결과 비교 */
+extern int		ui_layout_verify	(struct ui_layout *lo, fb_info_t *pfb);
+
+//------------------------------------------------------------------------------
+#endif	// #define __UI_LAYOUT_H__
+//------------------------------------------------------------------------------
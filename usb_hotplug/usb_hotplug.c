@@ -0,0 +1,244 @@
+//------------------------------------------------------------------------------
+/**
+ * @file usb_hotplug.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief netlink uevent usb hotplug (port -> link speed -> block node map).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+
+#include "usb_hotplug.h"
+#include "../sysfs_attr/sysfs_attr.h"
+
+//------------------------------------------------------------------------------
+static struct usb_port_info	UsbPorts[USB_HOTPLUG_PORT_MAX];
+static int					UsbPortCnt = 0;
+static pthread_mutex_t		UsbLock = PTHREAD_MUTEX_INITIALIZER;
+static struct event_notify	*UsbNotify = NULL;
+static int					UeventFd = -1;
+
+static char	SysfsRoot[128] = "/sys";
+
+/* port 별 speed attribute (device 제거 후 read error 시 다음 read 에서 다시 open) */
+static struct sysfs_attr	SpeedAttr[USB_HOTPLUG_PORT_MAX];
+
+//------------------------------------------------------------------------------
+// /sys/block/sdX -> ../devices/platform/.../usb8/8-1/8-1:1.0/host0/.../block/sdX
+// link path 중 "/{port}/" 가 포함된 block node를 찾음. (hub 하위 "8-1.2"는 제외)
+//------------------------------------------------------------------------------
+static int find_block_node (const char *port, char *block, int block_size)
+{
+	DIR *dir;
+	struct dirent *ent;
+	char fname[512], link[512], pattern[32];
+	int found = 0, len;
+
+	snprintf (fname, sizeof(fname), "%s/block", SysfsRoot);
+	if ((dir = opendir (fname)) == NULL)
+		return 0;
+
+	snprintf (pattern, sizeof(pattern), "/%s/", port);
+	while (!found && ((ent = readdir (dir)) != NULL)) {
+		if (ent->d_name[0] == '.')
+			continue;
+
+		snprintf (fname, sizeof(fname), "%s/block/%s", SysfsRoot, ent->d_name);
+		if ((len = readlink (fname, link, sizeof(link) - 1)) <= 0)
+			continue;
+
+		link[len] = 0;
+		if ((strstr (link, pattern) != NULL) && ((int)strlen (ent->d_name) < block_size)) {
+			strcpy (block, ent->d_name);
+			found = 1;
+		}
+	}
+	closedir (dir);
+	return found;
+}
+
+//------------------------------------------------------------------------------
+// 전체 port를 다시 확인하여 topology map 갱신. 변경이 있는 경우 1 return.
+//------------------------------------------------------------------------------
+static int usb_hotplug_update (void)
+{
+	struct usb_port_info info;
+	char fname[256];
+	int i, changed = 0;
+
+	for (i = 0; i < UsbPortCnt; i++) {
+		memset (&info, 0, sizeof(info));
+		memcpy (info.port, UsbPorts[i].port, sizeof(info.port));
+
+		snprintf (fname, sizeof(fname), "%s/bus/usb/devices/%s", SysfsRoot, info.port);
+		if (access (fname, F_OK) == 0) {
+			info.present = 1;
+			if (!SpeedAttr[i].path[0]) {
+				snprintf (fname, sizeof(fname), "%s/bus/usb/devices/%s/speed",
+					SysfsRoot, info.port);
+				sysfs_attr_open (&SpeedAttr[i], fname);
+			}
+			sysfs_attr_read_int (&SpeedAttr[i], &info.speed);
+			find_block_node (info.port, info.block, sizeof(info.block));
+		} else if (SpeedAttr[i].path[0]) {
+			/* unplug : 제거된 device 의 attribute fd 해제 (재연결시 다시 open) */
+			sysfs_attr_close (&SpeedAttr[i]);
+			sysfs_attr_clear (&SpeedAttr[i]);
+		}
+
+		pthread_mutex_lock (&UsbLock);
+		if (memcmp (&UsbPorts[i], &info, sizeof(info))) {
+			memcpy (&UsbPorts[i], &info, sizeof(info));
+			changed = 1;
+		}
+		pthread_mutex_unlock (&UsbLock);
+	}
+	if (changed && (UsbNotify != NULL))
+		event_notify_post (UsbNotify);
+
+	return changed;
+}
+
+//------------------------------------------------------------------------------
+int usb_hotplug_init (const char *sysfs_root, const char (*ports)[4], int port_cnt,
+						struct event_notify *notify)
+{
+	struct sockaddr_nl addr;
+	int i;
+
+	if (sysfs_root != NULL)
+		snprintf (SysfsRoot, sizeof(SysfsRoot), "%s", sysfs_root);
+
+	UsbNotify  = notify;
+	UsbPortCnt = (port_cnt > USB_HOTPLUG_PORT_MAX) ? USB_HOTPLUG_PORT_MAX : port_cnt;
+
+	memset (UsbPorts, 0, sizeof(UsbPorts));
+	for (i = 0; i < UsbPortCnt; i++) {
+		snprintf (UsbPorts[i].port, sizeof(UsbPorts[i].port), "%s", ports[i]);
+		sysfs_attr_clear (&SpeedAttr[i]);
+	}
+
+	/* uevent socket 생성 실패시에도 usb_hotplug_uevent()로 주입된 event는 처리 가능 */
+	UeventFd = socket (AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+	if (UeventFd < 0) {
+		printf ("%s : uevent socket error! (%s)\n", __func__, strerror(errno));
+		return 0;
+	}
+	memset (&addr, 0, sizeof(addr));
+	addr.nl_family = AF_NETLINK;
+	addr.nl_pid    = 0;
+	addr.nl_groups = 1;
+	if (bind (UeventFd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printf ("%s : uevent bind error! (%s)\n", __func__, strerror(errno));
+		close (UeventFd);
+		UeventFd = -1;
+		return 0;
+	}
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+/* coldplug : 이미 연결되어있는 device 확인 */
+void usb_hotplug_scan (void)
+{
+	usb_hotplug_update ();
+}
+
+//------------------------------------------------------------------------------
+// uevent msg : "add@/devices/...\0ACTION=add\0DEVPATH=...\0SUBSYSTEM=block\0..."
+// usb device 또는 block device 관련 event인 경우에만 topology 갱신.
+//------------------------------------------------------------------------------
+int usb_hotplug_uevent (const char *msg, int len)
+{
+	const char *ptr = msg, *end = msg + len;
+	int interest = 0;
+
+	while (ptr < end) {
+		if (!strcmp (ptr, "SUBSYSTEM=block") || !strcmp (ptr, "SUBSYSTEM=usb"))
+			interest = 1;
+		ptr += strlen (ptr) + 1;
+	}
+	return interest ? usb_hotplug_update () : 0;
+}
+
+//------------------------------------------------------------------------------
+int usb_hotplug_get (int port_idx, struct usb_port_info *info)
+{
+	if ((port_idx < 0) || (port_idx >= UsbPortCnt))
+		return 0;
+
+	pthread_mutex_lock (&UsbLock);
+	memcpy (info, &UsbPorts[port_idx], sizeof(struct usb_port_info));
+	pthread_mutex_unlock (&UsbLock);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+int usb_hotplug_present_cnt (void)
+{
+	int i, cnt;
+
+	pthread_mutex_lock (&UsbLock);
+	for (i = 0, cnt = 0; i < UsbPortCnt; i++)
+		cnt += UsbPorts[i].present ? 1 : 0;
+	pthread_mutex_unlock (&UsbLock);
+	return cnt;
+}
+
+//------------------------------------------------------------------------------
+#define	UEVENT_BUF_SIZE			4096
+#define	UEVENT_STOP_CHECK_MS	1000
+
+void *usb_hotplug_thread (void *stop_flag)
+{
+	volatile char *stop = (volatile char *)stop_flag;
+	struct pollfd pfd;
+	char buf[UEVENT_BUF_SIZE];
+	int len;
+
+	if (UeventFd < 0)
+		return stop_flag;
+
+	pfd.fd     = UeventFd;
+	pfd.events = POLLIN;
+
+	while (!*stop) {
+		if (poll (&pfd, 1, UEVENT_STOP_CHECK_MS) <= 0)
+			continue;
+
+		while ((len = recv (UeventFd, buf, sizeof(buf) - 1, MSG_DONTWAIT)) > 0) {
+			buf[len] = 0;
+			usb_hotplug_uevent (buf, len);
+		}
+	}
+	return stop_flag;
+}
+
+//------------------------------------------------------------------------------
+void usb_hotplug_close (void)
+{
+	int i;
+
+	for (i = 0; i < UsbPortCnt; i++)
+		sysfs_attr_close (&SpeedAttr[i]);
+	if (UeventFd >= 0)
+		close (UeventFd);
+	UeventFd = -1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,47 @@
+//------------------------------------------------------------------------------
+/**
+ * @file usb_hotplug.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief netlink uevent usb hotplug (port -> link speed -> block node map).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+//------------------------------------------------------------------------------
+#ifndef __USB_HOTPLUG_H__
+#define __USB_HOTPLUG_H__
+
+//------------------------------------------------------------------------------
+#include "../event_notify/event_notify.h"
+
+//------------------------------------------------------------------------------
+#define	USB_HOTPLUG_PORT_MAX	16
+#define	USB_HOTPLUG_NAME_SIZE	16
+
+struct usb_port_info {
+	/* usb bus port name (ex "8-1") */
+	char	port[USB_HOTPLUG_NAME_SIZE];
+	/* 0 : not connected, 1 : usb device connected */
+	char	present;
+	/* link speed Mbps (1.5, 12, 480, 5000 ...) */
+	int		speed;
+	/* block node name (ex "sda"), "" : mass storage not ready */
+	char	block[USB_HOTPLUG_NAME_SIZE];
+};
+
+//------------------------------------------------------------------------------
+/* sysfs_root NULL : "/sys", notify : topology 변경 시 event_notify_post */
+extern int	usb_hotplug_init	(const char *sysfs_root, const char (*ports)[4], int port_cnt,
+								struct event_notify *notify);
+extern void	usb_hotplug_scan	(void);
+extern int	usb_hotplug_uevent	(const char *msg, int len);
+extern int	usb_hotplug_get		(int port_idx, struct usb_port_info *info);
+extern int	usb_hotplug_present_cnt	(void);
+extern void	*usb_hotplug_thread	(void *stop_flag);
+extern void	usb_hotplug_close	(void);
+
+//------------------------------------------------------------------------------
+#endif	// #define __USB_HOTPLUG_H__
+//------------------------------------------------------------------------------